@@ -46,7 +46,7 @@ function(target_add_resources TARGET)
         # Some programs need directory of output to exist
         make_directory("${RESOURCE_BINARY_DIR}/${RESOURCE_DIRECTORY}")
         # Use glslc to compile shaders
-        if (RESOURCE_EXTENSION STREQUAL ".vert" OR RESOURCE_EXTENSION STREQUAL ".frag")
+        if (RESOURCE_EXTENSION STREQUAL ".vert" OR RESOURCE_EXTENSION STREQUAL ".frag" OR RESOURCE_EXTENSION STREQUAL ".comp")
             set(RESOURCE "${RESOURCE_DIRECTORY}${RESOURCE_NAME}.spv")
             set(OUTPUT_RESOURCE "${RESOURCE_BINARY_DIR}/${RESOURCE}")
             set(SHADER_COMPILER "${RESOURCE_SOURCE_DIR}/../extern/shader_compiler/compile.sh")
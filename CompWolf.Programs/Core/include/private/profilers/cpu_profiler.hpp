@@ -0,0 +1,143 @@
+#ifndef COMPWOLF_CPU_PROFILER
+#define COMPWOLF_CPU_PROFILER
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace compwolf
+{
+	/** Aggregate type containing a zone recorded by [[cpu_profiler]].
+	 * @see cpu_profiler
+	 */
+	struct profile_zone_record
+	{
+		/** The name given when the zone was recorded. */
+		const char* name;
+		/** When the zone started, relative to when the program started profiling. */
+		std::chrono::nanoseconds start;
+		/** How long the zone lasted. */
+		std::chrono::nanoseconds duration;
+	};
+
+	/** Aggregate type containing the zones recorded by [[cpu_profiler]] on a single thread.
+	 * @see cpu_profiler
+	 */
+	struct profile_thread_record
+	{
+		/** A number identifying the thread, unique among the profiled threads. */
+		std::size_t thread_id;
+		/** The name given to the thread with [[cpu_profiler::set_thread_name]]; empty if it was not given one. */
+		std::string thread_name;
+		/** The thread's zones, in the order that they ended. */
+		std::vector<profile_zone_record> zones;
+		/** The amount of zones that were not recorded, because the thread's buffer was full. */
+		std::size_t dropped_zones;
+	};
+
+	/** Records how long the cpu spends on named zones of code, so that it can be seen where each millisecond goes.
+	 * Zones are recorded with [[profile_zone]], usually through COMPWOLF_PROFILE_ZONE.
+	 * Each thread records into its own buffer, without locking, so profiling does not make threads wait on each other.
+	 * A thread's buffer is freed when the thread ends; its zones are kept until clear() is called.
+	 *
+	 * The profiler is disabled until enable() is called; while disabled, a zone costs a single check.
+	 * If COMPWOLF_DISABLE_PROFILING is defined, COMPWOLF_PROFILE_ZONE does nothing at all.
+	 */
+	class cpu_profiler
+	{
+		static std::atomic<bool> _enabled;
+
+	public: // accessors
+		/** Returns whether zones are currently being recorded. */
+		static auto enabled() noexcept -> bool { return _enabled.load(std::memory_order_relaxed); }
+
+		/** Returns the zones recorded by each thread.
+		 * This may be called while other threads are recording zones; zones that have not ended yet are not included.
+		 */
+		static auto records() -> std::vector<profile_thread_record>;
+
+		/** Writes the recorded zones to the given stream, in the Chrome trace event format.
+		 * The output can be viewed with chrome://tracing or https://ui.perfetto.dev.
+		 */
+		static void write_chrome_trace(std::ostream&);
+		/** Writes the recorded zones to the given file, in the Chrome trace event format.
+		 * @throws std::runtime_error if the file could not be written.
+		 * @see write_chrome_trace
+		 */
+		static void save_chrome_trace(const std::filesystem::path&);
+
+	public: // modifiers
+		/** Starts recording zones. */
+		static void enable() noexcept { _enabled.store(true, std::memory_order_relaxed); }
+		/** Stops recording zones. Zones that are already recorded are kept. */
+		static void disable() noexcept { _enabled.store(false, std::memory_order_relaxed); }
+
+		/** Removes all recorded zones, including those of threads that have ended.
+		 * This must not be called while other threads are recording zones.
+		 */
+		static void clear() noexcept;
+
+		/** Gives the calling thread a name, shown when exporting the recorded zones. */
+		static void set_thread_name(std::string_view);
+
+		/** Records a zone on the calling thread, if the profiler is enabled.
+		 * @param name The name of the zone. The characters must stay alive until the zones are exported, like a string literal.
+		 * @param start When the zone started.
+		 * @param end When the zone ended.
+		 */
+		static void record(const char* name
+			, std::chrono::steady_clock::time_point start
+			, std::chrono::steady_clock::time_point end
+		) noexcept;
+
+	public: // constructors
+		cpu_profiler() = delete;
+	};
+
+	/** Records the time from the zone's construction to its destruction with [[cpu_profiler]].
+	 * If the profiler was not enabled when the zone was constructed, the zone is not recorded.
+	 * @see COMPWOLF_PROFILE_ZONE
+	 */
+	class profile_zone
+	{
+		const char* _name;
+		std::chrono::steady_clock::time_point _start;
+
+	public: // constructors
+		profile_zone(const profile_zone&) = delete;
+		auto operator=(const profile_zone&) -> profile_zone& = delete;
+
+		/** Starts the zone.
+		 * @param name The name of the zone. The characters must stay alive until the zones are exported, like a string literal.
+		 */
+		explicit profile_zone(const char* name) noexcept
+			: _name(cpu_profiler::enabled() ? name : nullptr)
+		{
+			if (_name) _start = std::chrono::steady_clock::now();
+		}
+		~profile_zone() noexcept
+		{
+			if (_name) cpu_profiler::record(_name, _start, std::chrono::steady_clock::now());
+		}
+	};
+}
+
+#define COMPWOLF_PROFILE_ZONE_CONCAT_INNER(a, b) a##b
+#define COMPWOLF_PROFILE_ZONE_CONCAT(a, b) COMPWOLF_PROFILE_ZONE_CONCAT_INNER(a, b)
+
+/** Records the rest of the enclosing scope as a zone with the given name, using [[profile_zone]].
+ * The name must stay alive until the zones are exported, like a string literal.
+ * Does nothing if COMPWOLF_DISABLE_PROFILING is defined.
+ */
+#ifdef COMPWOLF_DISABLE_PROFILING
+#define COMPWOLF_PROFILE_ZONE(name)
+#else
+#define COMPWOLF_PROFILE_ZONE(name) ::compwolf::profile_zone COMPWOLF_PROFILE_ZONE_CONCAT(compwolf_profile_zone_, __LINE__)(name)
+#endif
+
+#endif // ! COMPWOLF_CPU_PROFILER
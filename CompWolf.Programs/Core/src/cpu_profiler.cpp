@@ -0,0 +1,310 @@
+#include "profilers"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace compwolf
+{
+	namespace
+	{
+		/** The amount of zones in each chunk of a thread's buffer. */
+		constexpr std::size_t zones_per_chunk = 4096;
+		/** The maximum amount of chunks in a thread's buffer; zones recorded after these are full are dropped. */
+		constexpr std::size_t max_chunks = 256;
+
+		struct zone_chunk
+		{
+			std::array<profile_zone_record, zones_per_chunk> zones;
+		};
+
+		/** The zones recorded by a single thread.
+		 * Only the thread itself writes zones, so it does not need to lock; other threads only read the zones before size.
+		 */
+		struct thread_buffer
+		{
+			std::size_t thread_id;
+			std::array<std::atomic<zone_chunk*>, max_chunks> chunks{};
+			std::vector<std::unique_ptr<zone_chunk>> owned_chunks;
+			std::atomic<std::size_t> size{};
+			std::atomic<std::size_t> dropped{};
+
+			std::mutex name_mutex;
+			std::string name;
+		};
+
+		/** The time that recorded zones are relative to. */
+		const auto profiling_start = std::chrono::steady_clock::now();
+
+		/** Every running thread's buffer, and the zones of the threads that have ended.
+		 * A thread's buffer is freed when the thread ends, but its zones are kept, so that they can still be exported.
+		 */
+		struct thread_buffer_registry
+		{
+			std::mutex mutex;
+			std::vector<std::unique_ptr<thread_buffer>> buffers;
+			std::vector<profile_thread_record> ended_threads;
+			std::size_t next_thread_id{};
+		};
+		auto registry() -> thread_buffer_registry&
+		{
+			static thread_buffer_registry value;
+			return value;
+		}
+
+		/** Returns the zones recorded in the given buffer, up to when this is called. */
+		auto buffer_record(thread_buffer& buffer) -> profile_thread_record
+		{
+			profile_thread_record record;
+			record.thread_id = buffer.thread_id;
+			{
+				std::lock_guard name_lock(buffer.name_mutex);
+				record.thread_name = buffer.name;
+			}
+			record.dropped_zones = buffer.dropped.load(std::memory_order_relaxed);
+
+			auto size = buffer.size.load(std::memory_order_acquire);
+			record.zones.reserve(size);
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				auto chunk = buffer.chunks[i / zones_per_chunk].load(std::memory_order_acquire);
+				record.zones.push_back(chunk->zones[i % zones_per_chunk]);
+			}
+			return record;
+		}
+
+		/** Whether the calling thread has ended, and so no longer has a buffer. */
+		thread_local bool thread_buffer_removed = false;
+
+		/** Frees the calling thread's buffer when the thread ends, keeping its zones in the registry. */
+		struct thread_buffer_owner
+		{
+			thread_buffer* buffer = nullptr;
+
+			~thread_buffer_owner() noexcept
+			{
+				thread_buffer_removed = true;
+				if (!buffer) return;
+
+				auto& threads = registry();
+				std::lock_guard lock(threads.mutex);
+				try
+				{
+					if (buffer->size.load(std::memory_order_relaxed) != 0 || buffer->dropped.load(std::memory_order_relaxed) != 0)
+						threads.ended_threads.push_back(buffer_record(*buffer));
+				}
+				catch (...)
+				{
+					// The thread is ending, so there is nowhere to report the error; its zones are lost.
+				}
+				std::erase_if(threads.buffers, [this](const std::unique_ptr<thread_buffer>& b) { return b.get() == buffer; });
+			}
+		};
+
+		/** Returns the calling thread's buffer, creating it the first time it is used; or nullptr if the thread is ending. */
+		auto this_thread_buffer() -> thread_buffer*
+		{
+			if (thread_buffer_removed) [[unlikely]] return nullptr;
+
+			thread_local thread_buffer_owner owner;
+			if (!owner.buffer) [[unlikely]]
+			{
+				auto& threads = registry();
+				std::lock_guard lock(threads.mutex);
+				auto& new_buffer = threads.buffers.emplace_back(std::make_unique<thread_buffer>());
+				new_buffer->thread_id = threads.next_thread_id++;
+				owner.buffer = new_buffer.get();
+			}
+			return owner.buffer;
+		}
+
+		/** Writes the given string to the given stream as a JSON string. */
+		void write_json_string(std::ostream& stream, std::string_view string)
+		{
+			constexpr char hex_digits[] = "0123456789abcdef";
+
+			stream << '"';
+			for (auto c : string)
+			{
+				switch (c)
+				{
+				case '"': stream << "\\\""; break;
+				case '\\': stream << "\\\\"; break;
+				case '\n': stream << "\\n"; break;
+				case '\r': stream << "\\r"; break;
+				case '\t': stream << "\\t"; break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20)
+					{
+						stream << "\\u00" << hex_digits[(c >> 4) & 0xF] << hex_digits[c & 0xF];
+					}
+					else stream << c;
+					break;
+				}
+			}
+			stream << '"';
+		}
+
+		/** Returns the given duration in microseconds, which is the unit of the Chrome trace event format. */
+		auto to_microseconds(std::chrono::nanoseconds duration) noexcept -> double
+		{
+			return std::chrono::duration<double, std::micro>(duration).count();
+		}
+	}
+
+	std::atomic<bool> cpu_profiler::_enabled{ false };
+
+	/******************************** accessors ********************************/
+
+	auto cpu_profiler::records() -> std::vector<profile_thread_record>
+	{
+		auto& threads = registry();
+		std::lock_guard lock(threads.mutex);
+
+		std::vector<profile_thread_record> records = threads.ended_threads;
+		records.reserve(records.size() + threads.buffers.size());
+		for (auto& buffer : threads.buffers)
+		{
+			records.push_back(buffer_record(*buffer));
+		}
+
+		// Threads are given in the order they started profiling, whether or not they have ended.
+		std::sort(records.begin(), records.end()
+			, [](const profile_thread_record& a, const profile_thread_record& b) { return a.thread_id < b.thread_id; }
+		);
+		return records;
+	}
+
+	void cpu_profiler::write_chrome_trace(std::ostream& stream)
+	{
+		auto threads = records();
+
+		// Times are written with nanosecond precision, and never in scientific notation.
+		auto old_flags = stream.flags();
+		auto old_precision = stream.precision();
+		stream << std::fixed << std::setprecision(3);
+
+		stream << "{\"traceEvents\":[";
+		bool first = true;
+		auto next_event = [&stream, &first]()
+		{
+			if (!first) stream << ",";
+			first = false;
+			stream << "\n";
+		};
+
+		for (auto& thread : threads)
+		{
+			if (!thread.thread_name.empty())
+			{
+				next_event();
+				stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.thread_id << ",\"args\":{\"name\":";
+				write_json_string(stream, thread.thread_name);
+				stream << "}}";
+			}
+
+			for (auto& zone : thread.zones)
+			{
+				next_event();
+				stream << "{\"name\":";
+				write_json_string(stream, zone.name);
+				stream << ",\"cat\":\"compwolf\",\"ph\":\"X\""
+					<< ",\"ts\":" << to_microseconds(zone.start)
+					<< ",\"dur\":" << to_microseconds(zone.duration)
+					<< ",\"pid\":1,\"tid\":" << thread.thread_id << "}";
+			}
+		}
+
+		stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+		stream.flags(old_flags);
+		stream.precision(old_precision);
+	}
+
+	void cpu_profiler::save_chrome_trace(const std::filesystem::path& path)
+	{
+		std::ofstream stream(path, std::ios::out | std::ios::trunc);
+		if (!stream.is_open()) throw std::runtime_error("Could not open \"" + path.string() + "\" to save a cpu profile to.");
+
+		write_chrome_trace(stream);
+		if (!stream) throw std::runtime_error("Could not save a cpu profile to \"" + path.string() + "\".");
+	}
+
+	/******************************** modifiers ********************************/
+
+	void cpu_profiler::clear() noexcept
+	{
+		auto& threads = registry();
+		std::lock_guard lock(threads.mutex);
+
+		threads.ended_threads.clear();
+		for (auto& buffer : threads.buffers)
+		{
+			buffer->size.store(0, std::memory_order_release);
+			buffer->dropped.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	void cpu_profiler::set_thread_name(std::string_view name)
+	{
+		auto buffer = this_thread_buffer();
+		if (!buffer) return;
+
+		std::lock_guard lock(buffer->name_mutex);
+		buffer->name = name;
+	}
+
+	void cpu_profiler::record(const char* name
+		, std::chrono::steady_clock::time_point start
+		, std::chrono::steady_clock::time_point end
+	) noexcept
+	{
+		if (!enabled()) return;
+
+		thread_buffer* buffer;
+		try
+		{
+			buffer = this_thread_buffer();
+		}
+		catch (...)
+		{
+			return;
+		}
+		if (!buffer) return;
+
+		auto index = buffer->size.load(std::memory_order_relaxed);
+		auto chunk_index = index / zones_per_chunk;
+		if (chunk_index >= max_chunks)
+		{
+			buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		auto chunk = buffer->chunks[chunk_index].load(std::memory_order_relaxed);
+		if (!chunk) [[unlikely]]
+		{
+			try
+			{
+				chunk = buffer->owned_chunks.emplace_back(std::make_unique<zone_chunk>()).get();
+			}
+			catch (...)
+			{
+				buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			buffer->chunks[chunk_index].store(chunk, std::memory_order_release);
+		}
+
+		chunk->zones[index % zones_per_chunk] = profile_zone_record{
+			.name = name,
+			.start = std::chrono::duration_cast<std::chrono::nanoseconds>(start - profiling_start),
+			.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start),
+		};
+		// Releasing the size makes the zone visible to other threads reading it.
+		buffer->size.store(index + 1, std::memory_order_release);
+	}
+}
@@ -0,0 +1,139 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <profilers>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	/** Returns the recorded zones with the given name, on any thread. */
+	auto zones_named(std::string_view name) -> std::vector<compwolf::profile_zone_record>
+	{
+		std::vector<compwolf::profile_zone_record> zones;
+		for (auto& thread : compwolf::cpu_profiler::records())
+		{
+			for (auto& zone : thread.zones)
+			{
+				if (zone.name == name) zones.push_back(zone);
+			}
+		}
+		return zones;
+	}
+}
+
+TEST(CpuProfiler, disabled_records_nothing) {
+	compwolf::cpu_profiler::disable();
+	compwolf::cpu_profiler::clear();
+	{
+		COMPWOLF_PROFILE_ZONE("disabled zone");
+	}
+
+	EXPECT_TRUE(zones_named("disabled zone").empty());
+}
+TEST(CpuProfiler, records_nested_zones) {
+	compwolf::cpu_profiler::clear();
+	compwolf::cpu_profiler::enable();
+	{
+		COMPWOLF_PROFILE_ZONE("outer zone");
+		{
+			COMPWOLF_PROFILE_ZONE("inner zone");
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+	compwolf::cpu_profiler::disable();
+
+	auto outer = zones_named("outer zone");
+	auto inner = zones_named("inner zone");
+	ASSERT_EQ(outer.size(), std::size_t(1));
+	ASSERT_EQ(inner.size(), std::size_t(1));
+	EXPECT_GE(inner[0].duration, std::chrono::milliseconds(1));
+	EXPECT_LE(outer[0].start, inner[0].start);
+	EXPECT_GE(outer[0].start + outer[0].duration, inner[0].start + inner[0].duration);
+}
+TEST(CpuProfiler, clear) {
+	compwolf::cpu_profiler::clear();
+	compwolf::cpu_profiler::enable();
+	{
+		COMPWOLF_PROFILE_ZONE("cleared zone");
+	}
+	compwolf::cpu_profiler::disable();
+	compwolf::cpu_profiler::clear();
+
+	EXPECT_TRUE(zones_named("cleared zone").empty());
+}
+TEST(CpuProfiler, records_each_thread_separately) {
+	constexpr std::size_t thread_count = 4;
+	constexpr std::size_t zones_per_thread = 10000;
+
+	compwolf::cpu_profiler::clear();
+	compwolf::cpu_profiler::enable();
+	{
+		std::vector<std::thread> threads;
+		for (std::size_t i = 0; i < thread_count; ++i)
+		{
+			threads.emplace_back([]()
+				{
+					compwolf::cpu_profiler::set_thread_name("worker");
+					for (std::size_t j = 0; j < zones_per_thread; ++j)
+					{
+						COMPWOLF_PROFILE_ZONE("thread zone");
+					}
+				}
+			);
+		}
+		for (auto& thread : threads) thread.join();
+	}
+	compwolf::cpu_profiler::disable();
+
+	std::size_t worker_count = 0;
+	for (auto& thread : compwolf::cpu_profiler::records())
+	{
+		if (thread.thread_name != "worker") continue;
+		++worker_count;
+		EXPECT_EQ(thread.zones.size(), zones_per_thread);
+		EXPECT_EQ(thread.dropped_zones, std::size_t(0));
+	}
+	EXPECT_GE(worker_count, thread_count);
+	EXPECT_EQ(zones_named("thread zone").size(), thread_count * zones_per_thread);
+}
+TEST(CpuProfiler, clear_removes_ended_threads) {
+	compwolf::cpu_profiler::clear();
+	compwolf::cpu_profiler::enable();
+	std::thread([]()
+		{
+			compwolf::cpu_profiler::set_thread_name("ended worker");
+			COMPWOLF_PROFILE_ZONE("ended thread zone");
+		}
+	).join();
+	compwolf::cpu_profiler::disable();
+
+	// The thread's zones are kept after it ends, until they are cleared.
+	EXPECT_EQ(zones_named("ended thread zone").size(), std::size_t(1));
+	compwolf::cpu_profiler::clear();
+	for (auto& thread : compwolf::cpu_profiler::records())
+	{
+		EXPECT_NE(thread.thread_name, "ended worker");
+	}
+}
+TEST(CpuProfiler, chrome_trace) {
+	compwolf::cpu_profiler::clear();
+	compwolf::cpu_profiler::set_thread_name("main \"thread\"");
+	compwolf::cpu_profiler::enable();
+	{
+		COMPWOLF_PROFILE_ZONE("traced zone");
+	}
+	compwolf::cpu_profiler::disable();
+
+	std::ostringstream stream;
+	compwolf::cpu_profiler::write_chrome_trace(stream);
+	auto trace = stream.str();
+
+	EXPECT_EQ(trace.find("{\"traceEvents\":["), std::size_t(0));
+	EXPECT_NE(trace.find("{\"name\":\"traced zone\",\"cat\":\"compwolf\",\"ph\":\"X\",\"ts\":"), std::string::npos);
+	EXPECT_NE(trace.find("\"args\":{\"name\":\"main \\\"thread\\\"\"}"), std::string::npos);
+	EXPECT_EQ(trace.find("e+"), std::string::npos);
+}
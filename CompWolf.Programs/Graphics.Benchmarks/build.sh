@@ -0,0 +1,3 @@
+#!/bin/sh
+
+cmake --preset debug_gcc && cd build/debug_gcc && make
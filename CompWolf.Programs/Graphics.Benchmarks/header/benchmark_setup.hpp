@@ -0,0 +1,120 @@
+#ifndef COMPWOLF_GRAPHICS_BENCHMARK_SETUP
+#define COMPWOLF_GRAPHICS_BENCHMARK_SETUP
+
+#include <vulkan_graphics>
+#include <simple_drawables>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace compwolf::benchmarks
+{
+	/** Returns whether the benchmarks should draw onto actual windows instead of [[offscreen_target]]s.
+	 * This is set by the environment variable COMPWOLF_BENCHMARK_WINDOWED, and requires a display, like Xvfb on a machine without a screen.
+	 */
+	inline auto windowed() noexcept -> bool
+	{
+		auto value = std::getenv("COMPWOLF_BENCHMARK_WINDOWED");
+		return value && *value && *value != '0';
+	}
+
+	/** Returns the settings that the benchmarks' environments are created with.
+	 * The environment is headless unless [[windowed]] returns true.
+	 */
+	inline auto environment_settings() -> vulkan::vulkan_graphics_environment_settings
+	{
+		vulkan::vulkan_graphics_environment_settings settings{};
+		settings.program_name = "CompWolf.Graphics.Benchmarks";
+		settings.headless = !windowed();
+		return settings;
+	}
+
+	/** Something for the benchmarks to draw onto; a window if [[windowed]] returns true, otherwise an [[offscreen_target]].
+	 * The target does not limit its frame rate.
+	 */
+	class draw_target
+	{
+		std::optional<vulkan::vulkan_window> _window;
+		std::optional<vulkan::offscreen_target> _offscreen;
+
+	public: // accessors
+		/** Returns the window or offscreen target. */
+		auto get() noexcept -> vulkan::vulkan_window& { return _window ? *_window : *_offscreen; }
+
+	public: // modifiers
+		/** Waits until the gpu has finished drawing every frame given to it, so that gpu-work is not left for the next benchmark. */
+		void finish()
+		{
+			for (auto& frame : get().swapchain().frames_in_flight()) frame.draw_manager().wait();
+		}
+
+	public: // constructors
+		draw_target(const draw_target&) = delete;
+		auto operator=(const draw_target&) -> draw_target& = delete;
+
+		/** Creates a window or offscreen target of the given size, in pixels.
+		 * @param frames_in_flight How many frames the cpu may prepare while the gpu is still drawing earlier ones; if 0, the default is used.
+		 */
+		explicit draw_target(vulkan::vulkan_graphics_environment& environment, int2 pixel_size = { 256, 256 }, std::size_t frames_in_flight = 0)
+		{
+			if (windowed())
+			{
+				_window.emplace(environment, window_settings{
+					.name = "CompWolf.Graphics.Benchmarks",
+					.pixel_size = pixel_size,
+					.frames_in_flight = frames_in_flight,
+					.present = present_policy::immediate,
+				});
+			}
+			else
+			{
+				_offscreen.emplace(environment, vulkan::offscreen_target_settings{
+					.pixel_size = pixel_size,
+					.frames_in_flight = frames_in_flight,
+				});
+			}
+		}
+	};
+
+	/** Everything needed to draw [[simple_square]]s onto a [[draw_target]]. */
+	struct square_scene
+	{
+		draw_target target;
+		vulkan::vulkan_camera camera;
+		simple_brush<vulkan_types> brush;
+		std::vector<std::unique_ptr<simple_square<vulkan_types>>> squares;
+
+		/** Creates a scene with the given amount of squares, spread over the camera, and waits until they can be drawn.
+		 * @param frames_in_flight How many frames the cpu may prepare while the gpu is still drawing earlier ones; if 0, the default is used.
+		 */
+		square_scene(vulkan::vulkan_graphics_environment& environment, std::size_t square_count, std::size_t frames_in_flight = 0)
+			: target(environment, { 256, 256 }, frames_in_flight)
+			, camera(target.get(), window_camera_settings{ .background_color = { .25f, .25f, .5f } })
+			, brush(camera)
+		{
+			brush.wait_for_pipeline(target.get());
+
+			// squares are laid out in a grid, so that they are all inside the camera
+			std::size_t columns = 1;
+			while (columns * columns < square_count) ++columns;
+			auto scale = 1.f / static_cast<float>(columns);
+
+			squares.reserve(square_count);
+			for (std::size_t i = 0; i < square_count; ++i)
+			{
+				auto x = static_cast<float>(i % columns) * 2.f * scale - 1.f + scale;
+				auto y = static_cast<float>(i / columns) * 2.f * scale - 1.f + scale;
+				squares.push_back(std::make_unique<simple_square<vulkan_types>>(camera, brush
+					, simple_transform_data{
+						.position = { x, y },
+						.scale = { scale * .5f, scale * .5f },
+					}
+					, float3{ .75f, .125f, .5f }
+				));
+			}
+		}
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_BENCHMARK_SETUP
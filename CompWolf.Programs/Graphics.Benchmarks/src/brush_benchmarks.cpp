@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_setup.hpp"
+#include <memory>
+#include <vector>
+
+namespace compwolf::benchmarks
+{
+	namespace
+	{
+		/** Creating a brush and waiting for its pipeline.
+		 * The gpu's pipeline cache is kept between iterations, so only the first iteration compiles the pipeline from scratch.
+		 */
+		void brush_creation(benchmark::State& state)
+		{
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			draw_target target(environment);
+			vulkan::vulkan_camera camera(target.get(), window_camera_settings{});
+
+			for (auto _ : state)
+			{
+				simple_brush<vulkan_types> brush(camera);
+				brush.wait_for_pipeline(target.get());
+			}
+
+			auto& cache = target.get().gpu().pipeline_cache().stats();
+			state.counters["pipelines_created"] = static_cast<double>(cache.pipelines_created);
+		}
+		BENCHMARK(brush_creation)->Unit(benchmark::kMicrosecond);
+
+		/** Creating a brush for the given amount of targets, and waiting for its pipelines.
+		 * Targets with the same format share a render pass, and so the brush's pipeline; the time and the amount of pipelines should not grow with the amount of targets.
+		 */
+		void brush_creation_for_targets(benchmark::State& state)
+		{
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			std::vector<std::unique_ptr<draw_target>> targets;
+			for (int64_t i = 0; i < state.range(0); ++i)
+			{
+				targets.push_back(std::make_unique<draw_target>(environment));
+			}
+			auto& gpu = targets.front()->get().gpu();
+			auto created_before = gpu.pipeline_cache().stats().pipelines_created;
+
+			for (auto _ : state)
+			{
+				simple_brush<vulkan_types> brush(gpu);
+				for (auto& target : targets) brush.prepare(target->get());
+				for (auto& target : targets) brush.wait_for_pipeline(target->get());
+			}
+
+			// Each pipeline is a gpu-allocation of compiled shaders, so this is also how the brushes' memory use grows.
+			auto created = gpu.pipeline_cache().stats().pipelines_created - created_before;
+			state.counters["pipelines_per_brush"] = static_cast<double>(created) / static_cast<double>(state.iterations());
+		}
+		BENCHMARK(brush_creation_for_targets)->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMicrosecond);
+	}
+}
@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_setup.hpp"
+#include <algorithm>
+
+namespace compwolf::benchmarks
+{
+	namespace
+	{
+		/** Writing to every element of a buffer kept in gpu-memory; the argument is the amount of elements. */
+		void field_buffer_write(benchmark::State& state)
+		{
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			draw_target target(environment);
+
+			auto size = static_cast<std::size_t>(state.range(0));
+			vulkan::vulkan_gpu_buffer<gpu_buffer_usage::field, simple_transform_data> buffer(target.get().gpu(), size);
+
+			float position = 0.f;
+			for (auto _ : state)
+			{
+				auto data = buffer.data();
+				std::fill(data.begin(), data.end(), simple_transform_data{
+					.position = { position, position },
+					.scale = { 1.f, 1.f },
+				});
+				position += 1.f;
+				benchmark::ClobberMemory();
+			}
+
+			state.SetItemsProcessed(state.iterations() * state.range(0));
+			state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(simple_transform_data));
+		}
+		BENCHMARK(field_buffer_write)->RangeMultiplier(32)->Range(1, 1 << 20);
+
+		/** Writing to the transform of a square, which is pushed directly into the gpu-instructions. */
+		void push_field_buffer_write(benchmark::State& state)
+		{
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			square_scene scene(environment, 1);
+			auto& square = *scene.squares.front();
+
+			float position = 0.f;
+			for (auto _ : state)
+			{
+				square.transform().data()[0].position.x() = position;
+				position += 1.f / 1024.f;
+				benchmark::ClobberMemory();
+			}
+			state.SetItemsProcessed(state.iterations());
+		}
+		BENCHMARK(push_field_buffer_write);
+	}
+}
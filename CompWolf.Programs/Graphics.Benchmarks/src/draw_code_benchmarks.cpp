@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_setup.hpp"
+
+namespace compwolf::benchmarks
+{
+	namespace
+	{
+		/** Adding and removing drawing code from a camera with the given amount of squares. */
+		void add_draw_code_churn(benchmark::State& state)
+		{
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			square_scene scene(environment, static_cast<std::size_t>(state.range(0)));
+
+			for (auto _ : state)
+			{
+				auto key = scene.camera.add_draw_code([](const vulkan::vulkan_draw_code_parameters&) {});
+				scene.camera.remove_draw_code(std::move(key));
+			}
+			state.SetItemsProcessed(state.iterations());
+		}
+		BENCHMARK(add_draw_code_churn)->Arg(1)->Arg(1000);
+
+		/** Drawing a frame after drawing code has been added and removed, which makes the camera create its programs again.
+		 * The programs' command buffers are reused from the gpu's [[vulkan_object_pool]]; command_hit_rate is the share of them that were reused.
+		 * The argument is the amount of squares.
+		 */
+		void frame_after_draw_code_change(benchmark::State& state)
+		{
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			square_scene scene(environment, static_cast<std::size_t>(state.range(0)));
+			auto& target = scene.target.get();
+			auto& pool = target.gpu().object_pool();
+			auto stats_before = pool.stats();
+
+			for (auto _ : state)
+			{
+				auto key = scene.camera.add_draw_code([](const vulkan::vulkan_draw_code_parameters&) {});
+				scene.camera.remove_draw_code(std::move(key));
+				target.update_image();
+				environment.update();
+			}
+			scene.target.finish();
+
+			auto stats = pool.stats();
+			auto hit_rate = [](vulkan::vulkan_object_pool_counter after, vulkan::vulkan_object_pool_counter before)
+			{
+				return vulkan::vulkan_object_pool_counter{
+					.reused = after.reused - before.reused,
+					.created = after.created - before.created,
+				}.hit_rate();
+			};
+			state.counters["command_hit_rate"] = hit_rate(stats.commands, stats_before.commands);
+		}
+		BENCHMARK(frame_after_draw_code_change)->Arg(1)->Arg(1000)->Unit(benchmark::kMicrosecond);
+	}
+}
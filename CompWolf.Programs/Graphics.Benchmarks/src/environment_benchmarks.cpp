@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_setup.hpp"
+#include <chrono>
+#include <filesystem>
+#include <optional>
+
+namespace compwolf::benchmarks
+{
+	namespace
+	{
+		/** Creating and destroying an environment. */
+		void environment_startup(benchmark::State& state)
+		{
+			for (auto _ : state)
+			{
+				vulkan::vulkan_graphics_environment environment(environment_settings());
+				benchmark::DoNotOptimize(environment);
+			}
+		}
+		BENCHMARK(environment_startup)->Unit(benchmark::kMillisecond);
+
+		/** Creating an environment and everything needed to draw its first frame. */
+		void startup_to_first_frame(benchmark::State& state)
+		{
+			for (auto _ : state)
+			{
+				vulkan::vulkan_graphics_environment environment(environment_settings());
+				square_scene scene(environment, 1);
+				scene.target.get().update_image();
+				scene.target.finish();
+			}
+		}
+		BENCHMARK(startup_to_first_frame)->Unit(benchmark::kMillisecond);
+
+		/** Creating an environment and its first brush's pipeline, with the pipeline cache saved to a directory.
+		 * With 0, the directory is emptied before each iteration, so the pipeline is compiled from scratch; with 1, the cache saved by an earlier run is loaded.
+		 */
+		void startup_with_pipeline_cache(benchmark::State& state)
+		{
+			bool warm = state.range(0) != 0;
+			auto directory = std::filesystem::temp_directory_path() / "CompWolf.Graphics.Benchmarks.pipeline_cache";
+			std::filesystem::remove_all(directory);
+
+			auto settings = environment_settings();
+			settings.pipeline_cache_directory = directory.string();
+
+			// The cache is saved when the environment is destroyed.
+			if (warm)
+			{
+				vulkan::vulkan_graphics_environment environment(settings);
+				draw_target target(environment);
+				simple_brush<vulkan_types> brush(target.get().gpu());
+				brush.wait_for_pipeline(target.get());
+			}
+
+			std::size_t loaded_size = 0;
+			std::chrono::nanoseconds pipeline_creation_time{};
+			for (auto _ : state)
+			{
+				std::optional<vulkan::vulkan_graphics_environment> environment;
+				environment.emplace(settings);
+				{
+					draw_target target(*environment);
+					simple_brush<vulkan_types> brush(target.get().gpu());
+					brush.wait_for_pipeline(target.get());
+
+					auto& cache = target.get().gpu().pipeline_cache().stats();
+					loaded_size = cache.loaded_size;
+					pipeline_creation_time += cache.pipeline_creation_time;
+				}
+
+				// Saving the cache is not part of the startup.
+				state.PauseTiming();
+				environment.reset();
+				if (!warm) std::filesystem::remove_all(directory);
+				state.ResumeTiming();
+			}
+			std::filesystem::remove_all(directory);
+
+			state.counters["loaded_size"] = static_cast<double>(loaded_size);
+			state.counters["pipeline_creation_ms"] = std::chrono::duration<double, std::milli>(pipeline_creation_time).count() / static_cast<double>(state.iterations());
+		}
+		BENCHMARK(startup_with_pipeline_cache)->ArgName("warm")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+	}
+}
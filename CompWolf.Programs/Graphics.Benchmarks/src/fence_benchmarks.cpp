@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_setup.hpp"
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace compwolf::benchmarks
+{
+	namespace
+	{
+		/** The given amount of fences, spread over a few managers, as when several windows and uploads are in flight. */
+		struct fence_set
+		{
+			std::vector<vulkan::vulkan_gpu_program_manager> managers;
+			std::vector<vulkan::vulkan_gpu_fence> fences;
+			std::vector<const vulkan::vulkan_gpu_fence*> fence_pointers;
+
+			fence_set(vulkan::vulkan_graphics_environment& environment, std::size_t fence_count)
+			{
+				auto manager_count = std::clamp<std::size_t>(fence_count, 1, 8);
+				for (std::size_t i = 0; i < manager_count; ++i)
+				{
+					managers.push_back(vulkan::vulkan_gpu_program_manager::new_manager_for(environment, vulkan::gpu_program_manager_settings{
+						.type = { gpu_work_type::draw },
+					}));
+				}
+
+				fences.reserve(fence_count);
+				for (std::size_t i = 0; i < fence_count; ++i)
+				{
+					auto& manager = managers[i % managers.size()];
+					auto submission = manager.prepare_submission(nullptr);
+					vulkan::submit_programs(std::span(&submission, 1));
+					fences.push_back(manager.latest_fence());
+					fence_pointers.push_back(&fences.back());
+				}
+				for (auto& manager : managers) manager.wait();
+			}
+		};
+
+		/** Checking whether each of the given amount of fences is done, one at a time. */
+		void fence_completed_each(benchmark::State& state)
+		{
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			fence_set set(environment, static_cast<std::size_t>(state.range(0)));
+
+			for (auto _ : state)
+			{
+				std::size_t done = 0;
+				for (auto& fence : set.fences) done += fence.completed() ? 1 : 0;
+				benchmark::DoNotOptimize(done);
+			}
+
+			state.SetItemsProcessed(state.iterations() * state.range(0));
+			state.counters["queries"] = static_cast<double>(state.range(0));
+		}
+		BENCHMARK(fence_completed_each)->Arg(1)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+		/** Calling a function for each of the given amount of fences with [[vulkan_fence_reactor]], which queries each timeline once. */
+		void fence_reactor_poll(benchmark::State& state)
+		{
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			fence_set set(environment, static_cast<std::size_t>(state.range(0)));
+			auto& reactor = set.managers.front().gpu().fence_reactor();
+
+			std::size_t called = 0;
+			for (auto _ : state)
+			{
+				state.PauseTiming();
+				for (auto& fence : set.fences) fence.when_done([&called]() { ++called; });
+				state.ResumeTiming();
+
+				reactor.poll();
+			}
+			benchmark::DoNotOptimize(called);
+
+			state.SetItemsProcessed(state.iterations() * state.range(0));
+			state.counters["queries"] = static_cast<double>(reactor.stats().queries);
+		}
+		BENCHMARK(fence_reactor_poll)->Arg(1)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+		/** Waiting for all of the given amount of fences with a single [[wait_for_fences]]. */
+		void fence_wait_all(benchmark::State& state)
+		{
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			fence_set set(environment, static_cast<std::size_t>(state.range(0)));
+
+			for (auto _ : state)
+			{
+				auto done = vulkan::wait_for_fences(set.fence_pointers, true);
+				benchmark::DoNotOptimize(done);
+			}
+
+			state.SetItemsProcessed(state.iterations() * state.range(0));
+		}
+		BENCHMARK(fence_wait_all)->Arg(1)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+	}
+}
@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_setup.hpp"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace compwolf::benchmarks
+{
+	namespace
+	{
+		/** Drawing frames of the given amount of squares. */
+		void frame_time(benchmark::State& state)
+		{
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			square_scene scene(environment, static_cast<std::size_t>(state.range(0)));
+			auto& target = scene.target.get();
+
+			// the first frame records the camera's gpu-instructions, which is not what is measured
+			target.update_image();
+			scene.target.finish();
+
+			for (auto _ : state)
+			{
+				target.update_image();
+				environment.update();
+			}
+			scene.target.finish();
+
+			auto culling = scene.camera.cull_stats();
+			state.counters["visible"] = static_cast<double>(culling.visible);
+			state.counters["frames_per_second"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+		}
+		BENCHMARK(frame_time)->Arg(1)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+		/** Drawing frames of many squares, where one of them is moved every frame if the argument is 1.
+		 * Moving a square changes a push field, so the camera records its gpu-instructions again every frame, as it did before reusing them;
+		 * with 0, the scene is unchanged, so the instructions recorded for the first frames are reused.
+		 */
+		void unchanged_scene_frame_time(benchmark::State& state)
+		{
+			bool changing = state.range(0) != 0;
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			square_scene scene(environment, 10000);
+			auto& target = scene.target.get();
+
+			// the first frames record the gpu-instructions of each of the target's frames, which is not what is measured
+			for (std::size_t i = 0; i < target.swapchain().frames().size() * target.swapchain().frames_in_flight().size(); ++i) target.update_image();
+			scene.target.finish();
+			auto record_count = scene.camera.record_count();
+
+			auto& moved = *scene.squares.front();
+			auto position = moved.transform().data()[0].position;
+			float offset = 0.f;
+			for (auto _ : state)
+			{
+				if (changing)
+				{
+					offset = offset == 0.f ? .01f : 0.f;
+					auto moved_position = position;
+					moved_position[0] += offset;
+					moved.transform().data()[0].position = moved_position;
+				}
+				target.update_image();
+				environment.update();
+			}
+			scene.target.finish();
+
+			auto frames = static_cast<double>(state.iterations());
+			state.counters["records_per_frame"] = static_cast<double>(scene.camera.record_count() - record_count) / frames;
+			state.counters["frames_per_second"] = benchmark::Counter(frames, benchmark::Counter::kIsRate);
+		}
+		BENCHMARK(unchanged_scene_frame_time)->ArgName("changing")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+		/** Drawing frames of many squares with the given amount of frames in flight.
+		 * frame_wait_time is how long the cpu waited for the gpu each frame; it should shrink as more frames are in flight, as the cpu and gpu then work at the same time.
+		 */
+		void frames_in_flight_frame_time(benchmark::State& state)
+		{
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			square_scene scene(environment, 10000, static_cast<std::size_t>(state.range(0)));
+			auto& target = scene.target.get();
+
+			// the first frames record each frame in flight's gpu-instructions, which is not what is measured
+			for (int64_t i = 0; i < state.range(0); ++i) target.update_image();
+			scene.target.finish();
+
+			std::chrono::nanoseconds wait_time{};
+			std::chrono::nanoseconds fence_wait_time{};
+			for (auto _ : state)
+			{
+				target.update_image();
+				environment.update();
+				wait_time += target.swapchain().frame_wait_time();
+				fence_wait_time += target.swapchain().fence_wait_time();
+			}
+			scene.target.finish();
+
+			auto frames = static_cast<double>(state.iterations());
+			state.counters["frame_wait_us"] = std::chrono::duration<double, std::micro>(wait_time).count() / frames;
+			state.counters["fence_wait_us"] = std::chrono::duration<double, std::micro>(fence_wait_time).count() / frames;
+			state.counters["frames_per_second"] = benchmark::Counter(frames, benchmark::Counter::kIsRate);
+		}
+		BENCHMARK(frames_in_flight_frame_time)->DenseRange(1, 4)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+		/** Drawing a frame for each of the given amount of targets, given to the gpu together with a [[present_batch]]. */
+		void present_batch_frame_time(benchmark::State& state)
+		{
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			std::vector<std::unique_ptr<square_scene>> scenes;
+			for (int64_t i = 0; i < state.range(0); ++i)
+			{
+				scenes.push_back(std::make_unique<square_scene>(environment, 1));
+			}
+
+			vulkan::present_batch batch(environment);
+			for (auto _ : state)
+			{
+				for (auto& scene : scenes) batch.add(scene->target.get());
+				batch.submit();
+				environment.update();
+			}
+			for (auto& scene : scenes) scene->target.finish();
+
+			state.counters["submit_calls"] = static_cast<double>(batch.stats().submit_calls);
+		}
+		BENCHMARK(present_batch_frame_time)->DenseRange(1, 8)->Unit(benchmark::kMicrosecond)->UseRealTime();
+	}
+}
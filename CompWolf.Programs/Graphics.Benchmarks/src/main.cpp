@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_setup.hpp"
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+	// Unless told otherwise, the results are also written as JSON, so that they can be compared between commits
+	std::string out_argument = "--benchmark_out=CompWolf.Graphics.Benchmarks.json";
+	std::string out_format_argument = "--benchmark_out_format=json";
+
+	std::vector<char*> arguments(argv, argv + argc);
+	bool has_out = std::any_of(arguments.begin(), arguments.end(), [](const char* argument)
+		{
+			return std::string_view(argument).starts_with("--benchmark_out=");
+		}
+	);
+	if (!has_out)
+	{
+		arguments.push_back(out_argument.data());
+		arguments.push_back(out_format_argument.data());
+	}
+
+	int argument_count = static_cast<int>(arguments.size());
+	benchmark::Initialize(&argument_count, arguments.data());
+	if (benchmark::ReportUnrecognizedArguments(argument_count, arguments.data())) return 1;
+
+	benchmark::AddCustomContext("compwolf_draw_target", compwolf::benchmarks::windowed() ? "window" : "offscreen_target");
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+}
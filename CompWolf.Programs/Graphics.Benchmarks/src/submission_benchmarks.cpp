@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_setup.hpp"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace compwolf::benchmarks
+{
+	namespace
+	{
+		/** The given amount of empty programs, spread over a few managers, as when several cameras and compute programs draw a frame. */
+		struct program_set
+		{
+			std::vector<vulkan::vulkan_gpu_program_manager> managers;
+			// The programs keep pointers to themselves, so they must not move.
+			std::vector<std::unique_ptr<vulkan::vulkan_gpu_program>> programs;
+
+			program_set(vulkan::vulkan_graphics_environment& environment, std::size_t program_count)
+			{
+				auto manager_count = std::clamp<std::size_t>(program_count, 1, 4);
+				for (std::size_t i = 0; i < manager_count; ++i)
+				{
+					managers.push_back(vulkan::vulkan_gpu_program_manager::new_manager_for(environment, vulkan::gpu_program_manager_settings{
+						.type = { gpu_work_type::draw },
+					}));
+				}
+
+				for (std::size_t i = 0; i < program_count; ++i)
+				{
+					programs.push_back(std::make_unique<vulkan::vulkan_gpu_program>(managers[i % managers.size()]
+						, [](const vulkan::vulkan_code_parameters&) {}
+					));
+				}
+			}
+
+			void wait()
+			{
+				for (auto& manager : managers) manager.wait();
+			}
+		};
+
+		/** Giving the given amount of programs to the gpu with their own execute(), as in one vkQueueSubmit2 each. */
+		void programs_executed_each(benchmark::State& state)
+		{
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			program_set set(environment, static_cast<std::size_t>(state.range(0)));
+
+			std::size_t submit_calls = 0;
+			for (auto _ : state)
+			{
+				for (auto& program : set.programs) program->execute();
+				submit_calls += set.programs.size();
+
+				state.PauseTiming();
+				set.wait();
+				state.ResumeTiming();
+			}
+
+			state.counters["submits_per_frame"] = static_cast<double>(submit_calls) / static_cast<double>(state.iterations());
+		}
+		BENCHMARK(programs_executed_each)->Arg(1)->Arg(8)->Arg(64)->Unit(benchmark::kMicrosecond);
+
+		/** Giving the given amount of programs to the gpu with a [[submission_batch]], as in one vkQueueSubmit2 for each queue. */
+		void programs_in_submission_batch(benchmark::State& state)
+		{
+			vulkan::vulkan_graphics_environment environment(environment_settings());
+			program_set set(environment, static_cast<std::size_t>(state.range(0)));
+			vulkan::submission_batch batch;
+
+			std::size_t submit_calls = 0;
+			for (auto _ : state)
+			{
+				for (auto& program : set.programs) batch.add(*program);
+				submit_calls += batch.flush();
+
+				state.PauseTiming();
+				set.wait();
+				state.ResumeTiming();
+			}
+
+			state.counters["submits_per_frame"] = static_cast<double>(submit_calls) / static_cast<double>(state.iterations());
+		}
+		BENCHMARK(programs_in_submission_batch)->Arg(1)->Arg(8)->Arg(64)->Unit(benchmark::kMicrosecond);
+	}
+}
@@ -48,6 +48,8 @@ namespace compwolf::vulkan
 	COMPWOLF_GRAPHICS_DEFINE_VULKAN_CONVERTERS(vulkan, VkDescriptorPool, vulkan_handle::descriptor_pool)
 	COMPWOLF_GRAPHICS_DEFINE_VULKAN_CONVERTERS(vulkan, VkDescriptorSet, vulkan_handle::descriptor_set)
 	COMPWOLF_GRAPHICS_DEFINE_VULKAN_CONVERTERS(vulkan, VkPipeline, vulkan_handle::pipeline)
+	COMPWOLF_GRAPHICS_DEFINE_VULKAN_CONVERTERS(vulkan, VkPipelineCache, vulkan_handle::pipeline_cache)
+	COMPWOLF_GRAPHICS_DEFINE_VULKAN_CONVERTERS(vulkan, VkQueryPool, vulkan_handle::query_pool)
 
 	inline uint32_t to_vulkan(version_number a) { return VK_MAKE_API_VERSION(0, a.major, a.minor, a.patch); }
 
@@ -5,7 +5,10 @@
 #include <shaders>
 #include <gpu_buffers>
 #include <gpu_structs>
+#include <windows>
 #include "brush.hpp"
+#include <functional>
+#include <optional>
 #include <tuple>
 #include <utility>
 #include <stdexcept>
@@ -61,9 +64,11 @@ namespace compwolf
 		 */
 		using vertex_index_buffer_type = buffer_type<gpu_buffer_usage::input_index, shader_int>;
 
-		/** The type of buffer used to keep the uniform data of the drawable. */
+		/** The type of buffer used to keep the uniform data of the drawable.
+		 * @typeparam T The type of the field, which may be a [[shader_push_field]].
+		 */
 		template <typename T>
-		using field_buffer_type = buffer_type<gpu_buffer_usage::field, T>;
+		using field_buffer_type = buffer_type<shader_field_info<T>::usage, typename shader_field_info<T>::type>;
 		/** For each field of the drawable, the type of buffer used to keep that data.
 		 * This is in a [[type_list]].
 		 */
@@ -88,6 +93,7 @@ namespace compwolf
 		vertex_buffer_type* _vertex_buffer{};
 		vertex_index_buffer_type* _vertex_index_buffer{};
 		field_buffer_ptr_tuple _field_buffers{};
+		std::function<draw_bounds()> _bounds{};
 
 	public: // accessors
 		/** Returns the gpu that the drawable is on.
@@ -125,6 +131,16 @@ namespace compwolf
 		/** Returns the drawable's vertex indices. That is, the index of the vertices making up the drawable's triangles. */
 		auto vertex_index_buffer() const noexcept -> const vertex_index_buffer_type& { return *_vertex_index_buffer; }
 
+		/** Returns the area of the window that the drawable covers, if known.
+		 * This lets a camera skip drawing the drawable when it is outside of the camera.
+		 * @see drawable::set_bounds
+		 */
+		auto bounds() const -> std::optional<draw_bounds>
+		{
+			if (!_bounds) return std::nullopt;
+			return _bounds();
+		}
+
 		/** Returns the drawable's uniform data, in a tuple. */
 		auto field_buffers() const noexcept -> const field_buffer_ptr_tuple& { return _field_buffers; }
 
@@ -172,6 +188,18 @@ namespace compwolf
 			return *std::get<Index>(_field_buffers);
 		}
 
+	public: // modifiers
+		/** Sets the function used to get the area of the window that the drawable covers.
+		 * The function is called whenever the drawable is about to be drawn, and should therefore be cheap.
+		 * The area may be larger than what the drawable actually covers, but not smaller.
+		 * An empty function means that the area is not known, so the drawable is always drawn.
+		 * @see drawable::bounds
+		 */
+		void set_bounds(std::function<draw_bounds()> bounds) noexcept
+		{
+			_bounds = std::move(bounds);
+		}
+
 	public: // constructors
 		/** Constructs an invalid [[drawable]].
 		 * Using this drawable is undefined behaviour.
@@ -0,0 +1,129 @@
+#ifndef COMPWOLF_GRAPHICS_GPU_TASK
+#define COMPWOLF_GRAPHICS_GPU_TASK
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace compwolf
+{
+	/** A coroutine that can wait for the gpu without blocking the thread, by co_awaiting a fence like one returned by [[gpu_specific_program::execute]].
+	 * While it waits, the thread goes on with other things, like drawing; the coroutine is then resumed by [[graphics_environment::update]] once the gpu is done.
+	 * A task can also co_await another task, to continue once that one is done.
+	 *
+	 * The coroutine starts running as soon as it is called.
+	 * If the task is destroyed before the coroutine is done, the coroutine keeps running, and cleans itself up when it is done.
+	 *
+	 * For example:
+	 *     auto read_back(vulkan_gpu_program& program) -> gpu_task
+	 *     {
+	 *         co_await program.execute();
+	 *         // The program is now done.
+	 *     }
+	 */
+	class gpu_task
+	{
+	public:
+		/** Used by the compiler to implement coroutines returning [[gpu_task]].
+		 * @hidden
+		 */
+		struct promise_type
+		{
+			std::exception_ptr exception;
+			std::coroutine_handle<> continuation;
+			bool detached{};
+
+			auto get_return_object() noexcept -> gpu_task
+			{
+				return gpu_task(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+			auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+			auto final_suspend() noexcept
+			{
+				struct final_awaiter
+				{
+					auto await_ready() noexcept -> bool { return false; }
+					auto await_suspend(std::coroutine_handle<promise_type> handle) noexcept -> std::coroutine_handle<>
+					{
+						auto& promise = handle.promise();
+						auto continuation = promise.continuation;
+						if (promise.detached) handle.destroy();
+						return continuation ? continuation : std::noop_coroutine();
+					}
+					void await_resume() noexcept {}
+				};
+				return final_awaiter{};
+			}
+			void return_void() noexcept {}
+			void unhandled_exception() noexcept { exception = std::current_exception(); }
+		};
+
+	private:
+		std::coroutine_handle<promise_type> _handle{};
+
+		explicit gpu_task(std::coroutine_handle<promise_type> handle) noexcept : _handle(handle) {}
+
+	public: // accessors
+		/** Returns whether the coroutine is done. */
+		auto done() const noexcept -> bool { return !_handle || _handle.done(); }
+
+		/** Returns whether this is valid, that is one not constructed by the default constructor. */
+		operator bool() const noexcept
+		{
+			return !!_handle;
+		}
+
+	public: // modifiers
+		/** Throws any exception thrown by the coroutine, if it is done. */
+		void rethrow_if_failed() const
+		{
+			if (done() && _handle && _handle.promise().exception) std::rethrow_exception(_handle.promise().exception);
+		}
+
+		/** Allows a coroutine to co_await the task; it is resumed once the task is done, with any exception thrown by the task. */
+		auto operator co_await() const noexcept
+		{
+			struct awaiter
+			{
+				std::coroutine_handle<promise_type> handle;
+
+				auto await_ready() const noexcept -> bool { return !handle || handle.done(); }
+				void await_suspend(std::coroutine_handle<> awaiting) const noexcept { handle.promise().continuation = awaiting; }
+				void await_resume() const
+				{
+					if (handle && handle.promise().exception) std::rethrow_exception(handle.promise().exception);
+				}
+			};
+			return awaiter{ _handle };
+		}
+
+	public: // constructors
+		/** Constructs an invalid [[gpu_task]].
+		 * @overload
+		 */
+		gpu_task() = default;
+		gpu_task(gpu_task&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+		auto operator=(gpu_task&& other) noexcept -> gpu_task&
+		{
+			if (this != &other)
+			{
+				release();
+				_handle = std::exchange(other._handle, nullptr);
+			}
+			return *this;
+		}
+		~gpu_task() noexcept { release(); }
+
+	private:
+		/** Destroys the coroutine if it is done, or lets it clean itself up once it is. */
+		void release() noexcept
+		{
+			if (!_handle) return;
+			if (_handle.done()) _handle.destroy();
+			else _handle.promise().detached = true;
+			_handle = nullptr;
+		}
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_GPU_TASK
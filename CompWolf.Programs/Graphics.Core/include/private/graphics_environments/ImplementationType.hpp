@@ -13,6 +13,14 @@ namespace compwolf
 		input,
 		input_index,
 		field,
+		/** Small data that is pushed directly into the gpu-instructions, instead of being kept in memory on the gpu.
+		 * Changing the data is therefore cheap, but the amount of data is very limited.
+		 */
+		push_field,
+		/** Data that the gpu can both read and write, like the data that a compute shader works on.
+		 * Unlike a field, the shader sees the buffer as an array of any length.
+		 */
+		storage_field,
 	};
 
 	/** A container for the the set of types implementing [[Graphics.Core]]. */
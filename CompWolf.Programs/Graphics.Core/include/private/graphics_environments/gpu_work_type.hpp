@@ -12,6 +12,10 @@ namespace compwolf
 		draw,
 		/** Change what image is shown on a window. */
 		present,
+		/** Running general-purpose computations, like deciding what to draw. */
+		compute,
+		/** Copying data between buffers, like uploading data from the cpu. */
+		transfer,
 		/** The amount of values in this enum, excluding this. */
 		size,
 	};
@@ -1,6 +1,7 @@
 #ifndef COMPWOLF_GRAPHICS_SHADER
 #define COMPWOLF_GRAPHICS_SHADER
 
+#include <graphics_environments>
 #include <type_value_pairs>
 #include <type_lists>
 #include <utility>
@@ -11,6 +12,57 @@ namespace compwolf
 {
 	struct pixel_output_type;
 
+	/** Denotes that a [[shader]]'s field is a push field, instead of a normal field.
+	 * A push field is given to the gpu along with the gpu-instructions when drawing, instead of being kept in a buffer of its own; see [[gpu_buffer_usage::push_field]].
+	 * How the shader reads it depends on the implementation; the Vulkan-implementation, for example, reads it from [[vulkan::vulkan_draw_fields]].
+	 * Push fields are laid out after each other, ordered by position, where each field is aligned as described by the std430-layout.
+	 * A shader must therefore declare its push fields at the offsets that this layout gives them.
+	 * @typeparam T The type of data in the field.
+	 */
+	template <typename T>
+	struct shader_push_field
+	{
+		/** The type of data in the field. */
+		using type = T;
+	};
+
+	/** Denotes that a [[shader]]'s field is a storage field, instead of a normal field.
+	 * A storage field can be written to by the shader, and is an array of any length; see [[gpu_buffer_usage::storage_field]].
+	 * @typeparam T The type of the field's elements.
+	 */
+	template <typename T>
+	struct shader_storage_field
+	{
+		/** The type of the field's elements. */
+		using type = T;
+	};
+
+	/** Gets how the data of a [[shader]]'s field of the given type is used.
+	 * @typeparam FieldType The type of the field, which may be a [[shader_push_field]] or [[shader_storage_field]].
+	 */
+	template <typename FieldType>
+	struct shader_field_info
+	{
+		/** The type of data in the field. */
+		using type = FieldType;
+		/** How the buffers containing the field's data are used. */
+		static constexpr gpu_buffer_usage usage = gpu_buffer_usage::field;
+	};
+	/** @hidden */
+	template <typename T>
+	struct shader_field_info<shader_push_field<T>>
+	{
+		using type = T;
+		static constexpr gpu_buffer_usage usage = gpu_buffer_usage::push_field;
+	};
+	/** @hidden */
+	template <typename T>
+	struct shader_field_info<shader_storage_field<T>>
+	{
+		using type = T;
+		static constexpr gpu_buffer_usage usage = gpu_buffer_usage::storage_field;
+	};
+
 	/** Gets the SPIR-V code from the given file. SPIR-V code is used to construct a shader.
 	 * @throws std::runtime_error if the given file could not be found or opened.
 	 */
@@ -22,6 +74,7 @@ namespace compwolf
 	 * @typeparam OutputType The type of element that the shader outputs.
 	 * @typeparam FieldTypes The fields that the shader has.
 	 * These must be [[type_value_pair]]s, denoting the type and position of the fields.
+	 * A field's type can be a [[shader_push_field]], to make it a push field, or a [[shader_storage_field]], to make it a storage field.
 	 * These must be sorted by position.
 	 * @warning It is undefined behaviour if the given FieldTypes are not sorted by position.
 	 */
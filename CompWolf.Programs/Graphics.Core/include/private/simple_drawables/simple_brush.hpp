@@ -41,10 +41,13 @@ namespace compwolf
 			single_color_pixel_shader<Implementation>::get(gpu))
 		{
 		}
-		/** Creates a brush on the given camera's gpu. */
+		/** Creates a brush on the given camera's gpu, and starts preparing it to draw on the camera's window. */
 		simple_brush(Implementation::camera& camera)
 			: simple_brush(camera.gpu())
-		{ }
+		{
+			if constexpr (requires { super::prepare(camera.window()); })
+				super::prepare(camera.window());
+		}
 	};
 }
 
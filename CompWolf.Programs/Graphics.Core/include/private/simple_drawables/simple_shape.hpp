@@ -6,6 +6,8 @@
 #include "simple_brush.hpp"
 #include <gpu_structs>
 #include <gpu_buffers>
+#include <windows>
+#include <algorithm>
 
 namespace compwolf
 {
@@ -30,11 +32,11 @@ namespace compwolf
 		>;
 
 		using transform_buffer_type = typename Implementation::template buffer<
-			gpu_buffer_usage::field,
+			gpu_buffer_usage::push_field,
 			simple_transform_data
 		>;
 		using color_buffer_type = typename Implementation::template buffer<
-			gpu_buffer_usage::field,
+			gpu_buffer_usage::push_field,
 			float3
 		>;
 
@@ -47,6 +49,9 @@ namespace compwolf
 		color_buffer_type _color;
 		drawable_type _drawable;
 
+		/** The area covered by the vertices, before they are moved and scaled by the shape's transform. */
+		draw_bounds _vertex_bounds{};
+
 	public:
 		/** Returns the vertices making up the shape.
 		 * @customoverload
@@ -81,6 +86,47 @@ namespace compwolf
 		/** Returns the gpu that the shape is on. */
 		auto gpu() const noexcept -> const typename Implementation::gpu& { return vertices().gpu(); }
 
+		/** Returns the area of the window that the shape covers.
+		 * @see draw_bounds
+		 */
+		auto bounds() -> draw_bounds
+		{
+			auto transform_data = transform().data()[0];
+			draw_bounds bounds;
+			for (std::size_t i = 0; i < 2; ++i)
+			{
+				auto a = _vertex_bounds.min[i] * transform_data.scale[i] + transform_data.position[i];
+				auto b = _vertex_bounds.max[i] * transform_data.scale[i] + transform_data.position[i];
+				bounds.min[i] = std::min(a, b);
+				bounds.max[i] = std::max(a, b);
+			}
+			return bounds;
+		}
+
+	public: // modifiers
+		/** Updates the area that the shape is considered to cover, from its vertices.
+		 * This should be called after changing the vertices, as a camera may otherwise wrongly skip drawing the shape.
+		 */
+		void update_bounds()
+		{
+			auto vertex_data = vertices().data();
+			if (vertex_data.empty())
+			{
+				_vertex_bounds = draw_bounds();
+				return;
+			}
+
+			_vertex_bounds.min = _vertex_bounds.max = vertex_data[0];
+			for (auto& vertex : vertex_data)
+			{
+				for (std::size_t i = 0; i < 2; ++i)
+				{
+					_vertex_bounds.min[i] = std::min(_vertex_bounds.min[i], vertex[i]);
+					_vertex_bounds.max[i] = std::max(_vertex_bounds.max[i], vertex[i]);
+				}
+			}
+		}
+
 	public: // constructors
 		/** Constructs an invalid [[simple_shape]].
 		 * Using this shape is undefined behaviour.
@@ -111,6 +157,9 @@ namespace compwolf
 		{
 			if (transform != simple_transform_data()) _transform.data()[0] = transform;
 			if (color != float3()) _color.data()[0] = color;
+
+			update_bounds();
+			_drawable.set_bounds([this]() { return bounds(); });
 		}
 	};
 }
@@ -36,13 +36,13 @@ namespace compwolf
 
 	/** A simple input shader for drawing objects.
 	 * It takes, as its input, 2D-position as its vertices' position.
-	 * It also has a 2D-position as a field, denoting the objects position.
+	 * It also has a [[simple_transform_data]] as a push field, denoting the objects position and scale.
 	 * @typeparam Implementation The implementation of [[CompWolf.Graphics]] to use.
 	 */
 	template <ImplementationType Implementation = default_implementation>
 	using simple_vertex_shader = static_shader<internal::simple_vertex_shader_path,
 		typename Implementation::template shader<
-			float2, float4, type_value_pair<simple_transform_data, 0>
+			float2, float4, type_value_pair<shader_push_field<simple_transform_data>, 0>
 		>
 	>;
 }
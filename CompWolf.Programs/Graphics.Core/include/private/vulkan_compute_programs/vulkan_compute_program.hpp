@@ -0,0 +1,238 @@
+#ifndef COMPWOLF_GRAPHICS_VULKAN_COMPUTE_PROGRAM
+#define COMPWOLF_GRAPHICS_VULKAN_COMPUTE_PROGRAM
+
+#include <vulkan_graphics_environments>
+#include <vulkan_programs>
+#include <vulkan_shaders>
+#include <vulkan_gpu_buffers>
+#include <vulkan_drawables>
+#include "vulkan_compute_program_internal.hpp"
+#include <array>
+#include <tuple>
+#include <concepts>
+
+namespace compwolf::vulkan
+{
+	/** A program running a [[vulkan_compute_shader]] on the gpu, with some given fields.
+	 * Each time the program is run, the shader is run in the program's amount of work groups; see [[vulkan_compute_program::set_group_count]].
+	 * The program's manager must be able to do [[gpu_work_type::compute]] work.
+	 * @typeparam ShaderType The type of [[vulkan_compute_shader]] that the program runs.
+	 * @see vulkan_gpu_program
+	 */
+	template <typename ShaderType>
+	class vulkan_compute_program
+	{
+	public:
+		/** The type of [[vulkan_compute_shader]] that the program runs. */
+		using shader_type = ShaderType;
+		/** The type and position of the shader's fields, in a [[type_list]]. */
+		using field_types = typename shader_type::field_types;
+
+		/** The type of [[vulkan_gpu_buffer]] used for a field of the given type. */
+		template <typename T>
+		using field_buffer_type = vulkan_gpu_buffer<shader_field_info<T>::usage, typename shader_field_info<T>::type>;
+		/** The type of [[vulkan_gpu_buffer]]s used for the shader's fields, in a [[type_list]]. */
+		using field_buffer_types = typename field_types
+			::template transform<
+				compwolf::internal::field_buffer<field_buffer_type>::template transformer
+			>;
+		/** A tuple of pointers to the buffers used for the shader's fields. */
+		using field_buffer_ptr_tuple = typename field_types
+			::template transform<
+				compwolf::internal::field_buffer<field_buffer_type>::template ptr_transformer
+			>
+			::template to_other_container<std::tuple>;
+
+		/** The maximum size, in bytes, that a compute shader's push fields may take up together.
+		 * This is the size that Vulkan guarantees every gpu supports.
+		 */
+		static constexpr std::size_t max_push_fields_size = 128;
+
+		/** Returns the offset of each of the shader's push fields, followed by the size of all of the push fields, by value.
+		 * Returning by value allows this to be run at compile-time.
+		 * The offset of a field that is not a push field is meaningless.
+		 * @see shader_push_field
+		 */
+		static constexpr auto push_field_layout_val() noexcept -> std::vector<std::size_t>
+		{
+			return internal::vulkan_push_field_layout(
+				field_types::template transform_to_value<internal::is_push_field, std::vector<bool>>(),
+				field_types::template transform_to_value<internal::field_size, std::vector<std::size_t>>(),
+				field_types::template transform_to_value<internal::field_alignment, std::vector<std::size_t>>()
+			);
+		}
+
+		/** Returns the shader's fields' positions. */
+		static auto field_positions() noexcept -> const std::vector<std::size_t>&
+		{
+			static auto position = field_types::template transform_to_value<
+				internal::vulkan_brush_get_from_pair,
+				std::vector<std::size_t>
+			>();
+			return position;
+		}
+
+	private:
+		static inline internal::vulkan_compute_program_info _internal_info
+		{
+			.field_indices
+				= &field_positions(),
+			.field_is_push_field
+				= field_types::template transform_to_value<
+					internal::is_push_field,
+					std::vector<bool>
+				>(),
+			.field_is_storage_field
+				= field_types::template transform_to_value<
+					internal::is_storage_field,
+					std::vector<bool>
+				>(),
+			.field_sizes
+				= field_types::template transform_to_value<
+					internal::field_size,
+					std::vector<std::size_t>
+				>(),
+			.field_push_offsets
+				= push_field_layout_val(),
+		};
+
+		shader_type* _shader{};
+		internal::vulkan_compute_program_internal _internal;
+		vulkan_gpu_program _program;
+		std::array<uint32_t, 3> _group_count{ 1, 1, 1 };
+
+		field_buffer_ptr_tuple _field_buffers{};
+		std::array<vulkan_handle::buffer, field_buffer_types::size> _field_buffer;
+		std::array<const void*, field_buffer_types::size> _field_push_data;
+
+		template <std::size_t Step>
+		constexpr void setup_field_data()
+		{
+			if constexpr (Step < field_buffer_types::size)
+			{
+				auto& field = std::get<Step>(_field_buffers);
+				_field_buffer[Step] = field->vulkan_buffer();
+				_field_push_data[Step] = field->vulkan_push_data();
+				setup_field_data<Step + 1>();
+			}
+		}
+
+		/** Waits for the program's previous run, and then records its gpu-instructions with the fields' current data. */
+		void record()
+		{
+			if (auto& fence = _program.last_fence()) fence.wait();
+
+			_program.record([this](const vulkan_code_parameters& args)
+				{
+					_internal.record(_shader->gpu(), args, _internal_info
+						, _field_buffer.data()
+						, _field_push_data.data()
+						, _group_count
+					);
+				}
+			);
+		}
+
+	public: // accessors
+		/** Returns the shader that the program runs. */
+		auto shader() noexcept -> shader_type& { return *_shader; }
+		/** Returns the shader that the program runs. */
+		auto shader() const noexcept -> const shader_type& { return *_shader; }
+
+		/** Returns the buffers used for the shader's fields. */
+		auto field_buffers() const noexcept -> const field_buffer_ptr_tuple& { return _field_buffers; }
+
+		/** Returns the amount of work groups that the shader is run in, along the x, y, and z axes. */
+		auto group_count() const noexcept -> const std::array<uint32_t, 3>& { return _group_count; }
+
+		/** Returns the fence denoting when the program's latest run is finished.
+		 * This is invalid if the program has not been run.
+		 */
+		auto last_fence() const noexcept -> const vulkan_gpu_fence& { return _program.last_fence(); }
+
+		/** Returns whether this is valid, that is one not constructed by the default constructor. */
+		operator bool() const noexcept
+		{
+			return !!_program;
+		}
+
+	public: // modifiers
+		/** Sets the amount of work groups that the shader is run in, along the x, y, and z axes.
+		 * The size of a work group is set by the shader itself, with local_size_x, local_size_y, and local_size_z.
+		 */
+		void set_group_count(uint32_t x, uint32_t y = 1, uint32_t z = 1) noexcept
+		{
+			_group_count = { x, y, z };
+		}
+
+		/** Runs the shader with the fields' current data.
+		 * This first waits for the program's previous run to finish.
+		 * Once the returned fence is done, the cpu can read what the shader wrote to the storage fields.
+		 * @return a fence denoting when the shader is finished running.
+		 * @throws std::runtime_error if there was an error submitting the program to the gpu due to causes outside of the program.
+		 */
+		auto execute() -> const vulkan_gpu_fence&
+		{
+			record();
+			return _program.execute();
+		}
+
+		/** Prepares running the shader like execute(), but returns the work instead of giving it to the gpu.
+		 * This allows several programs to be given to the gpu together with [[submit_programs]].
+		 * @see vulkan_gpu_program::prepare_execution
+		 */
+		auto prepare_execution() -> vulkan_gpu_submission
+		{
+			record();
+			return _program.prepare_execution();
+		}
+
+	public: // vulkan-specific
+		/** Returns the [[vulkan_handle::pipeline]] that the program runs. */
+		auto vulkan_pipeline() const noexcept -> vulkan_handle::pipeline { return _internal.vulkan_pipeline.get(); }
+
+		/** Returns the [[vulkan_handle::pipeline_layout]] of the pipeline that the program runs. */
+		auto vulkan_pipeline_layout() const noexcept -> vulkan_handle::pipeline_layout { return _internal.vulkan_pipeline_layout.get(); }
+
+		/** Returns the [[vulkan_gpu_program]] that records and runs the program's gpu-instructions. */
+		auto vulkan_program() noexcept -> vulkan_gpu_program& { return _program; }
+
+	public: // constructors
+		/** Constructs an invalid [[vulkan_compute_program]].
+		 * Using this program is undefined behaviour.
+		 * @overload
+		 */
+		vulkan_compute_program() = default;
+		vulkan_compute_program(vulkan_compute_program&&) = default;
+		auto operator=(vulkan_compute_program&&) -> vulkan_compute_program& = default;
+
+		/** Creates a program running the given shader with the given fields, on the given manager.
+		 * @throws std::runtime_error if there was an error during setup due to causes outside of the program.
+		 * @customoverload
+		 */
+		vulkan_compute_program(vulkan_gpu_program_manager& manager, shader_type& shader
+			, field_buffer_ptr_tuple field_ptrs)
+			: _shader(&shader)
+			, _internal(shader.gpu(), _internal_info, shader.vulkan_shader_module())
+			, _program(manager, [](const vulkan_code_parameters&) {})
+			, _field_buffers(field_ptrs)
+		{
+			static_assert(push_field_layout_val().back() <= max_push_fields_size,
+				"The compute shader's push fields take up more space than is guaranteed to be supported; consider making some of them normal fields");
+
+			// Nothing before the shader uses the fields, so only the shader waits for earlier work.
+			_program.set_wait_stages(vulkan_access_info(vulkan_resource_access::compute_shader_write).stages);
+
+			setup_field_data<0>();
+		}
+		/** Creates a program running the given shader with the given fields, on the given manager. */
+		template <typename... FieldBufferTypes>
+			requires (std::same_as<type_list<FieldBufferTypes...>, field_buffer_types>)
+		vulkan_compute_program(vulkan_gpu_program_manager& manager, shader_type& shader
+			, FieldBufferTypes&... fields)
+			: vulkan_compute_program(manager, shader, std::make_tuple(&fields...))
+		{ }
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_VULKAN_COMPUTE_PROGRAM
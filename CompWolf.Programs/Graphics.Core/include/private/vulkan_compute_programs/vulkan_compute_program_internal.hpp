@@ -0,0 +1,71 @@
+#ifndef COMPWOLF_GRAPHICS_VULKAN_COMPUTE_PROGRAM_INTERNAL
+#define COMPWOLF_GRAPHICS_VULKAN_COMPUTE_PROGRAM_INTERNAL
+
+#include <vulkan_graphics_environments>
+#include <vulkan_programs>
+#include <unique_deleter_ptr>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace compwolf::vulkan::internal
+{
+	/** @hidden */
+	struct vulkan_compute_program_info
+	{
+		const std::vector<std::size_t>* field_indices;
+
+		std::vector<bool> field_is_push_field;
+		std::vector<bool> field_is_storage_field;
+		std::vector<std::size_t> field_sizes;
+		/** The offset of each push field in the shader's push-constant range, followed by the size of the entire range.
+		 * The offset of a field that is not a push field is meaningless.
+		 */
+		std::vector<std::size_t> field_push_offsets;
+	};
+
+	/** @hidden */
+	class vulkan_compute_program_internal
+	{
+	public:
+		unique_deleter_ptr<vulkan_handle::descriptor_set_layout_t> vulkan_descriptor_set_layout{};
+		unique_deleter_ptr<vulkan_handle::pipeline_layout_t> vulkan_pipeline_layout{};
+		unique_deleter_ptr<vulkan_handle::pipeline_t> vulkan_pipeline{};
+
+		unique_deleter_ptr<vulkan_handle::descriptor_pool_t> vulkan_descriptor_pool{};
+		/** Descriptor sets do not need to be cleaned up explicitly; they are cleaned up when the pool is cleaned up. */
+		vulkan_handle::descriptor_set vulkan_descriptor_set{};
+
+	public: // vulkan-specific
+		/** Records running the shader with the given fields, in the given amount of work groups.
+		 * The program must not be running when this is called, as the descriptor set is updated.
+		 * Afterwards, the cpu can read the storage fields once the program is done.
+		 * @param field_buffers The buffer of each field; the elements for push fields are ignored.
+		 * @param field_push_data The cpu-memory of each push field; the elements for other fields are ignored.
+		 */
+		void record(vulkan_gpu_connection&
+			, const vulkan_code_parameters&
+			, const vulkan_compute_program_info&
+			, const vulkan_handle::buffer* field_buffers
+			, const void* const* field_push_data
+			, std::array<uint32_t, 3> group_count
+		) const;
+
+	public: // constructors
+		/** Constructs an invalid [[vulkan_compute_program_internal]].
+		 * Using this is undefined behaviour.
+		 * @overload
+		 */
+		vulkan_compute_program_internal() = default;
+		vulkan_compute_program_internal(vulkan_compute_program_internal&&) = default;
+		auto operator=(vulkan_compute_program_internal&&) -> vulkan_compute_program_internal& = default;
+
+		/** Creates the compute pipeline for the given shader, and a descriptor set for its fields.
+		 * @throws std::runtime_error if there was an error during setup due to causes outside of the program.
+		 */
+		vulkan_compute_program_internal(vulkan_gpu_connection&, const vulkan_compute_program_info&, vulkan_handle::shader);
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_VULKAN_COMPUTE_PROGRAM_INTERNAL
@@ -7,6 +7,8 @@
 #include "vulkan_brush_internal.hpp"
 #include <compwolf_type_traits>
 #include <vulkan_gpu_structs>
+#include <algorithm>
+#include <functional>
 #include <map>
 #include <utility>
 
@@ -28,9 +30,36 @@ namespace compwolf::vulkan
 				static constexpr bool value = TypeList::template has<T>;
 			};
 		};
+
+		/** @hidden */
+		template <typename FieldPair>
+		struct is_push_field
+		{
+			static constexpr bool value = shader_field_info<typename FieldPair::type>::usage == gpu_buffer_usage::push_field;
+		};
+		/** @hidden */
+		template <typename FieldPair>
+		struct is_storage_field
+		{
+			static constexpr bool value = shader_field_info<typename FieldPair::type>::usage == gpu_buffer_usage::storage_field;
+		};
+		/** @hidden */
+		template <typename FieldPair>
+		struct field_size
+		{
+			static constexpr std::size_t value = sizeof(typename shader_field_info<typename FieldPair::type>::type);
+		};
+		/** @hidden */
+		template <typename FieldPair>
+		struct field_alignment
+		{
+			static constexpr std::size_t value = get_vulkan_alignment<typename shader_field_info<typename FieldPair::type>::type>::value;
+		};
 	}
 
 	/** A Vulkan-implementation of [[brush]].
+	 * The shaders' push fields are not pushed into the gpu-instructions; they are read from the buffer of the camera's [[vulkan_draw_fields]] instead,
+	 * so that drawables with different push fields can be drawn with a single draw.
 	 * @typeparam GraphicsEnvironmentType The type of [[graphics_environment]] that this buffer works with.
 	 * @typeparam InputShaderType The type of vertex shader used by the brush.
 	 * That is, when drawing an object, the shader used to modify the object's elements/vertices.
@@ -45,6 +74,26 @@ namespace compwolf::vulkan
 	{
 		using super = brush<InputShaderType, PixelShaderType>;
 
+	public: // accessors
+		/** The maximum size, in bytes, that a brush's push fields may take up together.
+		 * This is the size of a drawable's slot in [[vulkan_draw_fields]].
+		 */
+		static constexpr std::size_t max_push_fields_size = vulkan_draw_fields::slot_size;
+
+		/** Returns the offset of each of the brush's push fields, followed by the size of all of the push fields, by value.
+		 * Returning by value allows this to be run at compile-time.
+		 * The offset of a field that is not a push field is meaningless.
+		 * @see shader_push_field
+		 */
+		static constexpr auto push_field_layout_val() noexcept -> std::vector<std::size_t>
+		{
+			return internal::vulkan_push_field_layout(
+				super::field_types::template transform_to_value<internal::is_push_field, std::vector<bool>>(),
+				super::field_types::template transform_to_value<internal::field_size, std::vector<std::size_t>>(),
+				super::field_types::template transform_to_value<internal::field_alignment, std::vector<std::size_t>>()
+			);
+		}
+
 	private:
 		static inline internal::vulkan_brush_info _internal_info
 		{
@@ -76,9 +125,24 @@ namespace compwolf::vulkan
 					internal::template is_in<typename super::pixel_shader_type::field_types>::template transformer,
 					std::vector<bool>
 				>(),
+
+			.field_is_push_field
+				= super::field_types::template transform_to_value<
+					internal::is_push_field,
+					std::vector<bool>
+				>(),
+			.field_sizes
+				= super::field_types::template transform_to_value<
+					internal::field_size,
+					std::vector<std::size_t>
+				>(),
+			.field_push_offsets
+				= push_field_layout_val(),
 		};
 		internal::vulkan_brush_internal _internal;
 		mutable std::map<vulkan_window*, internal::vulkan_window_brush> _window_data;
+		/** The brush's pipelines, by the format of the images they draw on; windows with the same format share a render pass, and so a pipeline. */
+		mutable std::map<vulkan_handle::format, internal::vulkan_brush_pipeline> _pipelines;
 
 	private: // vulkan-specific
 		/** Gets the data for the given window.
@@ -89,15 +153,31 @@ namespace compwolf::vulkan
 			auto i = _window_data.find(&window);
 			if (i != _window_data.end()) return i->second;
 			return _window_data.emplace(&window
-				, internal::vulkan_window_brush(window, _internal_info
+				, internal::vulkan_window_brush(window, _internal.vulkan_descriptor_set_layout.get())
+			).first->second;
+		}
+		/** Gets the pipeline for the given window.
+		 * This starts creating the pipeline if it is not already created, or being created, for a window with the same format.
+		 */
+		auto get_pipeline_data(vulkan_window& window) const -> internal::vulkan_brush_pipeline&
+		{
+			auto format = window.surface().vulkan_image_format();
+			auto i = _pipelines.find(format);
+			if (i != _pipelines.end()) return i->second;
+			return _pipelines.emplace(format
+				, internal::vulkan_brush_pipeline(window.gpu(), window.surface().vulkan_render_pass(), format, _internal_info
 					, super::input_shader().vulkan_shader_module()
 					, super::pixel_shader().vulkan_shader_module()
-					, _internal.vulkan_descriptor_set_layout.get()
 					, _internal.vulkan_pipeline_layout.get()
 				)
 			).first->second;
 		}
 	public:
+		/** Returns information about the brush's fields and input.
+		 * @hidden
+		 */
+		static auto vulkan_field_info() noexcept -> const internal::vulkan_brush_info& { return _internal_info; }
+
 		/** Returns the [[vulkan_handle::pipeline_layout]] of the pipeline that the brush represents. */
 		auto vulkan_pipeline_layout() const noexcept -> vulkan_handle::pipeline_layout { return _internal.vulkan_pipeline_layout.get(); }
 
@@ -108,25 +188,63 @@ namespace compwolf::vulkan
 		 * @param window the [[vulkan_window]] that the descriptor pool is for.
 		 */
 		auto vulkan_descriptor_pool(vulkan_window& window) const -> vulkan_handle::descriptor_pool
-			{ return get_window_data(window).descriptor_set_layout.get(); }
-		/** Returns the [[vulkan_handle::descriptor_set]] of the pipeline that the brush represents.
+			{ return get_window_data(window).vulkan_descriptor_pool.get(); }
+		/** Returns the [[vulkan_handle::descriptor_set]]s of the pipeline that the brush represents, one for each of the window's [[window_swapchain::frames_in_flight]].
 		 * @param window the [[vulkan_window]] that the descriptor set is for.
 		 */
 		auto vulkan_descriptor_set(vulkan_window& window) const -> const std::vector<vulkan_handle::descriptor_set>&
 			{ return get_window_data(window).vulkan_descriptor_set; }
 		
-		/** Returns the [[vulkan_handle::pipeline]] that the brush represents.
+		/** Returns the [[vulkan_handle::pipeline]] that the brush represents, or null if it is still being created.
+		 * This does not wait for the pipeline to be created; see [[vulkan_brush::wait_for_pipeline]] for that.
 		 * @param window the [[vulkan_window]] that the pipeline is for.
+		 * @throws std::runtime_error if the pipeline could not be created.
 		 */
 		auto vulkan_pipeline(vulkan_window& window) const -> vulkan_handle::pipeline
-			{ return get_window_data(window).vulkan_pipeline.get(); }
+		{
+			auto& data = get_pipeline_data(window);
+			if (!data.pipeline_ready()) return nullptr;
+			return data.vulkan_pipeline.get();
+		}
 		
-		/** Returns the [[vulkan_handle::frame_buffer]] that the brush represents.
+		/** Returns the [[vulkan_handle::frame_buffer]] that the brush draws on.
+		 * The frame buffers are owned by the window's [[window_swapchain]], and are the same for all brushes.
+		 * This is null if the gpu uses dynamic rendering.
 		 * @param window the [[vulkan_window]] that the buffer is for.
 		 * @param frame_index the index of the frame that the buffer is for.
 		 */
 		auto vulkan_frame_buffer(vulkan_window& window, std::size_t frame_index) const -> vulkan_handle::frame_buffer
-			{ return get_window_data(window).vulkan_frame_buffer.at(frame_index).get(); }
+			{ return window.swapchain().frames().at(frame_index).frame_buffer(); }
+
+	public: // modifiers
+		/** Starts preparing the brush to draw on the given window, if it is not already doing so.
+		 * Creating the brush's pipeline for a window takes a while, so this is done on another thread;
+		 * until it is done, drawables using the brush are not drawn on the window.
+		 * @see vulkan_brush::pipeline_ready
+		 */
+		void prepare(vulkan_window& window) const
+		{
+			get_window_data(window);
+			get_pipeline_data(window);
+		}
+
+		/** Returns whether the brush is ready to draw on the given window, without waiting for it to be so.
+		 * @throws std::runtime_error if the brush's pipeline could not be created.
+		 * @see vulkan_brush::prepare
+		 */
+		auto pipeline_ready(vulkan_window& window) const -> bool
+		{
+			return get_pipeline_data(window).pipeline_ready();
+		}
+
+		/** Waits until the brush is ready to draw on the given window.
+		 * @throws std::runtime_error if the brush's pipeline could not be created.
+		 * @see vulkan_brush::prepare
+		 */
+		void wait_for_pipeline(vulkan_window& window) const
+		{
+			get_pipeline_data(window).wait_for_pipeline();
+		}
 
 	public: // constructors
 		/** Constructs an invalid [[vulkan_brush]].
@@ -142,6 +260,10 @@ namespace compwolf::vulkan
 			: super(input_shader, pixel_shader)
 			, _internal(super::gpu(), _internal_info)
 		{
+			static_assert(push_field_layout_val().back() <= max_push_fields_size,
+				"The brush's push fields take up more space than is guaranteed to be supported; consider making some of them normal fields");
+			static_assert(std::ranges::none_of(super::field_types::template transform_to_value<internal::is_storage_field, std::vector<bool>>(), std::identity{}),
+				"Brushes do not support storage fields; these are for compute shaders");
 		}
 	};
 }
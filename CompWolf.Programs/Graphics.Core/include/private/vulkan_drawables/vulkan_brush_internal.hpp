@@ -8,6 +8,8 @@
 #include <utility>
 #include <cstdint>
 #include <vector>
+#include <future>
+#include <chrono>
 #include <vulkan_windows>
 
 namespace compwolf::vulkan::internal
@@ -22,13 +24,46 @@ namespace compwolf::vulkan::internal
 		const std::vector<std::size_t>* field_indices;
 		std::vector<bool> field_is_input_field;
 		std::vector<bool> field_is_pixel_field;
+
+		std::vector<bool> field_is_push_field;
+		std::vector<std::size_t> field_sizes;
+		/** The offset of each push field in a drawable's slot of [[vulkan_draw_fields]], followed by the size of all of the push fields.
+		 * The offset of a field that is not a push field is meaningless.
+		 */
+		std::vector<std::size_t> field_push_offsets;
 	};
 
+	/** Lays out push fields after each other, as described by [[shader_push_field]].
+	 * @return The offset of each push field, followed by the size of all of the push fields.
+	 * @hidden
+	 */
+	constexpr auto vulkan_push_field_layout(const std::vector<bool>& field_is_push_field
+		, const std::vector<std::size_t>& field_sizes
+		, const std::vector<std::size_t>& field_alignments
+	) -> std::vector<std::size_t>
+	{
+		std::vector<std::size_t> layout(field_sizes.size() + 1, 0);
+		std::size_t offset = 0;
+		for (std::size_t i = 0; i < field_sizes.size(); ++i)
+		{
+			if (!field_is_push_field[i]) continue;
+
+			auto alignment = field_alignments[i];
+			offset = (offset + alignment - 1) / alignment * alignment;
+			layout[i] = offset;
+			offset += field_sizes[i];
+		}
+		layout.back() = offset;
+		return layout;
+	}
+
 	/** @hidden */
 	class vulkan_brush_internal
 	{
 	public:
 		unique_deleter_ptr<vulkan_handle::descriptor_set_layout_t> vulkan_descriptor_set_layout{};
+		/** The layout of set 1, through which the shaders read the push fields; see [[vulkan_draw_fields]]. */
+		unique_deleter_ptr<vulkan_handle::descriptor_set_layout_t> vulkan_draw_fields_layout{};
 		unique_deleter_ptr<vulkan_handle::pipeline_layout_t> vulkan_pipeline_layout{};
 
 	public: // constructors
@@ -46,7 +81,70 @@ namespace compwolf::vulkan::internal
 		);
 	};
 
-	/** Brushes actually have to be made per window.
+	/** A pipeline created by [[vulkan_brush_pipeline]], and how long it took to create.
+	 * @hidden
+	 */
+	struct vulkan_brush_pipeline_result
+	{
+		unique_deleter_ptr<vulkan_handle::pipeline_t> vulkan_pipeline;
+		std::chrono::nanoseconds creation_time;
+	};
+
+	/** A brush's pipeline for drawing on images of a specific format.
+	 * This is shared by all windows on the gpu with that format.
+	 * @hidden
+	 */
+	class vulkan_brush_pipeline
+	{
+	public:
+		vulkan_gpu_connection* gpu{};
+
+		/** Null until the pipeline has been created; see [[vulkan_brush_pipeline::pipeline_ready]]. */
+		unique_deleter_ptr<vulkan_handle::pipeline_t> vulkan_pipeline{};
+
+	private:
+		/** The pipeline while it is being created on another thread.
+		 * This is declared last, so that it is destructed first, waiting for the other thread to stop using the rest of the brush.
+		 */
+		std::future<vulkan_brush_pipeline_result> pipeline_creation{};
+
+	public: // accessors
+		/** Returns whether the pipeline has been created, without waiting for it to be so.
+		 * @throws std::runtime_error if the pipeline could not be created.
+		 */
+		auto pipeline_ready() -> bool;
+
+	public: // modifiers
+		/** Waits until the pipeline has been created.
+		 * @throws std::runtime_error if the pipeline could not be created.
+		 */
+		void wait_for_pipeline();
+
+	private:
+		/** Moves the created pipeline out of pipeline_creation. */
+		void take_pipeline();
+
+	public: // constructors
+		/** Constructs an invalid [[vulkan_brush_pipeline]].
+		 * Using this is undefined behaviour.
+		 * @overload
+		 */
+		vulkan_brush_pipeline() = default;
+		vulkan_brush_pipeline(vulkan_brush_pipeline&&) = default;
+		auto operator=(vulkan_brush_pipeline&&) -> vulkan_brush_pipeline& = default;
+
+		/** Starts creating a pipeline for the given render pass on another thread.
+		 * The pipeline may not be drawn with before [[vulkan_brush_pipeline::pipeline_ready]] returns true.
+		 * @param render_pass The render pass to draw with, or null to use dynamic rendering.
+		 * @param image_format The format of the images to draw on.
+		 */
+		vulkan_brush_pipeline(vulkan_gpu_connection& gpu, vulkan_handle::render_pass render_pass, vulkan_handle::format image_format
+			, const vulkan_brush_info& info, vulkan_handle::shader input_shader, vulkan_handle::shader pixel_shader
+			, vulkan_handle::pipeline_layout
+		);
+	};
+
+	/** The data of a brush that has to be made per window.
 	 * @hidden
 	 */
 	class vulkan_window_brush
@@ -56,9 +154,6 @@ namespace compwolf::vulkan::internal
 		/** Descriptor sets do not need to be cleaned up explicitly; they are cleaned up when the pool is cleaned up. */
 		std::vector<vulkan_handle::descriptor_set> vulkan_descriptor_set{};
 
-		unique_deleter_ptr<vulkan_handle::pipeline_t> vulkan_pipeline{};
-		std::vector<unique_deleter_ptr<vulkan_handle::frame_buffer_t>> vulkan_frame_buffer{};
-
 	public: // constructors
 		/** Constructs an invalid [[vulkan_window_brush]].
 		 * Using this brush is undefined behaviour.
@@ -68,11 +163,8 @@ namespace compwolf::vulkan::internal
 		vulkan_window_brush(vulkan_window_brush&&) = default;
 		auto operator=(vulkan_window_brush&&) -> vulkan_window_brush& = default;
 
-		/** Creates a brush for the given window. */
-		vulkan_window_brush(vulkan_window& window
-			, vulkan_brush_info& info, vulkan_handle::shader input_shader, vulkan_handle::shader pixel_shader
-			, vulkan_handle::descriptor_set_layout, vulkan_handle::pipeline_layout
-		);
+		/** Creates a brush's descriptor sets for the given window. */
+		vulkan_window_brush(vulkan_window& window, vulkan_handle::descriptor_set_layout);
 	};
 }
 
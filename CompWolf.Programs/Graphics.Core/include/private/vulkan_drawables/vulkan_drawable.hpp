@@ -8,6 +8,7 @@
 #include <vulkan_gpu_buffers>
 #include <array>
 #include <span>
+#include <optional>
 
 namespace compwolf::vulkan
 {
@@ -24,8 +25,10 @@ namespace compwolf::vulkan
 			, vulkan_handle::buffer vertex_buffer
 			, vulkan_handle::buffer vertex_index_buffer
 			, const vulkan_handle::buffer* field_buffers_data
-			, const std::vector<std::size_t>& field_indices
+			, const void* const* field_push_data
+			, const vulkan_brush_info&
 			, const std::vector<vulkan_handle::descriptor_set>&
+			, const draw_bounds* bounds
 		);
 	}
 
@@ -44,6 +47,7 @@ namespace compwolf::vulkan
 
 		std::array<vulkan_handle::memory, super::field_buffer_types::size> _field_memories;
 		std::array<vulkan_handle::buffer, super::field_buffer_types::size> _field_buffer;
+		std::array<const void*, super::field_buffer_types::size> _field_push_data;
 
 		template <std::size_t Step>
 		constexpr void setup_field_data()
@@ -53,6 +57,7 @@ namespace compwolf::vulkan
 				auto& field = std::get<Step>(super::field_buffers());
 				_field_memories[Step] = field->vulkan_memory();
 				_field_buffer[Step] = field->vulkan_buffer();
+				_field_push_data[Step] = field->vulkan_push_data();
 				setup_field_data<Step + 1>();
 			}
 		}
@@ -72,20 +77,42 @@ namespace compwolf::vulkan
 			return std::span<const vulkan_handle::buffer, super::field_buffer_types::size>
 				(_field_buffer.data(), _field_buffer.size());
 		}
+		/** Returns the cpu-memory of the drawable's push fields; the elements for fields that are not push fields are nullptr. */
+		auto vulkan_field_push_data() const noexcept
+			-> std::span<const void* const, super::field_buffer_types::size>
+		{
+			return std::span<const void* const, super::field_buffer_types::size>
+				(_field_push_data.data(), _field_push_data.size());
+		}
 
 	public: //
-		/** The gpu-instructions used to draw this. */
+		/** The gpu-instructions used to draw this.
+		 * Nothing is drawn while the brush is still being prepared for the camera's window; see [[vulkan_brush::prepare]].
+		 * The camera then records its instructions again on the next frame, so that the drawable is drawn once the brush is ready.
+		 */
 		void draw_program_code(const vulkan_draw_code_parameters& args)
 		{
+			auto pipeline = super::brush().vulkan_pipeline(super::camera().window());
+			if (!pipeline)
+			{
+				*args.record_again = true;
+				return;
+			}
+
+			std::optional<draw_bounds> bounds;
+			if (args.culling) bounds = super::bounds();
+
 			internal::drawable_draw_code(args
-				, super::brush().vulkan_pipeline(super::camera().window())
+				, pipeline
 				, super::brush().vulkan_pipeline_layout()
 				, static_cast<shader_int>(super::vertex_index_buffer().size())
 				, super::vertex_buffer().vulkan_buffer()
 				, super::vertex_index_buffer().vulkan_buffer()
 				, vulkan_field_buffers().data()
-				, super::brush().field_positions()
+				, vulkan_field_push_data().data()
+				, super::brush().vulkan_field_info()
 				, super::brush().vulkan_descriptor_set(super::camera().window())
+				, bounds ? &*bounds : nullptr
 			);
 		}
 
@@ -106,8 +133,11 @@ namespace compwolf::vulkan
 			, super::field_buffer_ptr_tuple field_ptrs)
 			: super(camera, brush, vertex_data, vertex_index_data, field_ptrs)
 		{
+			brush.prepare(camera.window());
+
 			_draw_key = camera.add_draw_code(
-				[this](const vulkan_draw_code_parameters& args) { draw_program_code(args); }
+				[this](const vulkan_draw_code_parameters& args) { draw_program_code(args); },
+				[this]() { return super::bounds(); }
 			);
 
 			setup_field_data<0>();
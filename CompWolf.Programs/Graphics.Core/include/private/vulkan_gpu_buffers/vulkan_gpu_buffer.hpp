@@ -32,7 +32,7 @@ namespace compwolf::vulkan
 				[this](super::access_type* accessor)
 				{
 					auto& buffer = *static_cast<vulkan_gpu_buffer*>(accessor->buffer_ptr());
-					internal::vulkan_gpu_buffer_internal::free_data(super::gpu(), buffer.vulkan_memory());
+					buffer._internal.end_access(super::gpu());
 				}
 			);
 		}
@@ -49,6 +49,11 @@ namespace compwolf::vulkan
 		/** Returns the [[vulkan_handle::buffer]] that the buffer represents. */
 		auto vulkan_buffer() const noexcept -> vulkan_handle::buffer { return _internal.vulkan_buffer.get(); }
 
+		/** Returns the cpu-memory containing the buffer's data, if it is a [[gpu_buffer_usage::push_field]]-buffer.
+		 * Returns nullptr for other types of buffers, as their data is not kept on the cpu.
+		 */
+		auto vulkan_push_data() const noexcept -> const void* { return _internal.push_data.get(); }
+
 	public: // constructors
 		/** Constructs an invalid [[vulkan_gpu_buffer]].
 		 * Using this buffer is undefined behaviour.
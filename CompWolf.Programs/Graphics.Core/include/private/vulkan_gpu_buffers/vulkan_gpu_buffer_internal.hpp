@@ -5,6 +5,9 @@
 #include <gpu_buffers>
 #include <unique_deleter_ptr>
 #include <utility>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
 
 namespace compwolf::vulkan::internal
 {
@@ -14,6 +17,12 @@ namespace compwolf::vulkan::internal
 	public:
 		unique_deleter_ptr<vulkan_handle::buffer_t> vulkan_buffer{};
 		unique_deleter_ptr<vulkan_handle::memory_t> vulkan_memory{};
+		/** The data of a [[gpu_buffer_usage::push_field]]-buffer, which is kept on the cpu instead of in vulkan_memory. */
+		std::unique_ptr<std::byte[]> push_data{};
+		/** A copy of push_data from when the cpu started accessing it, to know whether the access changed it. */
+		std::unique_ptr<std::byte[]> accessed_push_data{};
+		/** The amount of accesses to push_data that have not ended yet. */
+		std::size_t push_data_accesses{};
 
 		/** The size of a single element in the buffer, in bytes. */
 		std::size_t stride{};
@@ -23,8 +32,14 @@ namespace compwolf::vulkan::internal
 	public: // accessors
 		/** Returns cpu-access to the buffer's data. */
 		auto get_data(vulkan_gpu_connection&) -> void*;
-		/** Ends cpu-access to the buffer's data. */
+		/** Ends cpu-access to the buffer's data.
+		 * The given memory may be nullptr, for buffers without memory on the gpu.
+		 */
 		static void free_data(vulkan_gpu_connection&, vulkan_handle::memory) noexcept;
+		/** Ends cpu-access to the buffer's data, given by get_data.
+		 * For a [[gpu_buffer_usage::push_field]]-buffer, the gpu is told if the last access changed the data; see [[vulkan_gpu_connection::push_data_changes]].
+		 */
+		void end_access(vulkan_gpu_connection&) noexcept;
 
 	public: // constructors
 		/** Constructs an invalid [[vulkan_gpu_buffer_internal]].
@@ -40,6 +55,14 @@ namespace compwolf::vulkan::internal
 			, gpu_buffer_usage usage_type
 			, std::size_t stride, std::size_t size
 		);
+		/** Creates a buffer on the given gpu, with the given VkBufferUsageFlags.
+		 * This is for buffers not described by [[gpu_buffer_usage]], like those only used by the library itself.
+		 * If the flags are 0, the buffer is kept on the cpu instead, like a [[gpu_buffer_usage::push_field]]-buffer.
+		 */
+		vulkan_gpu_buffer_internal(vulkan_gpu_connection& gpu
+			, uint32_t vulkan_usage
+			, std::size_t stride, std::size_t size
+		);
 	};
 }
 
@@ -0,0 +1,122 @@
+#ifndef COMPWOLF_GRAPHICS_VULKAN_UPLOAD_ENGINE
+#define COMPWOLF_GRAPHICS_VULKAN_UPLOAD_ENGINE
+
+#include <vulkan_graphics_environments>
+#include <vulkan_programs>
+#include "vulkan_gpu_buffer.hpp"
+#include "vulkan_gpu_buffer_internal.hpp"
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace compwolf::vulkan
+{
+	/** Writes data to [[vulkan_gpu_buffer]]s on the gpu, through a queue made for copying data where the gpu has one.
+	 * Instead of writing to a buffer that the gpu may be reading, the data is first written to a "staging" buffer;
+	 * the gpu then copies it to the actual buffer, ordered with the rest of the gpu's work, so large uploads can happen while the gpu is drawing.
+	 *
+	 * Uploads are gathered until submit() is called, generally once per frame, which copies all of them with a single set of gpu-instructions.
+	 * Work reading the buffers must wait for the returned fence with [[vulkan_gpu_program_manager::wait_for]];
+	 * likewise, the copies do not wait for other work that may still be reading the buffers, such as drawing on another queue, so the caller must give the fences of that work to wait_for() before submit() is called.
+	 *
+	 * The engine cannot be moved, as its programs refer to its manager.
+	 */
+	class vulkan_upload_engine
+	{
+		/** A staging buffer, which upload() writes to directly; it stays mapped until submit() is called. */
+		struct staging_chunk
+		{
+			internal::vulkan_gpu_buffer_internal buffer;
+			std::byte* data;
+			std::size_t used;
+		};
+		/** A copy that submit() must do. */
+		struct pending_copy
+		{
+			vulkan_handle::buffer source;
+			vulkan_handle::buffer target;
+			std::size_t source_offset;
+			std::size_t target_offset;
+			std::size_t size;
+		};
+
+		vulkan_gpu_program_manager _manager;
+		std::vector<staging_chunk> _chunks;
+		std::vector<pending_copy> _copies;
+		std::size_t _pending_bytes{};
+		/** The programs used by earlier calls to submit(); one whose work is done is reused, instead of creating a new one.
+		 * They are kept behind pointers, as a program cannot be moved while its manager refers to it.
+		 */
+		std::vector<std::unique_ptr<vulkan_gpu_program>> _programs;
+
+	public: // accessors
+		/** The minimum size, in bytes, of the staging buffers; smaller uploads share a staging buffer. */
+		static constexpr std::size_t min_staging_size = 1 << 16;
+
+		/** Returns the manager that the copies are made on. */
+		auto manager() noexcept -> vulkan_gpu_program_manager& { return _manager; }
+		/** Returns the manager that the copies are made on. */
+		auto manager() const noexcept -> const vulkan_gpu_program_manager& { return _manager; }
+
+		/** Returns the gpu that the engine uploads to. */
+		auto gpu() noexcept -> vulkan_gpu_connection& { return _manager.gpu(); }
+		/** Returns the gpu that the engine uploads to. */
+		auto gpu() const noexcept -> const vulkan_gpu_connection& { return _manager.gpu(); }
+
+		/** Returns the amount of bytes that are waiting for submit(). */
+		auto pending_bytes() const noexcept -> std::size_t { return _pending_bytes; }
+		/** Returns the amount of copies that are waiting for submit(). */
+		auto pending_copy_count() const noexcept -> std::size_t { return _copies.size(); }
+
+	public: // modifiers
+		/** Writes the given values to the given buffer, starting at the element at the given index, once submit() is called.
+		 * The values are copied right away, so they may be changed after this returns.
+		 * @throws std::out_of_range if the values do not fit in the buffer.
+		 * @throws std::runtime_error if there was an error creating a staging buffer due to causes outside of the program.
+		 */
+		template <gpu_buffer_usage UsageType, typename ValueType>
+		void upload(vulkan_gpu_buffer<UsageType, ValueType>& target, std::span<const ValueType> values, std::size_t first_index = 0)
+		{
+			static_assert(UsageType != gpu_buffer_usage::push_field,
+				"Push fields are kept on the cpu, so they are written to directly instead of uploaded");
+
+			if (first_index > target.size() || values.size() > target.size() - first_index)
+				throw std::out_of_range("Could not upload data to a buffer on the GPU; the data does not fit in the buffer.");
+
+			upload_bytes(target.vulkan_buffer(), values.data(), values.size_bytes(), first_index * sizeof(ValueType));
+		}
+
+		/** Gives all of the uploads since the last call to the gpu, as a single set of gpu-instructions.
+		 * @return a fence denoting when the uploads are done; if there were none, one denoting when the earlier uploads are.
+		 * @throws std::runtime_error if there was an error submitting the copies to the gpu due to causes outside of the program.
+		 */
+		auto submit() -> vulkan_gpu_fence;
+
+		/** Makes the copies of the next call to submit() wait until the given fence's work is done on the gpu.
+		 * This must be given the fence of any work that may still be reading the buffers being uploaded to, as the copies would otherwise overwrite the data while it is read.
+		 */
+		void wait_for(const vulkan_gpu_fence& reader) { _manager.wait_for(reader); }
+
+	public: // vulkan-specific
+		/** Writes the given bytes to the given [[vulkan_handle::buffer]], at the given offset in bytes, once submit() is called.
+		 * The buffer must have been created with VK_BUFFER_USAGE_TRANSFER_DST_BIT.
+		 * @throws std::runtime_error if there was an error creating a staging buffer due to causes outside of the program.
+		 */
+		void upload_bytes(vulkan_handle::buffer target, const void* data, std::size_t size, std::size_t offset);
+
+	public: // constructors
+		vulkan_upload_engine(const vulkan_upload_engine&) = delete;
+		auto operator=(const vulkan_upload_engine&) -> vulkan_upload_engine& = delete;
+
+		/** Creates an engine uploading to the given gpu.
+		 * It prefers a queue that can only do [[gpu_work_type::transfer]] work, so that its copies do not wait on drawing.
+		 * @throws std::runtime_error if there was an error during creation of the engine due to causes outside of the program.
+		 */
+		explicit vulkan_upload_engine(vulkan_gpu_connection&);
+		~vulkan_upload_engine() noexcept;
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_VULKAN_UPLOAD_ENGINE
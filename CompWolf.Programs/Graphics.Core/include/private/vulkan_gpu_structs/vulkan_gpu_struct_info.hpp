@@ -3,6 +3,9 @@
 
 #include <vulkan_graphics_environments>
 #include <gpu_structs>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
 
 namespace compwolf::vulkan
 {
@@ -39,6 +42,28 @@ namespace compwolf::vulkan
 	/** @hidden */ COMPWOLF_GRAPHICS_VULKAN_DEFINE_SIMPLE_GPU_PRIMITIVE(shader_int2, 102);
 	/** @hidden */ COMPWOLF_GRAPHICS_VULKAN_DEFINE_SIMPLE_GPU_PRIMITIVE(shader_int3, 105);
 	/** @hidden */ COMPWOLF_GRAPHICS_VULKAN_DEFINE_SIMPLE_GPU_PRIMITIVE(shader_int4, 108);
+
+	namespace internal
+	{
+		/** @hidden */
+		template <typename PrimitiveList>
+		struct vulkan_primitives_alignment;
+		/** @hidden */
+		template <typename... PrimitivePairs>
+		struct vulkan_primitives_alignment<type_list<PrimitivePairs...>>
+		{
+			// std430: scalars and 2-vectors are aligned to their size; 3- and 4-vectors are aligned as 4-vectors.
+			static constexpr std::size_t value = std::max({ std::bit_ceil(sizeof(typename PrimitivePairs::type))... });
+		};
+	}
+
+	/** Gets the alignment of the given type on the gpu, as described by the std430-layout. */
+	template <typename T>
+	struct get_vulkan_alignment
+	{
+		/** The alignment, in bytes. */
+		static constexpr std::size_t value = internal::vulkan_primitives_alignment<typename gpu_struct_info<T>::primitives>::value;
+	};
 }
 
 #endif // ! COMPWOLF_GRAPHICS_VULKAN_GPU_STRUCT_INFO
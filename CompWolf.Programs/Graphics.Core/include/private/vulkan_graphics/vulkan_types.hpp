@@ -9,6 +9,7 @@
 #include <vulkan_shaders>
 #include <vulkan_programs>
 #include <vulkan_drawables>
+#include <vulkan_compute_programs>
 
 namespace compwolf
 {
@@ -35,9 +36,20 @@ namespace compwolf
 		 */
 		template <typename InputType, typename OutputType, typename... FieldTypes>
 		using shader = vulkan::vulkan_shader<InputType, OutputType, FieldTypes...>;
+		/**
+		 * @typeparam FieldTypes The fields that the shader has.
+		 * These must be [[type_value_pair]]s, denoting the type and position of the fields.
+		 */
+		template <typename... FieldTypes>
+		using compute_shader = vulkan::vulkan_compute_shader<FieldTypes...>;
 
 		using fence = vulkan::vulkan_gpu_fence;
 		using program = vulkan::vulkan_gpu_program;
+		/**
+		 * @typeparam ShaderType The type of compute shader that the program runs.
+		 */
+		template <typename ShaderType>
+		using compute_program = vulkan::vulkan_compute_program<ShaderType>;
 
 		/**
 		 * @typeparam InputShaderType The type of vertex shader used by the brush.
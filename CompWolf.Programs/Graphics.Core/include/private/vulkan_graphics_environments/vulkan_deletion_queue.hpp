@@ -0,0 +1,103 @@
+#ifndef COMPWOLF_VULKAN_DELETION_QUEUE
+#define COMPWOLF_VULKAN_DELETION_QUEUE
+
+#include <unique_deleter_ptr>
+#include "vulkan_handle.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace compwolf::vulkan
+{
+	/** Aggregate type containing a timeline semaphore that some gpu-work signals, as tracked by [[vulkan_deletion_queue]].
+	 * @see vulkan_object_pool::new_timeline
+	 */
+	struct vulkan_tracked_timeline
+	{
+		/** The timeline semaphore, representing a VkSemaphore; it is destroyed together with this. */
+		unique_deleter_ptr<vulkan_handle::semaphore_t> semaphore;
+		/** The value that the semaphore is signaled with by the latest work given to the gpu. */
+		std::atomic<uint64_t> submitted_value;
+	};
+
+	/** Destroys a gpu's vulkan-objects once the gpu is done with them, instead of waiting for the whole gpu to be idle.
+	 * When something is to be destroyed, the queue notes how far each of the gpu's timelines has been given work;
+	 * as work given later cannot use the object, it is destroyed once the gpu is done with that work.
+	 * Objects are destroyed in the order that they were given to the queue, so an object may depend on one given after it, like a command buffer on its pool.
+	 *
+	 * The queue never waits for the gpu, except when it is destroyed; the destruction happens in collect().
+	 * @see vulkan_gpu_connection::deletion_queue
+	 */
+	class vulkan_deletion_queue
+	{
+		/** Something to destroy, and what work must be done before it can be. */
+		struct pending_deletion
+		{
+			std::vector<std::pair<std::shared_ptr<vulkan_tracked_timeline>, uint64_t>> waits;
+			std::function<void()> deleter;
+		};
+
+		vulkan_handle::device _vulkan_device{};
+
+		mutable std::mutex _mutex;
+		std::vector<std::weak_ptr<vulkan_tracked_timeline>> _timelines;
+		std::deque<pending_deletion> _pending;
+
+	public: // accessors
+		/** Returns the amount of objects that are waiting for the gpu before they are destroyed. */
+		auto pending_count() const -> std::size_t
+		{
+			std::lock_guard lock(_mutex);
+			return _pending.size();
+		}
+
+	public: // modifiers
+		/** Makes the given timeline's work be waited on before destroying objects, for as long as the timeline exists.
+		 * The timeline's submitted_value must be increased before the gpu is given work signaling the new value.
+		 * Timelines are generally gotten from [[vulkan_object_pool::new_timeline]], which calls this.
+		 */
+		void track_timeline(std::shared_ptr<vulkan_tracked_timeline>);
+
+		/** Calls the given function once the gpu is done with all work given to it so far.
+		 * The function should destroy some vulkan-objects; it may be called right away, or in a later call to collect().
+		 * This does not wait for the gpu.
+		 */
+		void defer(std::function<void()> deleter) noexcept;
+
+		/** Destroys the objects that the gpu is done with.
+		 * This does not wait for the gpu, and should be called regularly, like by [[vulkan_graphics_environment::update]].
+		 */
+		void collect() noexcept;
+
+		/** Waits for the gpu to be idle, and then destroys all of the objects. */
+		void flush() noexcept;
+
+	public: // constructors
+		/** Constructs an invalid [[vulkan_deletion_queue]].
+		 * Using this is undefined behaviour.
+		 * @overload
+		 */
+		vulkan_deletion_queue() noexcept = default;
+		vulkan_deletion_queue(const vulkan_deletion_queue&) = delete;
+		auto operator=(const vulkan_deletion_queue&) -> vulkan_deletion_queue& = delete;
+
+		/** Should be called by [[vulkan_gpu_connection]].
+		 * Constructs a queue for destroying objects of the given device.
+		 */
+		explicit vulkan_deletion_queue(vulkan_handle::device) noexcept;
+		/** Destroys all of the objects, after waiting for the gpu to be idle. */
+		~vulkan_deletion_queue() noexcept;
+
+	private:
+		/** Returns whether the gpu has signaled the given timeline with at least the given value. */
+		auto reached(const vulkan_tracked_timeline&, uint64_t value) const noexcept -> bool;
+	};
+}
+
+#endif // ! COMPWOLF_VULKAN_DELETION_QUEUE
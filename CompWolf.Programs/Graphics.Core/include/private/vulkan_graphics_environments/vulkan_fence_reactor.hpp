@@ -0,0 +1,98 @@
+#ifndef COMPWOLF_VULKAN_FENCE_REACTOR
+#define COMPWOLF_VULKAN_FENCE_REACTOR
+
+#include "vulkan_handle.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace compwolf::vulkan
+{
+	/** Aggregate type containing information about the latest call to [[vulkan_fence_reactor::poll]].
+	 * @see vulkan_fence_reactor
+	 */
+	struct vulkan_fence_reactor_stats
+	{
+		/** The amount of timeline semaphores whose values were queried; this is one for each timeline with functions waiting on it. */
+		std::size_t queries;
+		/** The amount of functions that were called. */
+		std::size_t callbacks;
+		/** The amount of functions still waiting for the gpu afterwards. */
+		std::size_t pending;
+	};
+
+	/** Calls functions once the gpu has done some work, without any thread waiting for it; for example to resume coroutines awaiting a [[vulkan_gpu_fence]].
+	 * The work is denoted by a timeline semaphore reaching a value, like a [[vulkan_gpu_fence]].
+	 * The reactor never waits for the gpu unless asked to; instead it checks the work in poll(), which [[vulkan_graphics_environment::update]] calls.
+	 *
+	 * The functions are kept by the timeline they wait on, ordered by value;
+	 * a poll therefore queries each timeline once, and calls all of its functions whose work is done together, no matter how many there are.
+	 * @see vulkan_gpu_connection::fence_reactor
+	 */
+	class vulkan_fence_reactor
+	{
+		vulkan_handle::device _vulkan_device{};
+
+		mutable std::mutex _mutex;
+		/** The functions to call, by the timeline they wait on and the value they wait for. */
+		std::map<vulkan_handle::semaphore, std::multimap<uint64_t, std::function<void()>>> _pending;
+		std::size_t _pending_count{};
+		vulkan_fence_reactor_stats _stats{};
+
+	public: // accessors
+		/** Returns the amount of functions waiting for the gpu. */
+		auto pending_count() const -> std::size_t
+		{
+			std::lock_guard lock(_mutex);
+			return _pending_count;
+		}
+
+		/** Returns information about the latest call to poll(). */
+		auto stats() const -> vulkan_fence_reactor_stats
+		{
+			std::lock_guard lock(_mutex);
+			return _stats;
+		}
+
+	public: // modifiers
+		/** Calls the given function, in a later call to poll(), once the given timeline semaphore has reached the given value.
+		 * The semaphore must stay alive until the function is called.
+		 */
+		void when_reached(vulkan_handle::semaphore timeline, uint64_t value, std::function<void()> callback);
+
+		/** Calls the functions whose work is done.
+		 * This does not wait for the gpu, and should be called regularly, like by [[vulkan_graphics_environment::update]].
+		 * The functions are called on the calling thread, and may give the reactor new functions; those are not called before the next poll().
+		 * @return The amount of functions called.
+		 * @throws any exception thrown by the functions; the functions that were not called yet are then called by the next poll().
+		 */
+		auto poll() -> std::size_t;
+
+		/** Waits until the work of any of the functions is done, or until the given time has passed, and then calls the functions whose work is done.
+		 * All of the timelines are waited on together, with a single vkWaitSemaphores.
+		 * @return The amount of functions called; 0 if the time passed first, or no functions are waiting.
+		 * @throws any exception thrown by the functions; see poll().
+		 */
+		auto wait_any(std::chrono::nanoseconds timeout) -> std::size_t;
+
+	public: // constructors
+		/** Constructs an invalid [[vulkan_fence_reactor]].
+		 * Using this is undefined behaviour.
+		 * @overload
+		 */
+		vulkan_fence_reactor() noexcept = default;
+		vulkan_fence_reactor(const vulkan_fence_reactor&) = delete;
+		auto operator=(const vulkan_fence_reactor&) -> vulkan_fence_reactor& = delete;
+
+		/** Should be called by [[vulkan_gpu_connection]].
+		 * Constructs a reactor for work on the given device.
+		 */
+		explicit vulkan_fence_reactor(vulkan_handle::device) noexcept;
+	};
+}
+
+#endif // ! COMPWOLF_VULKAN_FENCE_REACTOR
@@ -5,7 +5,16 @@
 #include <unique_deleter_ptr>
 #include "vulkan_handle.hpp"
 #include "vulkan_gpu_thread_family.hpp"
+#include "vulkan_pipeline_cache.hpp"
+#include "vulkan_deletion_queue.hpp"
+#include "vulkan_fence_reactor.hpp"
+#include "vulkan_object_pool.hpp"
+#include "vulkan_graphics_environment_settings.hpp"
 #include <vector>
+#include <map>
+#include <memory>
+#include <utility>
+#include <cstddef>
 
 namespace compwolf::vulkan
 {
@@ -22,6 +31,21 @@ namespace compwolf::vulkan
 		vulkan_handle::physical_device _vulkan_physical_device{};
 		unique_deleter_ptr<vulkan_handle::device_t> _vulkan_device{};
 
+		bool _supports_draw_indirect_count{};
+		std::size_t _max_draw_indirect_count{};
+		bool _supports_draw_indirect_first_instance{};
+		bool _uses_dynamic_rendering{};
+		std::size_t _push_data_changes{};
+
+		vulkan_pipeline_cache _pipeline_cache{};
+		std::map<std::pair<vulkan_handle::format, bool>, unique_deleter_ptr<vulkan_handle::render_pass_t>> _render_passes{};
+
+		std::unique_ptr<vulkan_fence_reactor> _fence_reactor{};
+		/* Declared before the deletion queue, as the objects that the queue destroys may be given back to the pool. */
+		std::unique_ptr<vulkan_object_pool> _object_pool{};
+		/* Declared last so that the objects in it are destroyed before the device. */
+		std::unique_ptr<vulkan_deletion_queue> _deletion_queue{};
+
 	public: // constructors
 		/** Constructs an invalid [[vulkan_gpu_connection]].
 		 * Using this is undefined behaviour.
@@ -36,7 +60,7 @@ namespace compwolf::vulkan
 		 * @throws std::runtime_error if there was an error during setup due to causes outside of the program.
 		 * @see gpu_connection
 		 */
-		vulkan_gpu_connection(vulkan_graphics_environment&, vulkan_handle::physical_device);
+		vulkan_gpu_connection(vulkan_graphics_environment&, vulkan_handle::physical_device, const vulkan_graphics_environment_settings&);
 
 	public: // vulkan-specific
 		/** Returns the GPU's threads.
@@ -52,6 +76,11 @@ namespace compwolf::vulkan
 			return _thread_families;
 		}
 
+		/** Returns how much of the work given to the given thread on the GPU is not done yet, as in the amount of submissions.
+		 * This does not wait for the GPU.
+		 */
+		auto outstanding_work(const vulkan_gpu_thread&) const noexcept -> uint64_t;
+
 		/** Returns the [[vulkan_handle::instance]] that the GPU is on. */
 		auto vulkan_instance() const noexcept -> vulkan_handle::instance;
 		/** Returns the [[vulkan_handle::physical_device]] that the [[vulkan_gpu_connection]] represents. */
@@ -64,6 +93,82 @@ namespace compwolf::vulkan
 		{
 			return _vulkan_device.get();
 		}
+
+		/** Returns the cache shared by all pipelines created on the GPU.
+		 * @customoverload
+		 */
+		auto pipeline_cache() noexcept -> vulkan_pipeline_cache& { return _pipeline_cache; }
+		/** Returns the cache shared by all pipelines created on the GPU. */
+		auto pipeline_cache() const noexcept -> const vulkan_pipeline_cache& { return _pipeline_cache; }
+
+		/** Returns the queue that the GPU's vulkan-objects are given to when they are to be destroyed, so that they are destroyed once the GPU is done with them.
+		 * @customoverload
+		 */
+		auto deletion_queue() noexcept -> vulkan_deletion_queue& { return *_deletion_queue; }
+		/** Returns the queue that the GPU's vulkan-objects are given to when they are to be destroyed, so that they are destroyed once the GPU is done with them. */
+		auto deletion_queue() const noexcept -> const vulkan_deletion_queue& { return *_deletion_queue; }
+
+		/** Returns the pool of the GPU's reusable objects, like semaphores and command buffers.
+		 * @customoverload
+		 */
+		auto object_pool() noexcept -> vulkan_object_pool& { return *_object_pool; }
+		/** Returns the pool of the GPU's reusable objects, like semaphores and command buffers. */
+		auto object_pool() const noexcept -> const vulkan_object_pool& { return *_object_pool; }
+
+		/** Returns the reactor calling functions once the GPU has done some work, such as resuming coroutines awaiting a [[vulkan_gpu_fence]].
+		 * @customoverload
+		 */
+		auto fence_reactor() noexcept -> vulkan_fence_reactor& { return *_fence_reactor; }
+		/** Returns the reactor calling functions once the GPU has done some work, such as resuming coroutines awaiting a [[vulkan_gpu_fence]]. */
+		auto fence_reactor() const noexcept -> const vulkan_fence_reactor& { return *_fence_reactor; }
+
+		/** Returns whether windows on the GPU are drawn on with dynamic rendering, as in vkCmdBeginRendering, instead of render passes and frame buffers.
+		 * @see vulkan_graphics_environment_settings::dynamic_rendering
+		 */
+		auto uses_dynamic_rendering() const noexcept -> bool
+		{
+			return _uses_dynamic_rendering;
+		}
+
+		/** Returns the [[vulkan_handle::render_pass]] used to draw on windows whose images have the given format, creating it if it does not already exist.
+		 * Windows with the same format share the render pass, so that pipelines made for one of them can be used by all of them.
+		 * @param format The VkFormat of the images drawn on.
+		 * @param offscreen Whether the images are drawn on by an [[offscreen_target]], and so are copied from instead of displayed afterwards.
+		 * Render passes that only differ in this can use the same pipelines.
+		 * @throws std::runtime_error if there was an error while creating the render pass due to causes outside of the program.
+		 */
+		auto vulkan_render_pass(vulkan_handle::format format, bool offscreen = false) -> vulkan_handle::render_pass;
+
+		/** Returns whether the GPU can draw using a count that is decided by the GPU itself, as in vkCmdDrawIndexedIndirectCount. */
+		auto supports_draw_indirect_count() const noexcept -> bool
+		{
+			return _supports_draw_indirect_count;
+		}
+		/** Returns the most draws that a single indirect draw, like vkCmdDrawIndexedIndirectCount, can do; 1 if the GPU cannot do several at once. */
+		auto max_draw_indirect_count() const noexcept -> std::size_t
+		{
+			return _max_draw_indirect_count;
+		}
+		/** Returns whether the commands of indirect draws, like vkCmdDrawIndexedIndirect, can have a first instance other than 0. */
+		auto supports_draw_indirect_first_instance() const noexcept -> bool
+		{
+			return _supports_draw_indirect_first_instance;
+		}
+
+		/** Returns how many times the data of a [[gpu_buffer_usage::push_field]]-buffer on the GPU has been changed.
+		 * Push fields are copied into gpu-instructions when these are recorded, so instructions recorded before a change must be recorded again; see [[vulkan_camera]].
+		 */
+		auto push_data_changes() const noexcept -> std::size_t
+		{
+			return _push_data_changes;
+		}
+		/** Should be called by [[vulkan_gpu_buffer]] when the data of one of its push fields has been changed.
+		 * @see vulkan_gpu_connection::push_data_changes
+		 */
+		void add_push_data_change() noexcept
+		{
+			++_push_data_changes;
+		}
 	};
 }
 
@@ -2,9 +2,14 @@
 #define COMPWOLF_VULKAN_GPU_THREAD
 
 #include "vulkan_handle.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
 
 namespace compwolf::vulkan
 {
+	struct vulkan_tracked_timeline;
+
 	/** Aggregate representing a thread on a GPU.
 	 * In Vulkan's termonology, specifically represents a queue.
 	 * @see vulkan_gpu_thread_family
@@ -18,6 +23,14 @@ namespace compwolf::vulkan
 
 		/** The amount of [[vulkan_gpu_program_manager]] currently on the thread. */
 		std::size_t program_manager_count;
+
+		/** The amount of work that has been given to the thread, as in submissions prepared by [[vulkan_gpu_program_manager::prepare_submission]]. */
+		std::size_t submission_count;
+		/** The timelines of the [[vulkan_gpu_program_manager]]s that are or have been on the thread.
+		 * These tell how much of the work given to the thread is not done yet.
+		 * @see vulkan_gpu_connection::outstanding_work
+		 */
+		std::vector<std::weak_ptr<vulkan_tracked_timeline>> timelines;
 	};
 }
 
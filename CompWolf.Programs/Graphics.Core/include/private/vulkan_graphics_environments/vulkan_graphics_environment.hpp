@@ -46,6 +46,15 @@ namespace compwolf::vulkan
 		 */
 		vulkan_graphics_environment(vulkan_graphics_environment_settings settings);
 
+	public: // accessors
+		/** Returns whether the environment is set up without anything for windows.
+		 * @see vulkan_graphics_environment_settings::headless
+		 */
+		auto headless() const noexcept -> bool
+		{
+			return _settings.headless;
+		}
+
 	public: // vulkan-specific
 		/** Returns the environment's [[vulkan_handle::instance]]. */
 		auto vulkan_instance() const noexcept -> vulkan_handle::instance
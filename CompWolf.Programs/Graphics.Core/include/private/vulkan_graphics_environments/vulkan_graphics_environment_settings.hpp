@@ -17,6 +17,27 @@ namespace compwolf::vulkan
 		 * This should generally be left empty.
 		 */
 		std::function<void(std::string_view)> internal_debug_callback;
+
+		/** When not empty, the gpus' compiled pipelines are saved to files in this directory, and loaded from them the next time the program runs.
+		 * This makes the program start faster, as shaders do not have to be compiled again.
+		 */
+		std::string pipeline_cache_directory;
+
+		/** When true, and a gpu supports it, windows on the gpu are drawn on with dynamic rendering instead of render passes and frame buffers.
+		 * This means that fewer objects have to be created for each window.
+		 */
+		bool dynamic_rendering{};
+
+		/** When true, the environment does not set up anything for windows, so that it can run on machines without a display.
+		 * [[vulkan_window]]s cannot be created in such an environment, but [[offscreen_target]]s can.
+		 */
+		bool headless{};
+
+		/** When true, and internal_debug_callback is not empty, the internal debugging also checks that the gpu's work is synchronized correctly.
+		 * Missing or wrong barriers between uses of buffers and images are then reported to internal_debug_callback, as messages containing "SYNC-HAZARD".
+		 * This makes the gpu's work a lot slower, so it should only be used while testing.
+		 */
+		bool synchronization_validation{};
 	};
 }
 
@@ -187,6 +187,15 @@ namespace compwolf::vulkan
 		/** Represents a VkFormat. */
 		using format = enum_type;
 
+		/** Represents a VkImageLayout. */
+		using image_layout = enum_type;
+
+		/** Represents a VkPipelineStageFlags2. */
+		using pipeline_stages = uint64_t;
+
+		/** Represents a VkAccessFlags2. */
+		using access_flags = uint64_t;
+
 
 		/** Dereference type of [[vulkan_handle::pipeline_layout]]
 		 * @see vulkan_handle::pipeline_layout
@@ -227,6 +236,22 @@ namespace compwolf::vulkan
 		struct pipeline_t;
 		/** Represents a VkPipeline-pointer */
 		using pipeline = pipeline_t*;
+
+		/** Dereference type of [[vulkan_handle::pipeline_cache]]
+		 * @see vulkan_handle::pipeline_cache
+		 * @hidden
+		 */
+		struct pipeline_cache_t;
+		/** Represents a VkPipelineCache-pointer */
+		using pipeline_cache = pipeline_cache_t*;
+
+		/** Dereference type of [[vulkan_handle::query_pool]]
+		 * @see vulkan_handle::query_pool
+		 * @hidden
+		 */
+		struct query_pool_t;
+		/** Represents a VkQueryPool-pointer */
+		using query_pool = query_pool_t*;
 	};
 }
 
@@ -0,0 +1,118 @@
+#ifndef COMPWOLF_VULKAN_OBJECT_POOL
+#define COMPWOLF_VULKAN_OBJECT_POOL
+
+#include <unique_deleter_ptr>
+#include "vulkan_handle.hpp"
+#include "vulkan_deletion_queue.hpp"
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace compwolf::vulkan
+{
+	/** Aggregate type containing how often a kind of object was taken from a [[vulkan_object_pool]] instead of created.
+	 * @see vulkan_object_pool_stats
+	 */
+	struct vulkan_object_pool_counter
+	{
+		/** The amount of objects that were reused. */
+		std::size_t reused;
+		/** The amount of objects that had to be created, as none were free. */
+		std::size_t created;
+
+		/** Returns the share of the objects that were reused, between 0 and 1; 0 if none have been asked for. */
+		auto hit_rate() const noexcept -> double
+		{
+			auto total = reused + created;
+			return total == 0 ? 0. : static_cast<double>(reused) / static_cast<double>(total);
+		}
+	};
+
+	/** Aggregate type containing how often the objects of a [[vulkan_object_pool]] were reused.
+	 * @see vulkan_object_pool::stats
+	 */
+	struct vulkan_object_pool_stats
+	{
+		/** Binary semaphores, as used by [[vulkan_gpu_semaphore]]. */
+		vulkan_object_pool_counter semaphores;
+		/** Timeline semaphores, as used by [[vulkan_gpu_program_manager]]s to know when their work is done. */
+		vulkan_object_pool_counter timelines;
+		/** Command buffers, as used by [[vulkan_gpu_program]]s. */
+		vulkan_object_pool_counter commands;
+	};
+
+	/** Reuses a gpu's synchronization objects and command buffers, instead of destroying them and creating new ones.
+	 * Objects are given back through the gpu's [[vulkan_deletion_queue]], so they are only reused once the gpu is done with them.
+	 * Free objects are only destroyed when the pool is, or for command buffers, when their command pool is.
+	 * @see vulkan_gpu_connection::object_pool
+	 */
+	class vulkan_object_pool
+	{
+		vulkan_handle::device _vulkan_device{};
+		vulkan_deletion_queue* _deletion_queue{};
+
+		mutable std::mutex _mutex;
+		std::vector<vulkan_handle::semaphore> _free_semaphores;
+		std::vector<vulkan_tracked_timeline*> _free_timelines;
+		std::map<vulkan_handle::command_pool, std::vector<vulkan_handle::command>> _free_commands;
+		vulkan_object_pool_stats _stats{};
+
+	public: // accessors
+		/** Returns how often the pool's objects were reused. */
+		auto stats() const -> vulkan_object_pool_stats
+		{
+			std::lock_guard lock(_mutex);
+			return _stats;
+		}
+
+	public: // modifiers
+		/** Returns a binary semaphore, reusing a free one if there is any.
+		 * The semaphore is given back to the pool, once the gpu is done with it, when the returned pointer is destroyed.
+		 * @throws std::runtime_error if there was an error creating the semaphore due to causes outside of the program.
+		 */
+		auto new_semaphore() -> unique_deleter_ptr<vulkan_handle::semaphore_t>;
+
+		/** Returns a timeline semaphore, which the gpu's [[vulkan_deletion_queue]] waits on before destroying objects; a free one is reused if there is any.
+		 * A reused timeline keeps its value, so its submitted_value is not 0; work given to the gpu must continue from it.
+		 * The timeline is given back to the pool when the returned pointer, and any deletions waiting on it, are gone.
+		 * @throws std::runtime_error if there was an error creating the semaphore due to causes outside of the program.
+		 */
+		auto new_timeline() -> std::shared_ptr<vulkan_tracked_timeline>;
+
+		/** Returns a primary command buffer from the given command pool, reusing a free one if there is any.
+		 * The command pool must be created with VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, as a reused buffer may still contain earlier instructions.
+		 * The buffer is given back to the pool, once the gpu is done with it, when the returned pointer is destroyed.
+		 * @throws std::runtime_error if there was an error allocating the buffer due to causes outside of the program.
+		 */
+		auto new_command(vulkan_handle::command_pool) -> unique_deleter_ptr<vulkan_handle::command_t>;
+
+		/** Forgets the free command buffers of the given command pool; should be called right before the command pool is destroyed, which also frees its buffers. */
+		void forget_command_pool(vulkan_handle::command_pool) noexcept;
+
+	public: // constructors
+		/** Constructs an invalid [[vulkan_object_pool]].
+		 * Using this is undefined behaviour.
+		 * @overload
+		 */
+		vulkan_object_pool() noexcept = default;
+		vulkan_object_pool(const vulkan_object_pool&) = delete;
+		auto operator=(const vulkan_object_pool&) -> vulkan_object_pool& = delete;
+
+		/** Should be called by [[vulkan_gpu_connection]].
+		 * Constructs a pool for objects of the given device, given back through the given queue.
+		 */
+		vulkan_object_pool(vulkan_handle::device, vulkan_deletion_queue&) noexcept;
+		/** Destroys all of the free objects. */
+		~vulkan_object_pool() noexcept;
+
+	private:
+		/** Makes the given timeline free, or destroys it if the gpu is not done with it. */
+		void give_back_timeline(vulkan_tracked_timeline*) noexcept;
+		/** Wraps the given timeline in a pointer that gives it back to the pool. */
+		auto share_timeline(vulkan_tracked_timeline*) -> std::shared_ptr<vulkan_tracked_timeline>;
+	};
+}
+
+#endif // ! COMPWOLF_VULKAN_OBJECT_POOL
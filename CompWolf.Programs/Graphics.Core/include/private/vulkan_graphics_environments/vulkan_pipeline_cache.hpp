@@ -0,0 +1,88 @@
+#ifndef COMPWOLF_VULKAN_PIPELINE_CACHE
+#define COMPWOLF_VULKAN_PIPELINE_CACHE
+
+#include <unique_deleter_ptr>
+#include "vulkan_handle.hpp"
+#include <filesystem>
+#include <string_view>
+#include <chrono>
+#include <cstddef>
+
+namespace compwolf::vulkan
+{
+	/** Aggregate type containing information about how a [[vulkan_pipeline_cache]] has been used.
+	 * @see vulkan_pipeline_cache
+	 */
+	struct pipeline_cache_stats
+	{
+		/** The size, in bytes, of the data loaded from the cache's file; 0 if nothing was loaded. */
+		std::size_t loaded_size;
+		/** The amount of pipelines created using the cache. */
+		std::size_t pipelines_created;
+		/** The total time spent creating pipelines using the cache. */
+		std::chrono::nanoseconds pipeline_creation_time;
+	};
+
+	/** A cache of compiled gpu-pipelines, shared by everything creating pipelines on a gpu.
+	 * The cache may be saved to a file, so that later runs of the program do not have to compile the same pipelines again.
+	 * The file is specific to the gpu and its driver; a file made for another gpu or driver is ignored.
+	 * @see vulkan_gpu_connection
+	 */
+	class vulkan_pipeline_cache
+	{
+		unique_deleter_ptr<vulkan_handle::pipeline_cache_t> _vulkan_pipeline_cache{};
+		vulkan_handle::device _vulkan_device{};
+		std::filesystem::path _path{};
+
+		pipeline_cache_stats _stats{};
+
+	public: // accessors
+		/** Returns the file that the cache is loaded from and saved to; this is empty if the cache is not saved. */
+		auto path() const noexcept -> const std::filesystem::path& { return _path; }
+
+		/** Returns information about how the cache has been used. */
+		auto stats() const noexcept -> const pipeline_cache_stats& { return _stats; }
+
+	public: // modifiers
+		/** Saves the cache to its file, so that it can be loaded when the program is next run.
+		 * The cache is also saved when it is destructed.
+		 * Does nothing if the cache has no file.
+		 * @throws std::runtime_error if the cache could not be saved.
+		 */
+		void save();
+
+		/** Should be called after creating pipelines using the cache, with the time it took.
+		 * @see pipeline_cache_stats
+		 */
+		void add_creation_time(std::chrono::nanoseconds duration, std::size_t pipeline_count = 1) noexcept
+		{
+			_stats.pipelines_created += pipeline_count;
+			_stats.pipeline_creation_time += duration;
+		}
+
+	public: // vulkan-specific
+		/** Returns the [[vulkan_handle::pipeline_cache]] that the cache represents. */
+		auto vulkan_cache() const noexcept -> vulkan_handle::pipeline_cache
+		{
+			return _vulkan_pipeline_cache.get();
+		}
+
+	public: // constructors
+		/** Constructs an invalid [[vulkan_pipeline_cache]].
+		 * Using this is undefined behaviour.
+		 * @overload
+		 */
+		vulkan_pipeline_cache() noexcept = default;
+		vulkan_pipeline_cache(vulkan_pipeline_cache&&) = default;
+		auto operator=(vulkan_pipeline_cache&&) -> vulkan_pipeline_cache& = default;
+
+		/** Should be called by [[vulkan_gpu_connection]].
+		 * Constructs a cache for the given device, loading it from a file in the given directory if there is a valid one.
+		 * @param directory The directory to load the cache from and save it to. If empty, the cache is not saved.
+		 * @throws std::runtime_error if there was an error during setup due to causes outside of the program.
+		 */
+		vulkan_pipeline_cache(vulkan_handle::physical_device, vulkan_handle::device, std::string_view directory);
+	};
+}
+
+#endif // ! COMPWOLF_VULKAN_PIPELINE_CACHE
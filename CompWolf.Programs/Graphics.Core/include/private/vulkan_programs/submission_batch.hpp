@@ -0,0 +1,100 @@
+#ifndef COMPWOLF_GRAPHICS_SUBMISSION_BATCH
+#define COMPWOLF_GRAPHICS_SUBMISSION_BATCH
+
+#include <vulkan_graphics_environments>
+#include "vulkan_gpu_program_manager.hpp"
+#include "vulkan_gpu_program.hpp"
+#include "vulkan_gpu_fence.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace compwolf::vulkan
+{
+	/** Aggregate type containing information about the latest time a [[submission_batch]] was flushed.
+	 * @see submission_batch
+	 */
+	struct submission_batch_stats
+	{
+		/** The amount of work given to the gpu, including work that only signals and waits. */
+		std::size_t submissions;
+		/** The amount of gpu-programs that were given to the gpu. */
+		std::size_t programs;
+		/** The amount of vkQueueSubmit2 calls; this is one for each queue that the work was on. */
+		std::size_t submit_calls;
+	};
+
+	/** Collects the work of several [[vulkan_gpu_program]]s, so that it can all be given to the gpu together.
+	 * Without this, each program's execute() calls vkQueueSubmit2 by itself.
+	 * With this, all work on the same queue, even of different managers, is given with one vkQueueSubmit2 when the batch is flushed.
+	 *
+	 * The programs may depend on each other; add(program, dependency) makes a program wait for another's work on the gpu, even if that work is in the same batch.
+	 * Like [[vulkan_gpu_program::prepare_execution]], the work must be given to the gpu, with flush(), before any other work of the same managers is, and before the managers are waited on.
+	 * The batch can be reused after being flushed; destroying it, or moving another batch into it, flushes any work that is still in it.
+	 * @see submit_programs
+	 * @see present_batch
+	 */
+	class submission_batch
+	{
+	private:
+		std::vector<vulkan_gpu_submission> _submissions{};
+		submission_batch_stats _stats{};
+
+	public: // accessors
+		/** Returns the work that has been added since the batch was last flushed. */
+		auto submissions() const noexcept -> const std::vector<vulkan_gpu_submission>& { return _submissions; }
+
+		/** Returns whether no work has been added since the batch was last flushed. */
+		auto empty() const noexcept -> bool { return _submissions.empty(); }
+
+		/** Returns information about the latest time the batch was flushed. */
+		auto stats() const noexcept -> const submission_batch_stats& { return _stats; }
+
+	public: // modifiers
+		/** Prepares running the given program, but waits until flush() before giving its work to the gpu.
+		 * A program must not be added more than once before flush().
+		 * @return a fence denoting when the program is finished running; other work may wait for it with add(program, dependency).
+		 * @throws std::logic_error if the program's gpu-instructions were removed by [[vulkan_gpu_program_manager::reset_programs]], and it has not been recorded since.
+		 */
+		auto add(vulkan_gpu_program& program) -> const vulkan_gpu_fence&
+		{
+			_submissions.push_back(program.prepare_execution());
+			return program.last_fence();
+		}
+
+		/** Prepares running the given program after the given fence's work is done, but waits until flush() before giving its work to the gpu.
+		 * The wait is on the gpu, so the cpu does not wait; see [[vulkan_gpu_program_manager::wait_for]].
+		 * @return a fence denoting when the program is finished running.
+		 * @throws std::logic_error if the program's gpu-instructions were removed by [[vulkan_gpu_program_manager::reset_programs]], and it has not been recorded since.
+		 */
+		auto add(vulkan_gpu_program& program, const vulkan_gpu_fence& dependency) -> const vulkan_gpu_fence&
+		{
+			program.manager().wait_for(dependency);
+			return add(program);
+		}
+
+		/** Adds some already prepared work, such as from [[vulkan_gpu_program_manager::prepare_submission]], to be given to the gpu by flush(). */
+		void add(vulkan_gpu_submission submission)
+		{
+			_submissions.push_back(std::move(submission));
+		}
+
+		/** Gives all of the added work to the gpu, in the order it was added, and then empties the batch so that it can be reused.
+		 * This calls vkQueueSubmit2 once for each queue that the work is on, with a VkSubmitInfo2 for each work.
+		 * @return The amount of vkQueueSubmit2 calls.
+		 * @throws std::runtime_error if there was an error submitting the work to the gpu due to causes outside of the program.
+		 * The batch is then still emptied, as the work that could not be given to the gpu is replaced by work only signaling its fences; see [[submit_programs]].
+		 */
+		auto flush() -> std::size_t;
+
+	public: // constructors
+		/** Constructs an empty batch. */
+		submission_batch() noexcept = default;
+		submission_batch(submission_batch&&) = default;
+		auto operator=(submission_batch&&) -> submission_batch&;
+		/** Flushes the batch, as the added work has already taken its place in its managers' work; errors are ignored. */
+		~submission_batch() noexcept;
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_SUBMISSION_BATCH
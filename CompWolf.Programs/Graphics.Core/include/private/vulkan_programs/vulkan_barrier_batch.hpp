@@ -0,0 +1,195 @@
+#ifndef COMPWOLF_GRAPHICS_VULKAN_BARRIER_BATCH
+#define COMPWOLF_GRAPHICS_VULKAN_BARRIER_BATCH
+
+#include <vulkan_graphics_environments>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace compwolf::vulkan
+{
+	/** The ways that gpu-instructions can use a buffer or image, as given to [[vulkan_barrier_batch::use]].
+	 * @see vulkan_access_info
+	 */
+	enum class vulkan_resource_access
+	{
+		/** Read as the arguments of an indirect draw, like [[vulkan_draw_culling]]'s draw commands. */
+		indirect_read,
+		/** Read as the indices of a draw. */
+		index_read,
+		/** Read as the vertices of a draw. */
+		vertex_read,
+		/** Read as a field by a vertex shader. */
+		vertex_shader_read,
+		/** Read as a field by a fragment shader. */
+		fragment_shader_read,
+		/** Read as a field by a compute shader. */
+		compute_shader_read,
+		/** Read and written as a storage field by a compute shader. */
+		compute_shader_write,
+		/** Drawn on, as an image in a render pass or dynamic rendering. */
+		color_attachment_write,
+		/** Read by a copy, like vkCmdCopyBuffer or vkCmdCopyImageToBuffer. */
+		copy_read,
+		/** Written by a copy, like vkCmdCopyBuffer or vkCmdCopyImageToBuffer. */
+		copy_write,
+		/** Written by a clear, like vkCmdFillBuffer. */
+		clear_write,
+		/** Read by the cpu once the gpu-instructions are done. */
+		host_read,
+		/** Written by the cpu before later gpu-instructions are given to the gpu. */
+		host_write,
+		/** Displayed on a window; for images only. */
+		present,
+	};
+
+	/** Aggregate type containing what a [[vulkan_resource_access]] means in vulkan terms.
+	 * @see vulkan_access_info
+	 */
+	struct vulkan_resource_access_info
+	{
+		/** The pipeline stages that use the resource, as a VkPipelineStageFlags2. */
+		vulkan_handle::pipeline_stages stages;
+		/** The memory accesses of the resource, as a VkAccessFlags2. */
+		vulkan_handle::access_flags access;
+		/** The layout that an image must be in; meaningless for buffers. */
+		vulkan_handle::image_layout layout;
+		/** Whether the resource is written. */
+		bool writes;
+	};
+
+	/** Returns what the given [[vulkan_resource_access]] means in vulkan terms. */
+	auto vulkan_access_info(vulkan_resource_access) noexcept -> vulkan_resource_access_info;
+
+	/** Aggregate type containing how a buffer or image was last used by the gpu-instructions recorded so far.
+	 * A value-initialized state means that the resource has not been used by the instructions, and is in VK_IMAGE_LAYOUT_UNDEFINED.
+	 * @see vulkan_barrier_batch
+	 */
+	struct vulkan_resource_state
+	{
+		/** The stages of the latest write, which later uses must wait for; 0 if the resource has not been written. */
+		vulkan_handle::pipeline_stages write_stages;
+		/** The memory accesses of the latest write, which must be made visible to later uses. */
+		vulkan_handle::access_flags write_access;
+		/** The stages that have read the resource since the latest write, which later writes must wait for. */
+		vulkan_handle::pipeline_stages read_stages;
+		/** The stages that the latest write is already visible to. */
+		vulkan_handle::pipeline_stages visible_stages;
+		/** The memory accesses that the latest write is already visible to. */
+		vulkan_handle::access_flags visible_access;
+		/** The layout that an image is in; meaningless for buffers. */
+		vulkan_handle::image_layout layout;
+
+		/** Returns the state of a resource that was last used in the given way, such that later uses wait for it. */
+		static auto after(vulkan_resource_access) noexcept -> vulkan_resource_state;
+	};
+
+	/** Aggregate type containing a memory barrier that a [[vulkan_barrier_batch]] has not yet recorded.
+	 * Exactly one of buffer and image is not null.
+	 * @see vulkan_barrier_batch::pending
+	 */
+	struct vulkan_pending_barrier
+	{
+		/** The buffer that the barrier is for, or nullptr if it is for an image. */
+		vulkan_handle::buffer buffer;
+		/** The image that the barrier is for, or nullptr if it is for a buffer. */
+		vulkan_handle::image image;
+		/** The stages that must be done before the barrier. */
+		vulkan_handle::pipeline_stages src_stages;
+		/** The memory accesses that must be made available by the barrier. */
+		vulkan_handle::access_flags src_access;
+		/** The stages that must wait for the barrier. */
+		vulkan_handle::pipeline_stages dst_stages;
+		/** The memory accesses that must be made visible by the barrier. */
+		vulkan_handle::access_flags dst_access;
+		/** The layout that an image is in before the barrier; VK_IMAGE_LAYOUT_UNDEFINED if its contents are discarded. Meaningless for buffers. */
+		vulkan_handle::image_layout old_layout;
+		/** The layout that an image is in after the barrier; meaningless for buffers. */
+		vulkan_handle::image_layout new_layout;
+	};
+
+	/** Aggregate type containing how many barriers a [[vulkan_barrier_batch]] has recorded.
+	 * @see vulkan_barrier_batch::stats
+	 */
+	struct vulkan_barrier_batch_stats
+	{
+		/** The amount of buffer and image barriers recorded. */
+		std::size_t barriers;
+		/** The amount of vkCmdPipelineBarrier2 calls, each recording all of the barriers pending at the time. */
+		std::size_t calls;
+	};
+
+	/** Tracks how the buffers and images used by some gpu-instructions were last used, and records the memory barriers needed between their uses.
+	 * Each use is given to use(), which works out the narrowest barrier needed before it, if any; flush() then records all of the pending barriers with a single vkCmdPipelineBarrier2.
+	 * Reads after a write only wait for the write once for each stage, so several reads of the same data need at most one barrier.
+	 *
+	 * The batch only knows of uses given to it, so it tracks the uses within the same gpu-instructions.
+	 * Work given to the gpu waits for earlier work with semaphores, which already orders the work's uses; see [[vulkan_gpu_program::set_wait_stages]].
+	 * An image that is in a known layout at the start of the instructions, or was used before them in a way that the instructions are not already waiting for, should be given to track() before it is used.
+	 *
+	 * Uses given between two calls to flush() are taken to happen together, after the barriers; so a resource written by one use should not be used again before flush() is called.
+	 * @see vulkan_code_parameters::barriers
+	 */
+	class vulkan_barrier_batch
+	{
+	private:
+		vulkan_handle::command _command{};
+		std::map<vulkan_handle::buffer, vulkan_resource_state> _buffers{};
+		std::map<vulkan_handle::image, vulkan_resource_state> _images{};
+		std::vector<vulkan_pending_barrier> _pending{};
+		vulkan_barrier_batch_stats _stats{};
+
+	public: // accessors
+		/** Returns the state of the given buffer, after the uses given so far. */
+		auto state(vulkan_handle::buffer) const -> vulkan_resource_state;
+		/** Returns the state of the given image, after the uses given so far. */
+		auto state(vulkan_handle::image) const -> vulkan_resource_state;
+
+		/** Returns the barriers that have been found to be needed since the batch was last flushed. */
+		auto pending() const noexcept -> const std::vector<vulkan_pending_barrier>& { return _pending; }
+
+		/** Returns how many barriers the batch has recorded. */
+		auto stats() const noexcept -> const vulkan_barrier_batch_stats& { return _stats; }
+
+	public: // modifiers
+		/** Sets how the given buffer was last used before the tracked instructions. */
+		void track(vulkan_handle::buffer, vulkan_resource_state);
+		/** Sets how the given image was last used before the tracked instructions, including what layout it is in. */
+		void track(vulkan_handle::image, vulkan_resource_state);
+
+		/** Tells the batch that the given buffer is about to be used in the given way, adding a barrier before the use if needed. */
+		void use(vulkan_handle::buffer, vulkan_resource_access);
+		/** Tells the batch that the given image is about to be used in the given way, adding a barrier before the use if needed.
+		 * The whole image is used, as in its single mip level and array layer of color.
+		 * @param discard_contents Whether the image's current contents can be thrown away, such as when it is about to be cleared.
+		 * This lets its layout be changed without keeping the contents.
+		 * @throws std::logic_error if the image is used in a way needing a different layout than a pending barrier moves it to; flush() must be called between the uses.
+		 */
+		void use(vulkan_handle::image, vulkan_resource_access, bool discard_contents = false);
+
+		/** Records the pending barriers with a single vkCmdPipelineBarrier2, if there are any.
+		 * This must be called before the gpu-instructions using the resources are recorded.
+		 */
+		void flush();
+
+	public: // constructors
+		/** Constructs an invalid [[vulkan_barrier_batch]].
+		 * Flushing this batch is undefined behaviour.
+		 * @overload
+		 */
+		vulkan_barrier_batch() noexcept = default;
+		vulkan_barrier_batch(vulkan_barrier_batch&&) = default;
+		auto operator=(vulkan_barrier_batch&&) -> vulkan_barrier_batch& = default;
+
+		/** Constructs a batch recording barriers to the given [[vulkan_handle::command]], representing a VkCommandBuffer, with no resources used yet. */
+		explicit vulkan_barrier_batch(vulkan_handle::command command) noexcept
+			: _command(command)
+		{}
+
+	private:
+		/** Adds the barrier needed before the given use of a resource with the given state, if any, and updates the state. */
+		void add_use(vulkan_resource_state&, vulkan_handle::buffer, vulkan_handle::image, vulkan_resource_access, bool discard_contents);
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_VULKAN_BARRIER_BATCH
@@ -3,35 +3,69 @@
 
 #include <vulkan_graphics_environments>
 #include <gpu_programs>
-#include <unique_deleter_ptr>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <span>
 
 namespace compwolf::vulkan
 {
-	/** A "fence", which allows the cpu to know when the gpu has finished some work. */
+	/** A "fence", which allows the cpu to know when the gpu has finished some work.
+	 * The work is done when a timeline semaphore, usually a [[vulkan_gpu_program_manager]]'s, has reached a value.
+	 * The fence does not own the semaphore, so it is cheap to create.
+	 */
 	class vulkan_gpu_fence : public gpu_fence<vulkan_graphics_environment>
 	{
 	private:
-		unique_deleter_ptr<vulkan_handle::fence_t> _vulkan_fence;
+		vulkan_handle::semaphore _vulkan_timeline{};
+		uint64_t _value{};
 
 	public: // accessors
 		/** Returns true if the work is done, otherwise returns false. */
 		auto completed() const noexcept -> bool final;
 
+		/** Returns the value that the timeline semaphore has when the work is done. */
+		auto value() const noexcept -> uint64_t { return _value; }
+
 		/** Returns whether this is valid, that is one not constructed by the default constructor. */
 		operator bool() const noexcept
 		{
-			return !!_vulkan_fence;
+			return !!_vulkan_timeline;
 		}
 
 	public: // modifiers
 		/** Waits until the work is done, and then returns. */
 		void wait() const noexcept final;
-		/** Makes the fence consider its related work not done. */
-		void reset() noexcept;
+		/** Waits until the work is done, or until the given time has passed.
+		 * @return Whether the work is done.
+		 */
+		auto wait_for(std::chrono::nanoseconds timeout) const noexcept -> bool;
+
+		/** Calls the given function once the work is done, without waiting for it.
+		 * The function is called by [[vulkan_graphics_environment::update]]; see [[vulkan_fence_reactor]].
+		 */
+		void when_done(std::function<void()>) const;
+
+		/** Allows a coroutine, like a [[gpu_task]], to co_await the fence.
+		 * The coroutine is resumed by [[vulkan_graphics_environment::update]] once the work is done, instead of blocking the thread.
+		 */
+		auto operator co_await() const noexcept
+		{
+			struct awaiter
+			{
+				const vulkan_gpu_fence* fence;
+
+				auto await_ready() const noexcept -> bool { return fence->completed(); }
+				void await_suspend(std::coroutine_handle<> handle) const { fence->when_done([handle]() { handle.resume(); }); }
+				void await_resume() const noexcept {}
+			};
+			return awaiter{ this };
+		}
 
 	public: // vulkan-related
-		/** Returns the vulkan_gpu_fence, representing a VkFence. */
-		auto vulkan_fence() const noexcept -> vulkan_handle::fence { return _vulkan_fence.get(); }
+		/** Returns the timeline semaphore that the fence waits on, representing a VkSemaphore. */
+		auto vulkan_timeline() const noexcept -> vulkan_handle::semaphore { return _vulkan_timeline; }
 
 	public: // constructors
 		/** Constructs an invalid [[vulkan_gpu_fence]].
@@ -42,12 +76,24 @@ namespace compwolf::vulkan
 		vulkan_gpu_fence(vulkan_gpu_fence&&) = default;
 		auto operator=(vulkan_gpu_fence&&) -> vulkan_gpu_fence& = default;
 
-		/** Creates a fence for the given gpu.
-		 * @param signaled If true, then the fence states that the gpu-work is already finished.
-		 * @throws std::runtime_error if there was an error during creation of the fence due to causes outside of the program.
+		/** Creates a fence for the given gpu, denoting that work is done when the given timeline semaphore has reached the given value.
+		 * The semaphore must stay alive for as long as the fence is used.
+		 * @param value The value to wait for. If 0, the fence states that the work is already done.
 		 */
-		vulkan_gpu_fence(vulkan_gpu_connection&, bool signaled = false);
+		vulkan_gpu_fence(vulkan_gpu_connection&, vulkan_handle::semaphore timeline, uint64_t value) noexcept;
 	};
 }
 
+namespace compwolf::vulkan
+{
+	/** Waits until the work of all, or any, of the given fences is done, or until the given time has passed.
+	 * All of the fences are waited on together, with a single vkWaitSemaphores; fences on the same timeline semaphore are merged first.
+	 * The fences must be on the same gpu.
+	 * @param wait_all Whether to wait for all of the fences, instead of any of them.
+	 * @return Whether the work is done; true if there are no fences.
+	 */
+	auto wait_for_fences(std::span<const vulkan_gpu_fence* const>, bool wait_all
+		, std::chrono::nanoseconds timeout = std::chrono::nanoseconds::max()) noexcept -> bool;
+}
+
 #endif // ! COMPWOLF_GRAPHICS_VULKAN_GPU_FENCE
@@ -0,0 +1,159 @@
+#ifndef COMPWOLF_GRAPHICS_VULKAN_GPU_PROFILER
+#define COMPWOLF_GRAPHICS_VULKAN_GPU_PROFILER
+
+#include <vulkan_graphics_environments>
+#include <events>
+#include <unique_deleter_ptr>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace compwolf::vulkan
+{
+	/** Aggregate type containing how long the gpu spent on some part of a frame.
+	 * @see gpu_frame_timings
+	 */
+	struct gpu_timing_scope
+	{
+		/** The name given when the part was timed. */
+		std::string_view name;
+		/** How many other timed parts this is inside of. */
+		std::size_t depth;
+		/** When the gpu started on the part, relative to when it started on the frame. */
+		std::chrono::nanoseconds start;
+		/** How long the gpu spent on the part. */
+		std::chrono::nanoseconds duration;
+	};
+
+	/** Aggregate type containing how long the gpu spent on a frame, and on each timed part of it.
+	 * @see vulkan_gpu_profiler
+	 */
+	struct gpu_frame_timings
+	{
+		/** How many frames the profiler had timed before this one. */
+		std::size_t frame_number;
+		/** The index of the frame in flight that drew the frame. */
+		std::size_t frame_in_flight_index;
+		/** How long the gpu spent on the whole frame. */
+		std::chrono::nanoseconds total;
+		/** The timed parts of the frame, in the order that they were started. */
+		std::vector<gpu_timing_scope> scopes;
+		/** The amount of parts that were not timed, because the profiler did not have room for them.
+		 * The profiler makes room for them on later frames.
+		 */
+		std::size_t dropped_scopes;
+	};
+
+	/** Times how long the gpu spends on the work of a [[vulkan_gpu_program]], and on named parts of it.
+	 * The times are written by the gpu, and read by the cpu once the gpu is done with them, without waiting for the gpu.
+	 * The profiler keeps the times of each frame in flight separately, as the gpu may be working on several frames at once.
+	 *
+	 * If the gpu cannot time its work, the profiler does nothing.
+	 * In vulkan terms, this represents a VkQueryPool of timestamps for each frame in flight.
+	 */
+	class vulkan_gpu_profiler
+	{
+		/** The data kept for each frame in flight. */
+		struct frame_data
+		{
+			unique_deleter_ptr<vulkan_handle::query_pool_t> pool;
+			/** The amount of timestamps that the pool can contain. */
+			uint32_t capacity{};
+			/** The amount of timestamps written to the pool by the latest recorded work. */
+			uint32_t used{};
+			/** Whether the pool contains times that have not been read yet. */
+			bool pending{};
+			gpu_frame_timings timings;
+			/** For each of timings.scopes, the index of its first timestamp. */
+			std::vector<uint32_t> scope_queries;
+		};
+
+		vulkan_gpu_connection* _gpu{};
+		std::vector<frame_data> _frames;
+		/** The nanoseconds between each of the gpu's timestamp-ticks. */
+		double _timestamp_period{};
+		bool _supported{};
+		/** The amount of timestamps that the latest frames needed room for. */
+		uint32_t _needed_capacity{};
+
+		std::size_t _next_frame_number{};
+		frame_data* _recording{};
+		vulkan_handle::command _recording_command{};
+		/** The indices of the scopes being recorded that have not been ended yet. */
+		std::vector<std::size_t> _open_scopes;
+
+		std::vector<uint64_t> _results;
+		event<const gpu_frame_timings&> _frame_timed;
+
+	public: // accessors
+		/** Returns the gpu that the profiler is on. */
+		auto gpu() noexcept -> vulkan_gpu_connection& { return *_gpu; }
+		/** Returns the gpu that the profiler is on.
+		 * @customoverload
+		 */
+		auto gpu() const noexcept -> const vulkan_gpu_connection& { return *_gpu; }
+
+		/** Returns whether the gpu can time its work; if not, the profiler does nothing. */
+		auto supported() const noexcept -> bool { return _supported; }
+
+		/** Returns whether work is being recorded with the profiler, that is between begin_frame and end_frame. */
+		auto recording() const noexcept -> bool { return _recording; }
+
+		/** Event invoked when the times of a frame have been read. */
+		auto frame_timed() const noexcept -> const event<const gpu_frame_timings&>& { return _frame_timed; }
+
+		/** Returns whether this is valid, that is one not constructed by the default constructor. */
+		operator bool() const noexcept { return !_frames.empty(); }
+
+	public: // modifiers
+		/** Should be called at the start of recording a frame's gpu-instructions, before they are recorded with begin_scope and end_scope.
+		 * The gpu must be done with the last work recorded for the frame in flight; any times it wrote are read here, invoking frame_timed.
+		 * @param command The [[vulkan_handle::command]] being recorded; it must not be inside a render pass.
+		 * @throws std::runtime_error if there was an error making room for more times due to causes outside of the program.
+		 */
+		void begin_frame(vulkan_handle::command command, std::size_t frame_in_flight_index);
+		/** Should be called at the end of recording a frame's gpu-instructions. */
+		void end_frame() noexcept;
+
+		/** Starts timing a part of the frame being recorded.
+		 * @param name The name of the part. The characters must stay alive until the frame's times have been read.
+		 * @return An index to pass to end_scope, or an invalid index if the part is not timed.
+		 */
+		auto begin_scope(std::string_view name) -> std::size_t;
+		/** Stops timing a part of the frame being recorded.
+		 * @param scope The index returned by begin_scope.
+		 */
+		void end_scope(std::size_t scope) noexcept;
+
+		/** Reads the times of any frame that the gpu is done with, invoking frame_timed for each of them.
+		 * This does not wait for the gpu.
+		 */
+		void collect();
+
+	public: // constructors
+		/** Constructs an invalid [[vulkan_gpu_profiler]].
+		 * Using this profiler is undefined behaviour.
+		 * @overload
+		 */
+		vulkan_gpu_profiler() = default;
+		vulkan_gpu_profiler(vulkan_gpu_profiler&&) = default;
+		auto operator=(vulkan_gpu_profiler&&) -> vulkan_gpu_profiler& = default;
+
+		/** Creates a profiler for the given gpu, which may be recording the given amount of frames at once.
+		 * @throws std::runtime_error if there was an error during setup due to causes outside of the program.
+		 */
+		vulkan_gpu_profiler(vulkan_gpu_connection&, std::size_t frames_in_flight);
+
+	private:
+		/** Reads the given frame's times, if the gpu is done writing them.
+		 * @return Whether the times could be read.
+		 */
+		auto read(frame_data&) -> bool;
+		/** Replaces the given frame's pool with one that can contain the given amount of timestamps. */
+		void create_pool(frame_data&, uint32_t capacity);
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_VULKAN_GPU_PROFILER
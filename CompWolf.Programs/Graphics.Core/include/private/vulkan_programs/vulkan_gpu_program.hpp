@@ -5,7 +5,11 @@
 #include <gpu_programs>
 #include "vulkan_gpu_program_manager.hpp"
 #include "vulkan_gpu_fence.hpp"
+#include "vulkan_gpu_profiler.hpp"
+#include "vulkan_barrier_batch.hpp"
 #include <unique_deleter_ptr>
+#include <span>
+#include <cstddef>
 
 namespace compwolf::vulkan
 {
@@ -14,14 +18,36 @@ namespace compwolf::vulkan
 	{
 		/** The program's [[vulkan_handle::command]], representing a VkCommandBuffer. */
 		vulkan_handle::command command;
+		/** The profiler timing the program's work, or nullptr if it is not timed.
+		 * The code may time parts of its work with [[vulkan_gpu_profiler::begin_scope]] and [[vulkan_gpu_profiler::end_scope]].
+		 */
+		vulkan_gpu_profiler* profiler;
+		/** Tracks the buffers and images used by the code, to record the barriers needed between their uses.
+		 * Any barriers still pending once the code is done are recorded at the end of the program.
+		 */
+		vulkan_barrier_batch* barriers;
 	};
 
+	/** Gives the given work to the gpu.
+	 * All work for the same queue is given with a single vkQueueSubmit2, with a VkSubmitInfo2 for each work, in the given order.
+	 * Each work signals its manager's timeline semaphore, so no fences are needed to know when it is done.
+	 * @return The amount of vkQueueSubmit2 calls, which is the amount of different queues.
+	 * @throws std::runtime_error if there was an error submitting the work to the gpu due to causes outside of the program.
+	 * The timeline values of the work that could not be given to the gpu are then still signaled, after the earlier values, so that waiting for the managers does not last forever.
+	 */
+	auto submit_programs(std::span<const vulkan_gpu_submission>) -> std::size_t;
+
 	/** A "program", which allows the cpu to know when the gpu has finished some work. */
 	class vulkan_gpu_program : public gpu_specific_program<vulkan_graphics_environment, vulkan_gpu_fence>
 	{
 	private:
 		vulkan_gpu_program_manager* _manager{};
 		unique_deleter_ptr<vulkan_handle::command_t> _vulkan_command{};
+		vulkan_gpu_fence _fence{};
+		/** The manager's [[vulkan_gpu_program_manager::reset_count]] when the program was last recorded. */
+		std::size_t _recorded_reset_count{};
+		/** The stages that wait for the manager's earlier work; see [[vulkan_gpu_submission::wait_stages]]. */
+		vulkan_handle::pipeline_stages _wait_stages{};
 		event_key<> _manager_destructing_key{};
 
 	public: // accessors
@@ -30,6 +56,22 @@ namespace compwolf::vulkan
 		/** Returns the manager that the program is on. */
 		auto manager() const noexcept -> const vulkan_gpu_program_manager& { return *_manager; }
 
+		/** Returns the fence denoting when the program's latest run is finished.
+		 * This is invalid if the program has not been run.
+		 */
+		auto last_fence() const noexcept -> const vulkan_gpu_fence& { return _fence; }
+
+		/** Returns whether the program has gpu-instructions to run, as in they have not been removed by [[vulkan_gpu_program_manager::reset_programs]] since they were recorded. */
+		auto recorded() const noexcept -> bool
+		{
+			return _recorded_reset_count == _manager->reset_count();
+		}
+
+		/** Returns the pipeline stages of the program that wait for earlier work, as a VkPipelineStageFlags2; 0 if all of them do.
+		 * @see vulkan_gpu_program::set_wait_stages
+		 */
+		auto wait_stages() const noexcept -> vulkan_handle::pipeline_stages { return _wait_stages; }
+
 		/** Returns whether this is valid, that is one not constructed by the default constructor. */
 		operator bool() const noexcept
 		{
@@ -37,12 +79,35 @@ namespace compwolf::vulkan
 		}
 
 	public: // modifiers
+		/** Sets which pipeline stages of the program wait for the manager's earlier work, and any work given to [[vulkan_gpu_program_manager::wait_for]], as a VkPipelineStageFlags2; 0 for all of them, which is the default.
+		 * This should be the first stages that use something the earlier work may use, such as the stages of [[vulkan_access_info]](vulkan_resource_access::compute_shader_write) for a compute program;
+		 * the program's earlier stages can then start before the earlier work is done.
+		 */
+		void set_wait_stages(vulkan_handle::pipeline_stages stages) noexcept { _wait_stages = stages; }
+
 		/** Runs the program.
 		 * @return a fence denoting when the program is finished running.
+		 * @throws std::logic_error if the program's gpu-instructions were removed by [[vulkan_gpu_program_manager::reset_programs]], and it has not been recorded since.
 		 * @throws std::runtime_error if there was an error submitting the program to the gpu due to causes outside of the program.
 		 */
 		auto execute() -> const vulkan_gpu_fence& final;
 
+		/** Prepares running the program like execute(), but returns the work instead of giving it to the gpu.
+		 * This allows several programs to be given to the gpu together with [[submit_programs]].
+		 * The work must be given to the gpu before any other program on the manager is run, and before the manager is waited on.
+		 * @throws std::logic_error if the program's gpu-instructions were removed by [[vulkan_gpu_program_manager::reset_programs]], and it has not been recorded since.
+		 * @see present_batch
+		 */
+		auto prepare_execution() -> vulkan_gpu_submission;
+
+		/** Replaces the program's gpu-instructions with the ones given by the code.
+		 * The program must not be running when this is called.
+		 * @param profiler If not nullptr, times the program's work, as the given frame in flight of the profiler.
+		 * @throws std::runtime_error if there was an error recording the gpu-instructions due to causes outside of the program.
+		 */
+		void record(const std::function<void(const vulkan_code_parameters&)>& code
+			, vulkan_gpu_profiler* profiler = nullptr, std::size_t profiler_frame_index = 0);
+
 	public: // vulkan-related
 		/** Returns the [[vulkan_handle::command]], representing a Vkprogram. */
 		auto vulkan_program() const noexcept -> vulkan_handle::command { return _vulkan_command.get(); }
@@ -57,10 +122,13 @@ namespace compwolf::vulkan
 		auto operator=(vulkan_gpu_program&&) -> vulkan_gpu_program& = default;
 
 		/** Creates a program for the given gpu.
+		 * The program's command buffer is reused from an earlier program on the manager if possible; see [[vulkan_object_pool]].
+		 * @param profiler If not nullptr, times the program's work, as the given frame in flight of the profiler.
 		 * @throws std::runtime_error if there was an error during creation of the program due to causes outside of the program.
 		 */
 		vulkan_gpu_program(vulkan_gpu_program_manager&
-			, std::function<void(const vulkan_code_parameters&)> code);
+			, std::function<void(const vulkan_code_parameters&)> code
+			, vulkan_gpu_profiler* profiler = nullptr, std::size_t profiler_frame_index = 0);
 	};
 }
 
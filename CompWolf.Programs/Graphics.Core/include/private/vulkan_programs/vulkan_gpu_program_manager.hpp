@@ -6,17 +6,50 @@
 #include "vulkan_gpu_semaphore.hpp"
 #include <unique_deleter_ptr>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <optional>
+#include <vector>
 
 namespace compwolf::vulkan
 {
-	/** Aggregate type containing data used by [[vulkan_gpu_program_manager]] for synchronization between its work. */
-	struct gpu_program_sync
+	/** Aggregate type containing a value of another manager's timeline semaphore, which some work must wait for.
+	 * @see vulkan_gpu_program_manager::wait_for
+	 */
+	struct vulkan_gpu_dependency
+	{
+		/** The other manager's timeline semaphore. */
+		vulkan_handle::semaphore timeline;
+		/** The value of timeline that the work must wait for. */
+		uint64_t value;
+	};
+
+	/** Aggregate type containing what is needed to give some work of a [[vulkan_gpu_program_manager]] to the gpu.
+	 * @see vulkan_gpu_program_manager::prepare_submission
+	 * @see submit_programs
+	 */
+	struct vulkan_gpu_submission
 	{
-		/** Semaphore waiting for all work to be done. */
-		vulkan_gpu_semaphore semaphore;
-		/** Fence waiting for all work to be done. */
-		vulkan_gpu_fence fence;
+		/** The [[vulkan_handle::queue]] that the work must be given to. */
+		vulkan_handle::queue queue;
+		/** The [[vulkan_handle::command]] to run, representing a VkCommandBuffer; nullptr if the submission only signals and waits. */
+		vulkan_handle::command command;
+		/** A binary semaphore that the work must wait on before outputting colors, such as one signaled when a window's image can be drawn on; nullptr if it should not wait on one. */
+		vulkan_handle::semaphore wait_semaphore;
+		/** The manager's timeline semaphore. */
+		vulkan_handle::semaphore timeline;
+		/** The value of timeline that the work must wait for before its wait_stages; 0 if it should not wait. */
+		uint64_t wait_value;
+		/** The value that timeline must be signaled with when the work is done. */
+		uint64_t signal_value;
+		/** A binary semaphore that must be signaled when the work is done; nullptr if none should be. */
+		vulkan_handle::semaphore signal_semaphore;
+		/** Other managers' timeline semaphores, whose work must be done before the work's wait_stages; at most one for each timeline. */
+		std::vector<vulkan_gpu_dependency> dependencies;
+		/** The pipeline stages of the work that must wait for timeline and dependencies, as a VkPipelineStageFlags2; 0 if all of the work must wait.
+		 * Earlier stages of the work may start before the earlier work is done, so this should be the first stages that use anything the earlier work uses.
+		 */
+		vulkan_handle::pipeline_stages wait_stages;
 	};
 
 	/** Aggregate type used by gpu_manager.new_job to specify the job to create. */
@@ -42,7 +75,11 @@ namespace compwolf::vulkan
 
 	/** A manager for some [[vulkan_gpu_program]]s.
 	 * Programs should be split into different managers when they can run asynchronous.
-	 * In vulkan terms, this represents a VkCommandPool.
+	 * 
+	 * The manager's work is synchronized with a single timeline semaphore, whose value is increased by each work given to the gpu.
+	 * Each work waits for the manager's previous work, so the value tells how much of the work the gpu is done with.
+	 * The timeline is also what the gpu's [[vulkan_deletion_queue]] waits on before destroying objects that the manager's programs may use.
+	 * In vulkan terms, this represents a VkCommandPool and a timeline VkSemaphore.
 	 */
 	class vulkan_gpu_program_manager
 	{
@@ -51,9 +88,19 @@ namespace compwolf::vulkan
 		std::size_t _family_index;
 		std::size_t _thread_index;
 
+		// The timeline is declared before the pool, so that the pool's destruction is made to wait on it.
+		std::shared_ptr<vulkan_tracked_timeline> _timeline;
 		unique_deleter_ptr<vulkan_handle::command_pool_t> _pool;
-		std::vector<gpu_program_sync> _syncs;
-		std::size_t _syncs_count;
+		/** The value that the timeline is signaled with by the latest work given to the gpu; also kept in _timeline for the gpu's [[vulkan_deletion_queue]].
+		 * The timeline may be reused from an earlier manager, so this starts at the value that it has reached.
+		 */
+		uint64_t _submitted_value{};
+		/** The amount of times that reset_programs() has been called. */
+		std::size_t _reset_count{};
+		/** A binary semaphore that the next work must wait on. */
+		vulkan_handle::semaphore _next_wait_semaphore{};
+		/** Another manager's timeline semaphore that the next work must wait on, and the value to wait for. */
+		std::vector<vulkan_gpu_dependency> _next_dependencies{};
 
 		destruct_event<> _destructing;
 
@@ -78,86 +125,92 @@ namespace compwolf::vulkan
 		/** Returns the index of the gpu-thread in the gpu-thread-family's threads-vector. */
 		auto thread_index() const noexcept -> std::size_t { return _thread_index; }
 
-		/** Returns whether there are currently any synchronization-data. */
-		auto has_sync() const noexcept -> bool
-		{
-			return _syncs_count > 0;
-		}
-
-		/** Returns a pointer to the manager's latest synchronization-data.
-		 * Waiting on the data's fence waits for all of the manager's programs to finish.
-		 * Returns nullptr if there are no synchronization data.
+		/** Returns the value that the manager's timeline semaphore is signaled with by the latest work given to the gpu.
+		 * The timeline may be reused from an earlier manager, so this is not necessarily 0 before any work is given to the gpu.
 		 */
-		auto latest_synchronization() const noexcept -> const gpu_program_sync*
-		{
-			return has_sync() ? &_syncs[_syncs_count - 1] : nullptr;
-		}
-		/** Returns a pointer to the manager's latest synchronization-data.
-		 * Waiting on the data's fence waits for all of the manager's programs to finish.
-		 * Returns nullptr if there are no synchronization data.
-		 * @customoverload
-		 */
-		auto latest_synchronization() noexcept -> gpu_program_sync*
+		auto submitted_value() const noexcept -> uint64_t { return _submitted_value; }
+
+		/** Returns a fence denoting when all of the work given to the gpu so far is done. */
+		auto latest_fence() const noexcept -> vulkan_gpu_fence
 		{
-			return has_sync() ? &_syncs[_syncs_count - 1] : nullptr;
+			return vulkan_gpu_fence(*_gpu, vulkan_timeline(), _submitted_value);
 		}
 
 		/** Returns whether any of the programs are still running. */
 		auto working() const noexcept -> bool
 		{
-			return has_sync() ? !latest_synchronization()->fence.completed() : false;
+			return !latest_fence().completed();
 		}
 
+		/** Returns the amount of times that the programs' gpu-instructions have been reset together; see reset_programs(). */
+		auto reset_count() const noexcept -> std::size_t { return _reset_count; }
+
 		/** Returns an event that is invoked right before the manager is destructed. */
 		auto destructing() const noexcept -> const event<>&
 		{ return _destructing; }
 
 	public: // modifiers
-		/** Waits until all of the programs are done, and then returns. */
+		/** Waits until all of the programs are done, and then returns.
+		 * This is a single wait on the manager's timeline semaphore.
+		 */
 		void wait() const noexcept
 		{
-			for (std::size_t i = 0; i < _syncs_count; ++i)
-				_syncs[i].fence.wait();
+			latest_fence().wait();
 		}
 
-		/** Erases all elements from the container. */
-		void clear_syncs()
+		/** Removes the gpu-instructions of all of the manager's programs at once, which is cheaper than replacing them one program at a time.
+		 * Each program must be recorded again before it is run; this suits programs that are recorded every frame anyway.
+		 * None of the programs may be running when this is called.
+		 * In vulkan terms, this calls vkResetCommandPool.
+		 * @throws std::runtime_error if there was an error resetting the programs due to causes outside of the program.
+		 */
+		void reset_programs();
+
+		/** Makes the next work given to the gpu wait on the given binary semaphore before outputting colors, such as one signaled when a window's image can be drawn on.
+		 * The semaphore is then waited on by the next call to prepare_submission.
+		 */
+		void set_next_wait_semaphore(vulkan_handle::semaphore semaphore) noexcept
 		{
-			wait();
-			clear_syncs_unsafe();
+			_next_wait_semaphore = semaphore;
 		}
-		/** Erases all elements from the container, without waiting for them to actually be finished. */
-		void clear_syncs_unsafe()
+
+		/** Makes the next work given to the gpu wait until the given fence's work is done, such as work of a [[vulkan_upload_engine]] writing to buffers that the work reads.
+		 * The wait is on the gpu, so the cpu does not wait; it is also what makes the other work's writes visible to this work.
+		 * The next work waits for every fence given since the last work; of several fences of the same other manager, only the latest one is waited on, as it is signaled after the others.
+		 * Fences of this manager are ignored, as its work already waits on its earlier work.
+		 */
+		void wait_for(const vulkan_gpu_fence& fence)
 		{
-			_syncs_count = 0;
+			if (!fence || fence.value() == 0 || fence.vulkan_timeline() == vulkan_timeline()) return;
+
+			for (auto& dependency : _next_dependencies)
+			{
+				if (dependency.timeline != fence.vulkan_timeline()) continue;
+				if (dependency.value < fence.value()) dependency.value = fence.value();
+				return;
+			}
+			_next_dependencies.push_back(vulkan_gpu_dependency{
+				.timeline = fence.vulkan_timeline(),
+				.value = fence.value(),
+			});
 		}
 
-		/** Replaces the manager's latest synchronization-data;
-		 * the new data should be set to denote when all of the manager's programs are done.
-		 * @param signaled If true, then the sync denotes that the work has already been completed.
-		 * @return the new synchronization-data.
+		/** Prepares giving the given work to the gpu, after all of the manager's earlier work.
+		 * The work must be given to the gpu, with [[submit_programs]], before any other work of the manager is, and before the manager is waited on.
+		 * @param command The gpu-instructions to run; nullptr to only signal and wait.
+		 * @param signal_semaphore A binary semaphore to signal when the work is done, such as one waited on before displaying a window's image; nullptr to not signal one.
+		 * @param wait_stages The stages of the work that wait for the earlier work, as a VkPipelineStageFlags2; 0 for all of them. See [[vulkan_gpu_submission::wait_stages]].
 		 */
-		auto new_synchronization(bool signaled = false) noexcept -> gpu_program_sync&;
+		auto prepare_submission(vulkan_handle::command command, vulkan_handle::semaphore signal_semaphore = nullptr
+			, vulkan_handle::pipeline_stages wait_stages = 0) noexcept
+			-> vulkan_gpu_submission;
 
 	public: // vulkan-related
 		/** Returns the manager's vulkan_command_pool, representing a VkCommandPool. */
 		auto vulkan_pool() const noexcept -> vulkan_handle::command_pool { return _pool.get(); }
 
-		/** Returns the latest synchronization-object's vulkan_gpu_fence, representing a VkFence.
-		 * Returns nullptr if there are no synchronization objects.
-		 */
-		auto last_vulkan_fence() const noexcept -> vulkan_handle::fence
-		{
-			return has_sync() ? latest_synchronization()->fence.vulkan_fence() : nullptr;
-		}
-
-		/** Returns the latest synchronization-object's vulkan_gpu_semaphore, representing a VkSemaphore.
-		 * Returns nullptr if there are no synchronization objects.
-		 */
-		auto last_vulkan_semaphore() const noexcept -> vulkan_handle::semaphore
-		{
-			return has_sync() ? latest_synchronization()->semaphore.vulkan_semaphore() : nullptr;
-		}
+		/** Returns the manager's timeline semaphore, representing a VkSemaphore. */
+		auto vulkan_timeline() const noexcept -> vulkan_handle::semaphore { return _timeline->semaphore.get(); }
 
 	public: // constructors
 		/** Constructs an invalid [[vulkan_gpu_program_manager]].
@@ -175,11 +228,13 @@ namespace compwolf::vulkan
 		vulkan_gpu_program_manager(vulkan_gpu_connection&, std::size_t family_index, std::size_t thread_index);
 
 		/** Finds the best thread on the given gpu to run some programs, based on the given settings, and creates a manager on it.
+		 * Of the threads in the best family, the one with the least work that is not done yet is picked; see [[vulkan_gpu_connection::outstanding_work]].
 		 * @throws std::runtime_error if the given gpus have no threads at all to perform the given type of programs.
 		 */
 		static auto new_manager_for(vulkan_gpu_connection&, gpu_program_manager_settings)
 			-> vulkan_gpu_program_manager;
 		/** Finds the best thread on the given gpus to run some programs, based on the given settings, and creates a manager on it.
+		 * Of the threads in the best family, the one with the least work that is not done yet is picked; see [[vulkan_gpu_connection::outstanding_work]].
 		 * @throws std::runtime_error if the given gpus have no threads at all to perform the given type of programs.
 		 */
 		static auto new_manager_for(vulkan_graphics_environment&, gpu_program_manager_settings)
@@ -6,13 +6,16 @@
 
 namespace compwolf::vulkan
 {
-	/* A "semaphore", which allows synchronization between work on the gpu. */
+	/* A "semaphore", which allows synchronization between work on the gpu.
+	 * A binary semaphore is signaled and waited on once at a time; a timeline semaphore instead has a value that only ever increases, which work can wait for and signal.
+	 */
 	class vulkan_gpu_semaphore
 	{
 	private: // fields
 		vulkan_gpu_connection* _gpu{};
 		/* The vulkan_gpu_semaphore, representing a VkSemaphore. */
 		unique_deleter_ptr<vulkan_handle::semaphore_t> _vulkan_semaphore{};
+		bool _timeline{};
 
 	public: // accessors
 		/** Returns the gpu that the semaphore is on.
@@ -22,6 +25,9 @@ namespace compwolf::vulkan
 		/** Returns the gpu that the semaphore is on. */
 		auto gpu() const noexcept -> const vulkan_gpu_connection& { return *_gpu; }
 
+		/** Returns whether the semaphore is a timeline semaphore, instead of a binary semaphore. */
+		auto timeline() const noexcept -> bool { return _timeline; }
+
 		/** Returns whether this is valid, that is one not constructed by the default constructor. */
 		operator bool() const noexcept
 		{
@@ -42,9 +48,11 @@ namespace compwolf::vulkan
 		auto operator=(vulkan_gpu_semaphore&&) -> vulkan_gpu_semaphore& = default;
 
 		/* Creates a semaphore for the given gpu.
+		 * A binary semaphore is reused from the gpu's [[vulkan_object_pool]] if possible.
+		 * @param timeline Whether to create a timeline semaphore, whose value starts at 0, instead of a binary semaphore.
 		 * @throws std::runtime_error if there was an error during creation of the semaphore due to causes outside of the program.
 		 */
-		vulkan_gpu_semaphore(vulkan_gpu_connection&);
+		vulkan_gpu_semaphore(vulkan_gpu_connection&, bool timeline = false);
 	};
 }
 
@@ -0,0 +1,51 @@
+#ifndef COMPWOLF_GRAPHICS_VULKAN_COMPUTE_SHADER
+#define COMPWOLF_GRAPHICS_VULKAN_COMPUTE_SHADER
+
+#include <vulkan_graphics_environments>
+#include <shaders>
+#include "vulkan_shader_internal.hpp"
+
+namespace compwolf::vulkan
+{
+	/** A shader running general-purpose computations on the gpu, instead of drawing; in vulkan terms, a compute shader.
+	 * It has no input or output; instead, it reads and writes its fields, generally [[shader_storage_field]]s.
+	 * It is run by a [[vulkan_compute_program]].
+	 * @typeparam FieldTypes The fields that the shader has.
+	 * These must be [[type_value_pair]]s, denoting the type and position of the fields.
+	 * A field's type can be a [[shader_push_field]] or a [[shader_storage_field]].
+	 * @see shader
+	 * @see vulkan_graphics_environment
+	 */
+	template <typename... FieldTypes>
+	class vulkan_compute_shader
+		: public shader<vulkan_graphics_environment, void, void, FieldTypes...>
+	{
+		using super = shader<vulkan_graphics_environment, void, void, FieldTypes...>;
+
+	private:
+		internal::vulkan_shader_internal _internal;
+
+	public: // vulkan-specific
+		/** Returns the [[vulkan_handle::shader]] that the shader represents. */
+		auto vulkan_shader_module() const noexcept -> vulkan_handle::shader { return _internal.vulkan_shader.get(); }
+
+	public: // constructors
+		/** Constructs an invalid [[vulkan_compute_shader]].
+		 * Using this shader is undefined behaviour.
+		 * @overload
+		 */
+		vulkan_compute_shader() = default;
+		vulkan_compute_shader(vulkan_compute_shader&&) = default;
+		auto operator=(vulkan_compute_shader&&) -> vulkan_compute_shader& = default;
+
+		/** Creates a shader on the given gpu. */
+		vulkan_compute_shader(vulkan_gpu_connection& gpu
+			, const std::vector<uint32_t>& spirvCode)
+			: super(gpu)
+			, _internal(gpu, spirvCode)
+		{
+		}
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_VULKAN_COMPUTE_SHADER
@@ -0,0 +1,47 @@
+#ifndef COMPWOLF_GRAPHICS_FRAME_IN_FLIGHT
+#define COMPWOLF_GRAPHICS_FRAME_IN_FLIGHT
+
+#include <vulkan_graphics_environments>
+#include <vulkan_programs>
+
+namespace compwolf::vulkan
+{
+	/* Contains the data used to draw a frame, which the gpu may still be drawing while the cpu prepares the next frames.
+	 * A window has a fixed amount of these, independent of the amount of images in its swapchain; see [[window_settings::frames_in_flight]].
+	 */
+	class frame_in_flight
+	{
+		vulkan_gpu_program_manager _draw_manager;
+		vulkan_gpu_semaphore _acquire_semaphore;
+
+	public: // vulkan-related
+		/** Returns the [[vulkan_gpu_program_manager]] for handling drawing of the frame.
+		 * Waiting for the manager waits for the gpu to stop drawing the frame.
+		 * @customoverload
+		 */
+		auto draw_manager() const noexcept -> const vulkan_gpu_program_manager& { return _draw_manager; }
+		/** Returns the [[vulkan_gpu_program_manager]] for handling drawing of the frame.
+		 * Waiting for the manager waits for the gpu to stop drawing the frame.
+		 */
+		auto draw_manager() noexcept -> vulkan_gpu_program_manager& { return _draw_manager; }
+
+		/** Returns the binary semaphore signaled when the image that the frame draws on can be drawn on; this is invalid for an [[offscreen_target]].
+		 * It is reused once the draw manager is done with the frame, as its first work waits on it.
+		 * @customoverload
+		 */
+		auto acquire_semaphore() const noexcept -> const vulkan_gpu_semaphore& { return _acquire_semaphore; }
+		/** Returns the binary semaphore signaled when the image that the frame draws on can be drawn on; this is invalid for an [[offscreen_target]]. */
+		auto acquire_semaphore() noexcept -> vulkan_gpu_semaphore& { return _acquire_semaphore; }
+
+	public: // constructors
+		/** Constructs an invalid [[frame_in_flight]].
+		 * Using this is undefined behaviour.
+		 * @overload
+		 */
+		frame_in_flight() = default;
+		frame_in_flight(frame_in_flight&&) = default;
+		auto operator=(frame_in_flight&&) -> frame_in_flight& = default;
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_FRAME_IN_FLIGHT
@@ -0,0 +1,76 @@
+#ifndef COMPWOLF_GRAPHICS_OFFSCREEN_TARGET
+#define COMPWOLF_GRAPHICS_OFFSCREEN_TARGET
+
+#include <windows>
+#include <vulkan_graphics_environments>
+#include "vulkan_window.hpp"
+#include <vector>
+#include <cstddef>
+
+namespace compwolf::vulkan
+{
+	/** Aggregate type used by [[offscreen_target]]'s constructor to specify its behaviour.
+	 * @see offscreen_target
+	 */
+	struct offscreen_target_settings
+	{
+		/** The width and height of the images drawn onto, in pixels.
+		 * If either is 0 or less, a default size is used.
+		 */
+		int2 pixel_size;
+		/** How many frames the cpu may prepare while the gpu is still drawing earlier ones.
+		 * Each frame in flight has its own image. If 0, 2 is used.
+		 */
+		std::size_t frames_in_flight;
+		/** Whether the images should be copied to memory that the cpu can read after being drawn.
+		 * This is needed to use [[offscreen_target::read_image]], but makes each frame do more work.
+		 */
+		bool readback;
+		/** How many times per second the target's image should at most be updated. If 0, the frame rate is not limited. */
+		double target_frame_rate;
+		/** How many of the latest frames the target's frame statistics are over. If 0, 240 is used. */
+		std::size_t frame_stats_size;
+		/** How many frames there should be between each report of the target's frame statistics; 0 to not report them. */
+		std::size_t frame_stats_interval;
+	};
+
+	/** A [[vulkan_window]] that draws onto images on the gpu instead of onto an actual window.
+	 * It has no GLFW-window, surface or swapchain, so it works on machines without a display, and in a headless [[vulkan_graphics_environment]].
+	 * Cameras, brushes and drawables work with it as with any other window.
+	 * 
+	 * The images' pixels are 4 bytes each, red, green, blue and alpha, in that order.
+	 * @see vulkan_graphics_environment_settings::headless
+	 */
+	class offscreen_target : public vulkan_window
+	{
+	public: // accessors
+		/** Waits until the gpu has finished the latest image, and returns its pixels, row by row from the top.
+		 * If no image has been drawn, the pixels are undefined.
+		 * @throws std::logic_error if the target was not constructed with [[offscreen_target_settings::readback]].
+		 */
+		auto read_image() -> std::vector<std::byte>;
+
+	public: // constructors
+		/** Constructs an invalid [[offscreen_target]].
+		 * Using this is undefined behaviour.
+		 * @overload
+		 */
+		offscreen_target() = default;
+		offscreen_target(offscreen_target&&) = default;
+		auto operator=(offscreen_target&&) -> offscreen_target& = default;
+
+		/** Constructs a target on the given gpu, with the given settings.
+		 * @throws std::runtime_error if there was an error during setup due to causes outside of the program.
+		 * @overload
+		 */
+		offscreen_target(vulkan_gpu_connection& gpu, offscreen_target_settings settings);
+
+		/** Constructs a target on a gpu that can draw, with the given settings.
+		 * @throws std::runtime_error if there was an error during setup due to causes outside of the program.
+		 * @overload
+		 */
+		offscreen_target(vulkan_graphics_environment& environment, offscreen_target_settings settings);
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_OFFSCREEN_TARGET
@@ -0,0 +1,105 @@
+#ifndef COMPWOLF_GRAPHICS_PRESENT_BATCH
+#define COMPWOLF_GRAPHICS_PRESENT_BATCH
+
+#include <vulkan_graphics_environments>
+#include <vulkan_programs>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+
+namespace compwolf::vulkan
+{
+	class vulkan_window;
+
+	/** Aggregate type containing information about the latest time a [[present_batch]] was submitted.
+	 * @see present_batch
+	 */
+	struct present_batch_stats
+	{
+		/** The amount of windows whose images were displayed. */
+		std::size_t windows;
+		/** The amount of gpu-programs that were given to the gpu. */
+		std::size_t programs;
+		/** The amount of vkQueueSubmit2 calls that carried work; this is one for each queue that the work was on. */
+		std::size_t submit_calls;
+		/** The amount of vkQueuePresentKHR calls; this is one for each queue that the windows were displayed from. */
+		std::size_t present_calls;
+		/** The time it took to give the work to the gpu and display the images, not including waiting for the windows' frame pacers. */
+		std::chrono::nanoseconds submit_time;
+	};
+
+	/** Collects the gpu-work and displaying of several [[vulkan_window]]s' images, so that it can all be given to the gpu together.
+	 * Without this, each window gives its own work to the gpu and displays its own image when its image is updated.
+	 * With this, all work on the same queue is given with one vkQueueSubmit2, and all images displayed from the same queue are displayed with one vkQueuePresentKHR.
+	 * 
+	 * A batch is used by calling add() for each window, instead of the windows' update_image, and then calling submit().
+	 * The batch can then be reused for the next images.
+	 * @see vulkan_window
+	 */
+	class present_batch
+	{
+	private:
+		vulkan_graphics_environment* _environment{};
+		std::vector<vulkan_window*> _windows{};
+		submission_batch _work{};
+		present_batch_stats _stats{};
+
+	public: // accessors
+		/** Returns the environment that the batch's windows are in. */
+		auto environment() noexcept -> vulkan_graphics_environment& { return *_environment; }
+		/** Returns the environment that the batch's windows are in.
+		 * @customoverload
+		 */
+		auto environment() const noexcept -> const vulkan_graphics_environment& { return *_environment; }
+
+		/** Returns the windows that have been added since the batch was last submitted. */
+		auto windows() const noexcept -> const std::vector<vulkan_window*>& { return _windows; }
+
+		/** Returns information about the latest time the batch was submitted. */
+		auto stats() const noexcept -> const present_batch_stats& { return _stats; }
+
+		/** Returns whether this is valid, that is one not constructed by the default constructor. */
+		operator bool() const noexcept
+		{
+			return !!_environment;
+		}
+
+	public: // modifiers
+		/** Draws the given window's next image, but waits until submit() before giving the gpu-work to the gpu and displaying the image.
+		 * A window must not be added more than once before submit().
+		 * @throws std::runtime_error if there was an error getting the window's next image due to causes outside of the program.
+		 */
+		void add(vulkan_window&);
+
+		/** Should be called by those drawing a window's image, such as [[vulkan_camera]], for gpu-work that is part of the batch.
+		 * @see window_draw_parameters::batch
+		 */
+		void add(vulkan_gpu_submission submission)
+		{
+			_work.add(submission);
+		}
+
+		/** Gives all of the added gpu-work to the gpu and displays all of the added windows' images.
+		 * Afterwards waits for the windows' [[frame_pacer]]s, and then empties the batch so that it can be reused.
+		 * @throws std::runtime_error if there was an error submitting the work to the gpu due to causes outside of the program.
+		 * The batch is still emptied, so that the next submit() does not display the windows again.
+		 */
+		void submit();
+
+	public: // constructors
+		/** Constructs an invalid [[present_batch]].
+		 * Using this is undefined behaviour.
+		 * @overload
+		 */
+		present_batch() noexcept = default;
+		present_batch(present_batch&&) = default;
+		auto operator=(present_batch&&) -> present_batch& = default;
+
+		/** Constructs an empty batch for windows in the given environment. */
+		explicit present_batch(vulkan_graphics_environment& environment) noexcept
+			: _environment(&environment)
+		{}
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_PRESENT_BATCH
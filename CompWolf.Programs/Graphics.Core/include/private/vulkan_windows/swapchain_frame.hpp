@@ -2,16 +2,26 @@
 #define COMPWOLF_GRAPHICS_SWAPCHAIN_FRAME
 
 #include <vulkan_graphics_environments>
+#include <vulkan_gpu_buffers>
 #include <vulkan_programs>
+#include <optional>
+#include <cstddef>
 
 namespace compwolf::vulkan
 {
-	/* Contains data about an actual image that is being drawn before being displayed on a window. */
+	/* Contains data about an actual image that is being drawn before being displayed on a window.
+	 * The image is drawn by one of the window's [[frame_in_flight]]s.
+	 */
 	class swapchain_frame
 	{
+		vulkan_handle::image _swapchain_image;
+		unique_deleter_ptr<vulkan_handle::memory_t> _owned_image_memory;
+		unique_deleter_ptr<vulkan_handle::image_t> _owned_image;
+		internal::vulkan_gpu_buffer_internal _readback_buffer;
 		unique_deleter_ptr<vulkan_handle::image_view_t> _image;
 		unique_deleter_ptr<vulkan_handle::frame_buffer_t> _frame_buffer;
-		vulkan_gpu_program_manager _draw_manager;
+		std::optional<std::size_t> _last_frame_in_flight;
+		vulkan_gpu_semaphore _present_semaphore;
 
 	public: // vulkan-related
 		/** Returns the frame's image_view, representing a VkImageView. */
@@ -19,19 +29,47 @@ namespace compwolf::vulkan
 		/** Returns the frame's image_view, representing a VkImageView. */
 		auto image_ptr() noexcept -> unique_deleter_ptr<vulkan_handle::image_view_t>& { return _image; }
 
-		/** Returns the frame's frame_buffer, representing a VkFramebuffer. */
+		/** Returns the frame's image, representing a VkImage; it is owned by the swapchain. */
+		auto swapchain_image() const noexcept -> vulkan_handle::image { return _swapchain_image; }
+		/** Returns the frame's image, representing a VkImage; it is owned by the swapchain. */
+		auto swapchain_image_ref() noexcept -> vulkan_handle::image& { return _swapchain_image; }
+
+		/** Returns the frame's image, representing a VkImage, if it is owned by the frame itself, as for [[offscreen_target]]s; otherwise null. */
+		auto owned_image_ptr() noexcept -> unique_deleter_ptr<vulkan_handle::image_t>& { return _owned_image; }
+		/** Returns the memory of owned_image_ptr(), representing a VkDeviceMemory. */
+		auto owned_image_memory_ptr() noexcept -> unique_deleter_ptr<vulkan_handle::memory_t>& { return _owned_image_memory; }
+
+		/** Returns the buffer that the image is copied to after being drawn, so that the cpu can read it.
+		 * This is only valid for [[offscreen_target]]s with [[offscreen_target_settings::readback]].
+		 * @customoverload
+		 */
+		auto readback_buffer() const noexcept -> const internal::vulkan_gpu_buffer_internal& { return _readback_buffer; }
+		/** Returns the buffer that the image is copied to after being drawn, so that the cpu can read it. */
+		auto readback_buffer() noexcept -> internal::vulkan_gpu_buffer_internal& { return _readback_buffer; }
+
+		/** Returns the frame's frame_buffer, representing a VkFramebuffer.
+		 * This is null if the gpu uses dynamic rendering; see [[vulkan_gpu_connection::uses_dynamic_rendering]].
+		 */
 		auto frame_buffer() const noexcept -> vulkan_handle::frame_buffer
 			{ return _frame_buffer.get(); }
 		/** Returns the frame's frame_buffer, representing a VkFramebuffer. */
 		auto frame_buffer_ptr() noexcept -> unique_deleter_ptr<vulkan_handle::frame_buffer_t>&
 			{ return _frame_buffer; }
 
-		/** Returns the [[vulkan_gpu_program_manager]] for handling drawing on the frame.
+		/** Returns the index, in [[window_swapchain::frames_in_flight]], of the frame in flight that last drew on the image; or std::nullopt if none has.
+		 * The image must not be drawn on again before that frame in flight is done.
+		 */
+		auto last_frame_in_flight() const noexcept -> std::optional<std::size_t> { return _last_frame_in_flight; }
+		/** Returns the index, in [[window_swapchain::frames_in_flight]], of the frame in flight that last drew on the image; or std::nullopt if none has. */
+		auto last_frame_in_flight_ref() noexcept -> std::optional<std::size_t>& { return _last_frame_in_flight; }
+
+		/** Returns the binary semaphore signaled when the image is done being drawn, which displaying the image waits on; this is invalid for an [[offscreen_target]].
+		 * It is kept per image, as it is only known to be waited on once the image can be drawn on again.
 		 * @customoverload
 		 */
-		auto draw_manager() const noexcept -> const vulkan_gpu_program_manager& { return _draw_manager; }
-		/** Returns the [[vulkan_gpu_program_manager]] for handling drawing on the frame. */
-		auto draw_manager() noexcept -> vulkan_gpu_program_manager& { return _draw_manager; }
+		auto present_semaphore() const noexcept -> const vulkan_gpu_semaphore& { return _present_semaphore; }
+		/** Returns the binary semaphore signaled when the image is done being drawn, which displaying the image waits on; this is invalid for an [[offscreen_target]]. */
+		auto present_semaphore() noexcept -> vulkan_gpu_semaphore& { return _present_semaphore; }
 
 	public: // constructors
 		/** Constructs an invalid [[swapchain_frame]].
@@ -4,7 +4,11 @@
 #include <windows>
 #include <vulkan_programs>
 #include "vulkan_window.hpp"
+#include "vulkan_draw_fields.hpp"
+#include "vulkan_draw_culling.hpp"
 #include <vector>
+#include <functional>
+#include <optional>
 #include <cstddef>
 
 namespace compwolf::vulkan
@@ -25,6 +29,22 @@ namespace compwolf::vulkan
 		const swapchain_frame* frame;
 		/** The index of the window's frame in [[window_swapchain::frames]]. */
 		std::size_t frame_index;
+		/** The index in [[window_swapchain::frames_in_flight]] of the frame in flight drawing the frame.
+		 * Data that the gpu uses while drawing should be kept per frame in flight, and picked with this.
+		 */
+		std::size_t frame_in_flight_index;
+		/** The buffer that drawables should write their push fields into, and draw with the returned slot as their first instance.
+		 * @see vulkan_draw_fields
+		 */
+		vulkan_draw_fields* draw_fields;
+		/** The culling that drawables should draw through, or nullptr if the camera does not use [[window_camera_settings::gpu_culling]].
+		 * @see vulkan_draw_culling
+		 */
+		vulkan_draw_culling* culling;
+		/** Set to true by drawing-code whose gpu-instructions will change without the camera knowing, like a drawable whose brush is still being prepared.
+		 * The camera then records its instructions again on the next frame, instead of reusing these.
+		 */
+		bool* record_again;
 	};
 
 	/** Vulkan implementation of [[window_camera]].
@@ -32,27 +52,138 @@ namespace compwolf::vulkan
 	 */
 	class vulkan_camera : public window_camera<vulkan_window>
 	{
-		std::vector<vulkan_gpu_program> _draw_programs;
+		vulkan_gpu_profiler _profiler;
+		event_key<const gpu_frame_timings&> _frame_timed_key;
+
+		/** The instructions drawing the camera onto one of the window's frames, from one of its frames in flight. */
+		struct draw_program
+		{
+			vulkan_gpu_program program;
+			/** The camera's _changes when the program was recorded. */
+			std::size_t changes{};
+			/** The gpu's [[vulkan_gpu_connection::push_data_changes]] when the program was recorded. */
+			std::size_t push_data_changes{};
+			/** Whether the drawing-code asked to be recorded again; see [[vulkan_draw_code_parameters::record_again]]. */
+			bool record_again{};
+		};
+		/** The programs for each frame in flight, each having one for every frame of the window. */
+		std::vector<draw_program> _draw_programs;
+		/** The amount of changes to what the camera draws, like drawing-code being added. */
+		std::size_t _changes{};
+		std::size_t _record_count{};
+
 		event<const vulkan_draw_code_parameters&> _drawing_code;
+		std::size_t _draw_code_count{};
 		event_key<> _drawing_key;
 
+		internal::vulkan_draw_fields_sets _draw_field_sets;
+		std::vector<vulkan_draw_fields> _draw_fields;
+
+		internal::vulkan_draw_culling_pipeline _culling_pipeline;
+		std::vector<vulkan_draw_culling> _culling;
+
+		/** What the drawing-code does when the camera invokes it. */
+		enum class draw_code_pass
+		{
+			/** Draw, without checking whether the drawable is inside the camera. */
+			draw,
+			/** Add the drawable's bounds to _culler, without drawing. */
+			collect_bounds,
+			/** Draw, if _culler has found the drawable to be inside the camera. */
+			draw_visible,
+		};
+		draw_code_pass _draw_code_pass{};
+		draw_culler _culler;
+
+		/** Records the instructions drawing the given frame into the given program. */
+		void record_draw_program(draw_program&, const window_draw_parameters&);
+
 	public:
 		/** The key used to identify some drawing-code added to a camera with [[vulkan_camera::add_draw_code]]. */
 		using draw_code_key = event<const vulkan_draw_code_parameters&>::key_type;
 
+	public: // accessors
+		/** Returns how many drawables the cpu drew and skipped, for being outside of the camera, the latest time the camera recorded its gpu-instructions.
+		 * This is not updated on frames where the gpu decides what to draw, as by [[window_camera_settings::gpu_culling]].
+		 */
+		auto cull_stats() const noexcept -> draw_cull_stats { return _culler.stats(); }
+
+		/** Returns how many times the camera has recorded its gpu-instructions.
+		 * The instructions of each of the window's frames are reused until what the camera draws changes; see [[vulkan_camera::mark_changed]].
+		 */
+		auto record_count() const noexcept -> std::size_t { return _record_count; }
+
+		/** Returns the profiler timing the camera's drawing on the gpu, as set by [[window_camera_settings::gpu_timing]].
+		 * Subscribe to its [[vulkan_gpu_profiler::frame_timed]] to get the times of each frame.
+		 * This is invalid if the camera's drawing is not timed.
+		 */
+		auto gpu_profiler() noexcept -> vulkan_gpu_profiler& { return _profiler; }
+		/** Returns the profiler timing the camera's drawing on the gpu, as set by [[window_camera_settings::gpu_timing]].
+		 * This is invalid if the camera's drawing is not timed.
+		 * @customoverload
+		 */
+		auto gpu_profiler() const noexcept -> const vulkan_gpu_profiler& { return _profiler; }
+
+		/** Returns the culling used by the given frame in flight of the window, when the gpu decides what to draw, as by [[window_camera_settings::gpu_culling]].
+		 * This is invalid if the camera does not use gpu-culling, which is also the case if the gpu cannot give indirect draws a first instance; see [[vulkan_gpu_connection::supports_draw_indirect_first_instance]].
+		 * @see vulkan_draw_culling::stats
+		 */
+		auto frame_culling(std::size_t frame_in_flight_index) const noexcept -> const vulkan_draw_culling& { return _culling[frame_in_flight_index]; }
+
 	public: // modifiers
+		/** Makes the camera record its gpu-instructions again before drawing its next frames, instead of reusing the ones recorded earlier.
+		 * This is done automatically when drawing-code is added or removed, and when a [[gpu_buffer_usage::push_field]]-buffer is changed.
+		 * It should be called for other changes to what the drawing-code records, like a drawable's bounds changing along with its vertices.
+		 */
+		void mark_changed() noexcept { ++_changes; }
+
 		/** Adds the given gpu code to be run when the window's camera is being updated.
+		 * @param bounds Returns the area of the window that the code draws onto, if known.
+		 * The code is not run on frames where the area is outside of the camera.
 		 * @return a key used to identify the piece of code.
 		 */
-		auto add_draw_code(std::function<void(const vulkan_draw_code_parameters&)> code) -> draw_code_key
+		auto add_draw_code(std::function<void(const vulkan_draw_code_parameters&)> code
+			, std::function<std::optional<draw_bounds>()> bounds = {}
+		) -> draw_code_key
 		{
-			_draw_programs.clear();
-			return _drawing_code.subscribe(code);
+			mark_changed();
+			++_draw_code_count;
+			return _drawing_code.subscribe(
+				[this, code = std::move(code), bounds = std::move(bounds)](const vulkan_draw_code_parameters& args)
+				{
+					switch (_draw_code_pass)
+					{
+					case draw_code_pass::collect_bounds:
+					{
+						std::optional<draw_bounds> area;
+						if (bounds) area = bounds();
+
+						if (area) _culler.add(*area);
+						else _culler.add_unbounded();
+						return;
+					}
+					case draw_code_pass::draw_visible:
+						if (!_culler.next_visible()) return;
+						break;
+					default: break;
+					}
+
+					if (args.culling) args.culling->next_code();
+					if (args.profiler && gpu_timing() == camera_gpu_timing::drawables)
+					{
+						auto scope = args.profiler->begin_scope("drawable");
+						code(args);
+						args.profiler->end_scope(scope);
+					}
+					else code(args);
+				}
+			);
 		}
 		/** Removes the given gpu code from being run when the window's camera is being updated. */
 		void remove_draw_code(draw_code_key code) noexcept
 		{
-			_draw_programs.clear();
+			mark_changed();
+			--_draw_code_count;
 			return _drawing_code.unsubscribe(std::move(code));
 		}
 
@@ -73,7 +204,9 @@ namespace compwolf::vulkan
 		vulkan_camera(vulkan_camera&&) = default;
 		auto operator=(vulkan_camera&&)->vulkan_camera & = default;
 
-		/** Constructs a camera for the given [[vulkan_window]], with the given settings. */
+		/** Constructs a camera for the given [[vulkan_window]], with the given settings.
+		 * @throws std::runtime_error if there was an error during setup due to causes outside of the program.
+		 */
 		vulkan_camera(vulkan_window& window, window_camera_settings settings);
 	};
 }
@@ -0,0 +1,197 @@
+#ifndef COMPWOLF_GRAPHICS_VULKAN_DRAW_CULLING
+#define COMPWOLF_GRAPHICS_VULKAN_DRAW_CULLING
+
+#include <windows>
+#include <vulkan_graphics_environments>
+#include <vulkan_gpu_buffers>
+#include <vulkan_shaders>
+#include <vulkan_programs>
+#include <gpu_structs>
+#include <unique_deleter_ptr>
+#include <algorithm>
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace compwolf::vulkan
+{
+	namespace internal
+	{
+		/** The gpu-objects used by [[vulkan_draw_culling]] that can be shared between a camera's frames.
+		 * @hidden
+		 */
+		class vulkan_draw_culling_pipeline
+		{
+		public:
+			vulkan_shader_internal shader{};
+			unique_deleter_ptr<vulkan_handle::descriptor_set_layout_t> vulkan_descriptor_set_layout{};
+			unique_deleter_ptr<vulkan_handle::pipeline_layout_t> vulkan_pipeline_layout{};
+			unique_deleter_ptr<vulkan_handle::pipeline_t> vulkan_pipeline{};
+
+			unique_deleter_ptr<vulkan_handle::descriptor_pool_t> vulkan_descriptor_pool{};
+			/** Descriptor sets do not need to be cleaned up explicitly; they are cleaned up when the pool is cleaned up. */
+			std::vector<vulkan_handle::descriptor_set> vulkan_descriptor_set{};
+
+		public: // constructors
+			/** Constructs an invalid [[vulkan_draw_culling_pipeline]].
+			 * Using this is undefined behaviour.
+			 * @overload
+			 */
+			vulkan_draw_culling_pipeline() = default;
+			vulkan_draw_culling_pipeline(vulkan_draw_culling_pipeline&&) = default;
+			auto operator=(vulkan_draw_culling_pipeline&&) -> vulkan_draw_culling_pipeline& = default;
+
+			/** Creates the compute pipeline on the given gpu, with a descriptor set for each of the given amount of frames.
+			 * @throws std::runtime_error if there was an error during setup due to causes outside of the program.
+			 */
+			vulkan_draw_culling_pipeline(vulkan_gpu_connection& gpu, std::size_t frame_count);
+		};
+	}
+
+	/** Aggregate type containing the state that a drawable sets before drawing through a [[vulkan_draw_culling]].
+	 * Drawables with the same state draw the same way apart from their bounds and push fields, which are read from [[vulkan_draw_fields]], so they can be drawn together.
+	 */
+	struct vulkan_draw_state
+	{
+		/** The pipeline that the drawable is drawn with. */
+		vulkan_handle::pipeline pipeline;
+		/** The buffer containing the drawable's vertices. */
+		vulkan_handle::buffer vertex_buffer;
+		/** The buffer containing the indices of the drawable's vertices. */
+		vulkan_handle::buffer vertex_index_buffer;
+		/** The buffers of the drawable's fields, which are null for push fields.
+		 * This refers to the drawable's own memory, so the drawable must exist until its camera is done recording.
+		 */
+		std::span<const vulkan_handle::buffer> field_buffers;
+
+		auto operator==(const vulkan_draw_state& other) const noexcept -> bool
+		{
+			return pipeline == other.pipeline
+				&& vertex_buffer == other.vertex_buffer
+				&& vertex_index_buffer == other.vertex_index_buffer
+				&& std::ranges::equal(field_buffers, other.field_buffers);
+		}
+	};
+
+	/** Lets the gpu decide which of a camera's drawables to actually draw on a frame, by comparing their [[draw_bounds]] with the camera's.
+	 * Each drawable is given a slot in a storage buffer, which a compute shader turns into a VkDrawIndexedIndirectCommand.
+	 * A drawable outside of the camera is therefore skipped by the gpu, without the cpu having to check it.
+	 * The command's first instance is the drawable's slot in the camera's [[vulkan_draw_fields]], so its shaders find its push fields through gl_InstanceIndex.
+	 *
+	 * Drawables one after another with the same [[vulkan_draw_state]] form a group, whose visible drawables the shader packs together and counts;
+	 * the whole group is then drawn by a single vkCmdDrawIndexedIndirectCount, recorded where the group's first drawable is drawn.
+	 * If the gpu cannot draw several commands with it, each drawable is drawn by its own vkCmdDrawIndexedIndirect instead, whose command has no instances if the drawable is culled.
+	 *
+	 * Each of a camera's frames has its own [[vulkan_draw_culling]], as the buffers must not be changed while the gpu uses them.
+	 * @see vulkan_camera
+	 */
+	class vulkan_draw_culling
+	{
+		vulkan_gpu_connection* _gpu{};
+		vulkan_handle::descriptor_set _descriptor_set{};
+
+		internal::vulkan_gpu_buffer_internal _inputs{};
+		internal::vulkan_gpu_buffer_internal _commands{};
+		internal::vulkan_gpu_buffer_internal _counts{};
+		/** The cpu-memory of the buffers, which are kept mapped for as long as the buffers exist. */
+		void* _input_data{};
+		void* _command_data{};
+		void* _count_data{};
+
+		std::size_t _capacity{};
+		std::size_t _draw_count{};
+		std::size_t _needed_capacity{};
+
+		/** Whether drawables with the same state are drawn together; see [[vulkan_draw_culling]]. */
+		bool _groups_drawables{};
+		std::size_t _group_count{};
+		/** Whether later drawables can join the latest group, as in whether it was given a state. */
+		bool _group_joinable{};
+		vulkan_draw_state _group_state{};
+		std::size_t _group_first{};
+		std::size_t _group_size{};
+		/** The value of _code_count when the latest drawable of the group was drawn. */
+		std::size_t _group_code{};
+		std::size_t _code_count{};
+		std::size_t _indirect_draw_count{};
+
+	public: // accessors
+		/** Returns the amount of drawables that can be culled by the gpu, before the buffers must grow. */
+		auto capacity() const noexcept -> std::size_t { return _capacity; }
+		/** Returns the amount of drawables given to [[vulkan_draw_culling::draw_indexed]] since [[vulkan_draw_culling::begin]]. */
+		auto draw_count() const noexcept -> std::size_t { return _draw_count; }
+		/** Returns the amount of indirect draws recorded since [[vulkan_draw_culling::begin]], which is the amount of groups if drawables are drawn together. */
+		auto indirect_draw_count() const noexcept -> std::size_t { return _indirect_draw_count; }
+		/** Returns whether more drawables were given to [[vulkan_draw_culling::draw_indexed]] since [[vulkan_draw_culling::begin]] than fit in the buffers.
+		 * The buffers then grow when the frame is recorded again, so it should be.
+		 */
+		auto outgrown() const noexcept -> bool { return _needed_capacity > _capacity; }
+
+		/** Returns how many of the drawables culled by the gpu were drawn and skipped.
+		 * This reads what the gpu decided, so it is only meaningful once the frame's gpu-instructions are done, and until the frame is recorded again.
+		 * Drawables drawn directly, for not fitting in the buffers, are not included.
+		 */
+		auto stats() const noexcept -> draw_cull_stats;
+
+	public: // vulkan-specific
+		/** Records the compute shader culling the frame's drawables.
+		 * This must be recorded outside of a render pass, and before the drawables call [[vulkan_draw_culling::draw_indexed]].
+		 * @param barriers The program's barriers, which the culling's buffers are used through.
+		 * Any uses already given to it are flushed along with the barrier before the shader.
+		 * @param draw_count The amount of drawables expected to be drawn; the buffers grow to fit at least this many.
+		 * @throws std::runtime_error if there was an error while growing the buffers due to causes outside of the program.
+		 */
+		void begin(vulkan_handle::command
+			, vulkan_barrier_batch& barriers
+			, const internal::vulkan_draw_culling_pipeline&
+			, draw_bounds camera_bounds
+			, std::size_t draw_count
+		);
+		/** Records drawing the currently bound vertices, if the given bounds are visible to the camera.
+		 * Should be called inside a render pass, after [[vulkan_draw_culling::begin]].
+		 * If there are more drawables than fit in the buffers, the drawable is drawn directly instead, and the buffers grow for the next frame.
+		 * @param instance The drawable's slot in [[vulkan_draw_fields]], which is drawn as its first instance.
+		 */
+		void draw_indexed(vulkan_handle::command, shader_int vertex_index_count, draw_bounds bounds, uint32_t instance);
+		/** Records drawing the currently bound vertices like draw_indexed(command, vertex_index_count, bounds, instance), starting a group of drawables with the given state.
+		 * Later drawables with the same state can then join the group with [[vulkan_draw_culling::draw_in_group]], instead of setting their state and drawing.
+		 */
+		void draw_indexed(vulkan_handle::command, shader_int vertex_index_count, draw_bounds bounds, uint32_t instance, const vulkan_draw_state& state);
+		/** Adds a drawable with the given state to the latest group, if it has the same state and was started by the drawing-code right before this one.
+		 * The drawable is then drawn by the group's draw, so nothing more is recorded for it.
+		 * @return whether the drawable was added; if not, it must set its state and call draw_indexed.
+		 */
+		auto draw_in_group(const vulkan_draw_state&, shader_int vertex_index_count, draw_bounds bounds, uint32_t instance) -> bool;
+		/** Tells the culling that the camera is about to run the next drawing-code.
+		 * A group is ended by any drawing-code that does not join it, as that code may have recorded instructions that must be drawn after the group.
+		 */
+		void next_code() noexcept { ++_code_count; }
+		/** Finishes the frame's culling, after which the gpu-instructions can be run.
+		 * The instructions can be run again on later frames without being recorded again, as long as the drawables and their bounds have not changed.
+		 */
+		void end() noexcept;
+
+	private:
+		/** Writes the given drawable to the next slot of the input buffer, as part of the given group. */
+		void add_input(shader_int vertex_index_count, draw_bounds bounds, uint32_t instance, std::size_t group, std::size_t first_command) noexcept;
+		/** Returns the most drawables that a group starting at the given slot can have. */
+		auto max_group_size(std::size_t first_command) const noexcept -> std::size_t;
+
+	public: // constructors
+		/** Constructs an invalid [[vulkan_draw_culling]].
+		 * Using this is undefined behaviour.
+		 * @overload
+		 */
+		vulkan_draw_culling() = default;
+		vulkan_draw_culling(vulkan_draw_culling&&) = default;
+		auto operator=(vulkan_draw_culling&&) -> vulkan_draw_culling& = default;
+
+		/** Constructs culling for a frame, using the given descriptor set from a [[internal::vulkan_draw_culling_pipeline]]. */
+		vulkan_draw_culling(vulkan_gpu_connection& gpu, vulkan_handle::descriptor_set descriptor_set) noexcept
+			: _gpu(&gpu), _descriptor_set(descriptor_set)
+		{}
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_VULKAN_DRAW_CULLING
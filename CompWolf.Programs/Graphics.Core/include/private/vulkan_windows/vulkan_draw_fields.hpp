@@ -0,0 +1,128 @@
+#ifndef COMPWOLF_GRAPHICS_VULKAN_DRAW_FIELDS
+#define COMPWOLF_GRAPHICS_VULKAN_DRAW_FIELDS
+
+#include <vulkan_graphics_environments>
+#include <vulkan_gpu_buffers>
+#include <unique_deleter_ptr>
+#include <optional>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace compwolf::vulkan
+{
+	namespace internal
+	{
+		/** Creates the descriptor set layout of [[vulkan_draw_fields]]' buffer, which is set 1 of every brush' pipeline layout.
+		 * Layouts created by this are identical, so a set allocated with one can be used with the pipelines of any brush.
+		 * @throws std::runtime_error if there was an error during creation due to causes outside of the program.
+		 * @hidden
+		 */
+		auto new_draw_fields_layout(vulkan_gpu_connection& gpu) -> unique_deleter_ptr<vulkan_handle::descriptor_set_layout_t>;
+
+		/** The gpu-objects used by [[vulkan_draw_fields]] that can be shared between a camera's frames.
+		 * @hidden
+		 */
+		class vulkan_draw_fields_sets
+		{
+		public:
+			unique_deleter_ptr<vulkan_handle::descriptor_set_layout_t> vulkan_descriptor_set_layout{};
+			unique_deleter_ptr<vulkan_handle::descriptor_pool_t> vulkan_descriptor_pool{};
+			/** Descriptor sets do not need to be cleaned up explicitly; they are cleaned up when the pool is cleaned up. */
+			std::vector<vulkan_handle::descriptor_set> vulkan_descriptor_set{};
+
+		public: // constructors
+			/** Constructs an invalid [[vulkan_draw_fields_sets]].
+			 * Using this is undefined behaviour.
+			 * @overload
+			 */
+			vulkan_draw_fields_sets() = default;
+			vulkan_draw_fields_sets(vulkan_draw_fields_sets&&) = default;
+			auto operator=(vulkan_draw_fields_sets&&) -> vulkan_draw_fields_sets& = default;
+
+			/** Creates a descriptor set for each of the given amount of frames.
+			 * @throws std::runtime_error if there was an error during setup due to causes outside of the program.
+			 */
+			vulkan_draw_fields_sets(vulkan_gpu_connection& gpu, std::size_t frame_count);
+		};
+	}
+
+	/** A storage buffer containing the push fields of each drawable that a camera draws on a frame.
+	 * Drawables do not push their push fields into the gpu-instructions, so that drawables with different push fields can be drawn by a single draw, as by [[vulkan_draw_culling]].
+	 * Instead, each drawable is given a slot of [[vulkan_draw_fields::slot_size]] bytes, containing its push fields laid out as described by [[shader_push_field]],
+	 * and is drawn with the slot's index as its first instance.
+	 *
+	 * The buffer is bound as set 1, binding 0, so a brush' shaders read a drawable's push fields with something like the following, where the fragment shader is given the index by the vertex shader:
+	 * layout(std430, set = 1, binding = 0) readonly buffer DrawFields { vec4 drawFields[]; };
+	 * ...
+	 * vec4 firstFields = drawFields[gl_InstanceIndex * 8];
+	 *
+	 * Each of a camera's frames has its own [[vulkan_draw_fields]], as the buffer must not be changed while the gpu uses it.
+	 * @see vulkan_camera
+	 */
+	class vulkan_draw_fields
+	{
+		vulkan_gpu_connection* _gpu{};
+		vulkan_handle::descriptor_set _descriptor_set{};
+
+		internal::vulkan_gpu_buffer_internal _fields{};
+		/** The cpu-memory of the buffer, which is kept mapped for as long as the buffer exists. */
+		void* _field_data{};
+
+		std::size_t _capacity{};
+		std::size_t _draw_count{};
+		std::size_t _needed_capacity{};
+
+	public: // accessors
+		/** The size, in bytes, of each drawable's slot in the buffer; this is the most that a brush' push fields can take up together. */
+		static constexpr std::size_t slot_size = 128;
+
+		/** Returns the amount of drawables that fit in the buffer, before it must grow. */
+		auto capacity() const noexcept -> std::size_t { return _capacity; }
+		/** Returns the amount of drawables given to [[vulkan_draw_fields::add]] since [[vulkan_draw_fields::begin]]. */
+		auto draw_count() const noexcept -> std::size_t { return _draw_count; }
+		/** Returns whether more drawables were given to [[vulkan_draw_fields::add]] since [[vulkan_draw_fields::begin]] than fit in the buffer.
+		 * The buffer then grows when the frame is recorded again, so it should be.
+		 */
+		auto outgrown() const noexcept -> bool { return _needed_capacity > _capacity; }
+
+	public: // vulkan-specific
+		/** Returns the [[vulkan_handle::descriptor_set]] that the buffer is bound through. */
+		auto vulkan_descriptor_set() const noexcept -> vulkan_handle::descriptor_set { return _descriptor_set; }
+
+		/** Prepares the buffer for the frame's drawables to be added.
+		 * @param draw_count The amount of drawables expected to be drawn; the buffer grows to fit at least this many.
+		 * @throws std::runtime_error if there was an error while growing the buffer due to causes outside of the program.
+		 */
+		void begin(std::size_t draw_count);
+		/** Writes the given push fields into the next slot.
+		 * @param field_push_data The cpu-memory of each push field; the elements for other fields are ignored.
+		 * @param field_is_push_field Whether each field is a push field.
+		 * @param field_push_offsets The offset of each push field in the slot.
+		 * @param field_sizes The size of each field.
+		 * @return The index of the slot, which the drawable should be drawn with as its first instance;
+		 * nullopt if the slot does not fit in the buffer, in which case the drawable should not be drawn, and the buffer grows for the next frame.
+		 */
+		auto add(const void* const* field_push_data
+			, const std::vector<bool>& field_is_push_field
+			, const std::vector<std::size_t>& field_push_offsets
+			, const std::vector<std::size_t>& field_sizes
+		) noexcept -> std::optional<uint32_t>;
+
+	public: // constructors
+		/** Constructs an invalid [[vulkan_draw_fields]].
+		 * Using this is undefined behaviour.
+		 * @overload
+		 */
+		vulkan_draw_fields() = default;
+		vulkan_draw_fields(vulkan_draw_fields&&) = default;
+		auto operator=(vulkan_draw_fields&&) -> vulkan_draw_fields& = default;
+
+		/** Constructs the buffer for a frame, using the given descriptor set from a [[internal::vulkan_draw_fields_sets]]. */
+		vulkan_draw_fields(vulkan_gpu_connection& gpu, vulkan_handle::descriptor_set descriptor_set) noexcept
+			: _gpu(&gpu), _descriptor_set(descriptor_set)
+		{}
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_VULKAN_DRAW_FIELDS
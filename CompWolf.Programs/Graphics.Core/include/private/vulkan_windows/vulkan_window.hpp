@@ -7,6 +7,9 @@
 #include "window_surface.hpp"
 #include "window_swapchain.hpp"
 #include <vulkan_programs>
+#include <chrono>
+#include <optional>
+#include <vector>
 
 namespace compwolf::vulkan
 {
@@ -19,11 +22,16 @@ namespace compwolf::vulkan
 		unique_deleter_ptr<vulkan_handle::glfw_window_t> _glfw_window;
 		window_surface _surface;
 		window_swapchain _swapchain;
+		compwolf::frame_pacer _frame_pacer;
+		compwolf::frame_stats _frame_stats;
+		std::chrono::steady_clock::time_point _last_frame_start{};
+		/** For each frame in flight, the summed gpu-time of its latest frame that its cameras have reported so far. */
+		std::vector<std::optional<std::chrono::nanoseconds>> _gpu_frame_times{};
 
 		event<const window_draw_parameters&> _drawing;
 
 	public: // vulkan-related
-		/** Returns the surface's [[vulkan_handle::glfw_window]], representing a GLFWwindow-pointer. */
+		/** Returns the surface's [[vulkan_handle::glfw_window]], representing a GLFWwindow-pointer; this is null for an [[offscreen_target]]. */
 		auto glfw_window() const noexcept -> vulkan_handle::glfw_window { return _glfw_window.get(); }
 
 		/** Returns the surface of the window, as in the actual area that can display a dynamic image. */
@@ -36,10 +44,26 @@ namespace compwolf::vulkan
 		/** Returns the swapchain of the window, as in the actual images that are being drawn before being displaying on the window. */
 		auto swapchain() const noexcept -> const window_swapchain& { return _swapchain; }
 
+		/** Returns the pacer that keeps the window from updating its image more often than [[window_settings::target_frame_rate]]. */
+		auto frame_pacer() noexcept -> compwolf::frame_pacer& { return _frame_pacer; }
+		/** Returns the pacer that keeps the window from updating its image more often than [[window_settings::target_frame_rate]]. */
+		auto frame_pacer() const noexcept -> const compwolf::frame_pacer& { return _frame_pacer; }
+
+		/** Returns the times of the window's latest frames, and statistics about them.
+		 * A frame's times are added when the next frame starts.
+		 * @see window_settings::frame_stats_size
+		 */
+		auto frame_stats() noexcept -> compwolf::frame_stats& { return _frame_stats; }
+		/** Returns the times of the window's latest frames, and statistics about them.
+		 * A frame's times are added when the next frame starts.
+		 * @see window_settings::frame_stats_size
+		 */
+		auto frame_stats() const noexcept -> const compwolf::frame_stats& { return _frame_stats; }
+
 		/** Returns whether this is valid, that is one not constructed by the default constructor. */
 		operator bool() const noexcept
 		{
-			return !!_glfw_window;
+			return !!_swapchain;
 		}
 
 		/** Returns an event invoked when the image is being drawn. */
@@ -61,6 +85,13 @@ namespace compwolf::vulkan
 
 	private:
 		vulkan_window(vulkan_graphics_environment*, vulkan_gpu_connection*, window_settings settings);
+	protected:
+		/** Should be called by [[offscreen_target]].
+		 * Constructs a window that draws onto images on the gpu instead of onto an actual window, on the given gpu or environment.
+		 * @param readback Whether the images should be copied to memory that the cpu can read after being drawn.
+		 * @throws std::runtime_error if there was an error during setup due to causes outside of the program.
+		 */
+		vulkan_window(vulkan_graphics_environment*, vulkan_gpu_connection*, window_settings settings, bool readback);
 	public:
 		/** Constructs a window on the given gpu, with the given settings.
 		 * @throws std::runtime_error if there was an error during setup due to causes outside of the program.
@@ -80,6 +111,22 @@ namespace compwolf::vulkan
 			: vulkan_window(&environment, nullptr, settings)
 		{}
 
+	private:
+		/** Gets the window's next frame and invokes drawing() for it. */
+		void draw_next_frame(present_batch*);
+	public: // modifiers
+		/** Should be called by [[present_batch]].
+		 * Draws the window's next image like update_image(), but adds the gpu-work and displaying of the image to the given batch instead of doing them right away.
+		 * Unlike update_image(), this does not wait for the window's [[frame_pacer]]; the batch does so after it has displayed the images.
+		 */
+		void update_image(present_batch&);
+
+		/** Should be called by [[vulkan_camera]] when it knows how long the gpu spent drawing it on a frame.
+		 * The times of all of the cameras drawing the same frame are summed, so that [[frame_stats]] gets a single [[frame_metric::gpu_frame_time]] for each frame.
+		 * The sum is added once the frame in flight has drawn its next frame, as the cameras read their times while drawing it.
+		 */
+		void add_gpu_frame_time(std::size_t frame_in_flight_index, std::chrono::nanoseconds);
+
 	public: // compwolf::window
 		/** Makes the window update what is shown on it. */
 		void update_image() final;
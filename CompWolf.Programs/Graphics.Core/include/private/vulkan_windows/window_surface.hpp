@@ -20,7 +20,8 @@ namespace compwolf::vulkan
 
 		unique_deleter_ptr<vulkan_handle::surface_t> _vulkan_surface{};
 		unique_deleter_ptr<vulkan_handle::surface_format_info_t> _format{};
-		unique_deleter_ptr<vulkan_handle::render_pass_t> _render_pass{};
+		/** Owned by the gpu; see [[vulkan_gpu_connection::vulkan_render_pass]]. */
+		vulkan_handle::render_pass _render_pass{};
 
 	public: // accessors
 		/** Returns the gpu that the window is on.
@@ -30,19 +31,27 @@ namespace compwolf::vulkan
 		/** Returns the gpu that the window is on. */
 		auto gpu() const noexcept -> const vulkan_gpu_connection& { return *_gpu; }
 
+		/** Returns whether the surface belongs to an [[offscreen_target]], and so is not displayed anywhere. */
+		auto offscreen() const noexcept -> bool { return !_vulkan_surface; }
+
 		/** Returns whether this is valid, that is one not constructed by the default constructor. */
 		operator bool() const noexcept
 		{
-			return !!_render_pass;
+			return !!_format;
 		}
 
 	public: // vulkan-related
-		/** Returns the surface's [[vulkan_handle::surface]], representing a VkSurfaceKHR. */
+		/** Returns the surface's [[vulkan_handle::surface]], representing a VkSurfaceKHR; this is null for an [[offscreen_target]]. */
 		auto vulkan_surface() const noexcept -> vulkan_handle::surface { return _vulkan_surface.get(); }
 		/** Returns the surface's [[vulkan_handle::surface_format_handle]]-pointer. */
 		auto vulkan_format() const noexcept -> vulkan_handle::surface_format_info { return _format.get(); }
-		/** Returns the surface's [[vulkan_handle::render_pass]], representing a VkRenderPass. */
-		auto vulkan_render_pass() const noexcept -> vulkan_handle::render_pass { return _render_pass.get(); }
+		/** Returns the format of the surface's images, representing a VkFormat. */
+		auto vulkan_image_format() const noexcept -> vulkan_handle::format;
+		/** Returns the surface's [[vulkan_handle::render_pass]], representing a VkRenderPass.
+		 * This is shared with other windows on the same gpu with the same format.
+		 * This is null if the gpu uses dynamic rendering; see [[vulkan_gpu_connection::uses_dynamic_rendering]].
+		 */
+		auto vulkan_render_pass() const noexcept -> vulkan_handle::render_pass { return _render_pass; }
 
 	public: // constructor
 		/** Constructs an invalid [[window_surface]].
@@ -56,6 +65,12 @@ namespace compwolf::vulkan
 		/** Should be called by [[vulkan_window]]. */
 		window_surface(vulkan_graphics_environment*, vulkan_gpu_connection*,
 			window_settings&, vulkan_handle::glfw_window);
+
+		/** Should be called by [[vulkan_window]] for an [[offscreen_target]].
+		 * Constructs a surface that is not displayed anywhere, on the given gpu, or on any gpu that can draw if none is given.
+		 * @throws std::runtime_error if there is no gpu that can draw.
+		 */
+		window_surface(vulkan_graphics_environment*, vulkan_gpu_connection*);
 	};
 }
 
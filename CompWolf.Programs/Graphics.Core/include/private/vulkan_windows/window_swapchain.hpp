@@ -4,15 +4,18 @@
 #include <windows>
 #include <vulkan_graphics_environments>
 #include "swapchain_frame.hpp"
+#include "frame_in_flight.hpp"
 #include "window_surface.hpp"
 #include <unique_deleter_ptr>
 #include <events>
 #include <vector>
+#include <chrono>
 #include <cstddef>
 
 namespace compwolf::vulkan
 {
 	class vulkan_window;
+	class present_batch;
 	/** Arguments for vulkan_window::drawing. */
 	struct window_draw_parameters
 	{
@@ -22,6 +25,12 @@ namespace compwolf::vulkan
 		swapchain_frame* target_frame;
 		/** The index of the frame that is being drawn. */
 		std::size_t target_frame_index;
+		/** The frame in flight that draws the frame; data used by the gpu while drawing should be kept per frame in flight. */
+		frame_in_flight* target_frame_in_flight;
+		/** The index of the frame in flight that draws the frame. */
+		std::size_t target_frame_in_flight_index;
+		/** The batch that the frame's gpu-work should be added to instead of being given to the gpu right away; nullptr if the frame is not drawn as part of a batch. */
+		present_batch* batch;
 	};
 
 	/** The swapchain of a window, as in the actual images that are being drawn and shown on a window.
@@ -35,8 +44,18 @@ namespace compwolf::vulkan
 		unique_deleter_ptr<vulkan_handle::swapchain_t> _vulkan_swapchain{};
 		std::vector<swapchain_frame> _frames{};
 		std::size_t _current_frame_index{};
+		std::vector<frame_in_flight> _frames_in_flight{};
+		std::size_t _current_frame_in_flight_index{};
+		std::chrono::nanoseconds _frame_wait_time{};
+		std::chrono::nanoseconds _acquire_wait_time{};
+		std::chrono::nanoseconds _fence_wait_time{};
+		std::chrono::nanoseconds _present_wait_time{};
+		std::chrono::steady_clock::time_point _acquire_time{};
+		std::chrono::nanoseconds _acquire_to_present_latency{};
 
-		gpu_program_sync _temp_sync;
+		/** For an [[offscreen_target]], the work done after drawing each frame in flight, instead of displaying the frame. */
+		std::vector<vulkan_gpu_program> _offscreen_programs{};
+		bool _readback{};
 
 	public: // accessors
 		/** Returns the gpu that the window is on.
@@ -59,18 +78,71 @@ namespace compwolf::vulkan
 		/** Returns information about the image on the swapchain that is currently being drawn. */
 		auto current_frame() const noexcept -> const swapchain_frame& { return frames()[current_frame_index()]; }
 
+		/** Returns the data used to draw frames while the gpu may still be drawing earlier ones. */
+		auto frames_in_flight() noexcept -> std::vector<frame_in_flight>& { return _frames_in_flight; }
+		/** Returns the data used to draw frames while the gpu may still be drawing earlier ones. */
+		auto frames_in_flight() const noexcept -> const std::vector<frame_in_flight>& { return _frames_in_flight; }
+
+		/** Returns the index in frames_in_flight() that current_frame_in_flight() is at. */
+		auto current_frame_in_flight_index() const noexcept -> std::size_t { return _current_frame_in_flight_index; }
+
+		/** Returns the frame in flight that is drawing the current frame. */
+		auto current_frame_in_flight() noexcept -> frame_in_flight& { return frames_in_flight()[current_frame_in_flight_index()]; }
+		/** Returns the frame in flight that is drawing the current frame. */
+		auto current_frame_in_flight() const noexcept -> const frame_in_flight& { return frames_in_flight()[current_frame_in_flight_index()]; }
+
+		/** Returns how long the cpu waited for the gpu the last time it made a new frame the current one.
+		 * When this is close to 0, the cpu and gpu work at the same time.
+		 */
+		auto frame_wait_time() const noexcept -> std::chrono::nanoseconds { return _frame_wait_time; }
+		/** Returns how much of frame_wait_time() was spent getting the image to draw onto. */
+		auto acquire_wait_time() const noexcept -> std::chrono::nanoseconds { return _acquire_wait_time; }
+		/** Returns how much of frame_wait_time() was spent waiting for the gpu to be done with earlier frames. */
+		auto fence_wait_time() const noexcept -> std::chrono::nanoseconds { return _fence_wait_time; }
+
+		/** Returns how long the cpu waited the last time it made the window display a frame. */
+		auto present_wait_time() const noexcept -> std::chrono::nanoseconds { return _present_wait_time; }
+
+		/** Returns how long it took, on the latest frame, from the current frame being gotten to it being sent to be displayed.
+		 * This is the part of the latency between input and display that is spent drawing.
+		 */
+		auto acquire_to_present_latency() const noexcept -> std::chrono::nanoseconds { return _acquire_to_present_latency; }
+
+		/** Returns whether the swapchain belongs to an [[offscreen_target]], and so draws onto images on the gpu that are not displayed. */
+		auto offscreen() const noexcept -> bool { return !_vulkan_swapchain; }
+
+		/** Returns whether the images are copied to memory that the cpu can read after being drawn.
+		 * This is only possible for an [[offscreen_target]]; see [[offscreen_target_settings::readback]].
+		 */
+		auto readback() const noexcept -> bool { return _readback; }
+
 		/** Returns whether this is valid, that is one not constructed by the default constructor. */
 		operator bool() const noexcept
 		{
-			return !!_vulkan_swapchain;
+			return !_frames.empty();
 		}
 
 	public: // modifiers
-		/** Makes the window display the current frame, and makes a new frame the current one. */
+		/** Makes a new frame the current one, waiting until the gpu is done with the data used to draw it. */
 		void to_next_frame();
 
+		/** Makes the window display the current frame, once the gpu is done drawing it. */
+		void present();
+
+		/** Should be called by [[present_batch]] after the current frame has been drawn, before displaying it.
+		 * Returns the work done after the frame is drawn, which must then be given to the gpu.
+		 * For a window, this signals [[swapchain_frame::present_semaphore]]; for an [[offscreen_target]], it copies the frame to [[swapchain_frame::readback_buffer]] if there is one.
+		 */
+		auto prepare_present() -> vulkan_gpu_submission;
+
+		/** Should be called by [[present_batch]] right after it has made the window display the current frame.
+		 * present() calls this itself.
+		 * @param present_wait How long the cpu waited while making the window display the frame.
+		 */
+		void mark_presented(std::chrono::nanoseconds present_wait) noexcept;
+
 	public: // vulkan-related
-		/** Returns the swapchain's vulkan_swapchain, representing a VkSwapchainKHR. */
+		/** Returns the swapchain's vulkan_swapchain, representing a VkSwapchainKHR; this is null for an [[offscreen_target]]. */
 		auto vulkan_swapchain() const noexcept -> vulkan_handle::swapchain { return _vulkan_swapchain.get(); }
 
 	public: // constructors
@@ -85,6 +157,13 @@ namespace compwolf::vulkan
 		/** Should be called by [[vulkan_window]]. */
 		window_swapchain(window_settings&,
 			vulkan_handle::glfw_window, window_surface&);
+
+		/** Should be called by [[vulkan_window]] for an [[offscreen_target]].
+		 * Constructs a swapchain drawing onto images on the gpu, one for each frame in flight, instead of onto images that are displayed.
+		 * @param readback Whether the images should be copied to memory that the cpu can read after being drawn.
+		 * @throws std::runtime_error if there was an error during setup due to causes outside of the program.
+		 */
+		window_swapchain(window_settings&, window_surface&, bool readback);
 	};
 }
 
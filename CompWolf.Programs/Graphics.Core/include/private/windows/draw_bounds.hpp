@@ -0,0 +1,29 @@
+#ifndef COMPWOLF_GRAPHICS_DRAW_BOUNDS
+#define COMPWOLF_GRAPHICS_DRAW_BOUNDS
+
+#include <dimensions>
+
+namespace compwolf
+{
+	/** Aggregate type representing an axis-aligned rectangle on a window, like the area that something is drawn onto.
+	 * The rectangle is in the coordinates that drawables are drawn in;
+	 * x goes from -1 at the window's left border to 1 at its right border,
+	 * and y goes from -1 at the window's top border to 1 at its bottom border.
+	 */
+	struct draw_bounds
+	{
+		/** The rectangle's left and top border. */
+		float2 min;
+		/** The rectangle's right and bottom border. */
+		float2 max;
+
+		/** Returns whether the rectangle and the given rectangle share any area, including only touching each other. */
+		constexpr auto overlaps(const draw_bounds& other) const noexcept -> bool
+		{
+			return min.x() <= other.max.x() && other.min.x() <= max.x()
+				&& min.y() <= other.max.y() && other.min.y() <= max.y();
+		}
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_DRAW_BOUNDS
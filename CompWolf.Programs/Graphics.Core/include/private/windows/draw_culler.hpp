@@ -0,0 +1,72 @@
+#ifndef COMPWOLF_GRAPHICS_DRAW_CULLER
+#define COMPWOLF_GRAPHICS_DRAW_CULLER
+
+#include "draw_bounds.hpp"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace compwolf
+{
+	/** Aggregate type containing how many drawables a camera drew and skipped on a frame.
+	 * @see draw_culler
+	 */
+	struct draw_cull_stats
+	{
+		/** The amount of drawables that were checked. */
+		std::size_t total;
+		/** The amount of drawables that were inside the camera, and so were drawn. */
+		std::size_t visible;
+		/** The amount of drawables that were outside the camera, and so were not drawn. */
+		std::size_t culled;
+	};
+
+	/** Decides which of a camera's drawables are inside of the camera, so that the rest are not drawn.
+	 * The drawables' [[draw_bounds]] are added one after another, and then all checked at once by [[draw_culler::cull]].
+	 * The bounds are kept as separate arrays of each border, so that several drawables are checked with each SIMD-instruction.
+	 */
+	class draw_culler
+	{
+		std::vector<float> _min_x{};
+		std::vector<float> _min_y{};
+		std::vector<float> _max_x{};
+		std::vector<float> _max_y{};
+		std::vector<std::uint8_t> _visible{};
+		std::size_t _next{};
+
+		draw_cull_stats _stats{};
+
+	public: // accessors
+		/** Returns the amount of drawables added since [[draw_culler::clear]]. */
+		auto size() const noexcept -> std::size_t { return _min_x.size(); }
+
+		/** Returns whether the drawable with the given index, in the order they were added, is inside of the camera.
+		 * Must only be called after [[draw_culler::cull]].
+		 */
+		auto visible(std::size_t index) const noexcept -> bool { return _visible[index] != 0; }
+
+		/** Returns how many drawables were drawn and skipped, as of the last call to [[draw_culler::cull]]. */
+		auto stats() const noexcept -> draw_cull_stats { return _stats; }
+
+	public: // modifiers
+		/** Removes all added drawables, so that a new frame can be culled. */
+		void clear() noexcept;
+
+		/** Adds a drawable covering the given area. */
+		void add(draw_bounds bounds);
+		/** Adds a drawable whose area is unknown, which is therefore always considered inside of the camera. */
+		void add_unbounded();
+
+		/** Checks which of the added drawables overlap the given area of the camera.
+		 * @return How many drawables were drawn and skipped.
+		 */
+		auto cull(draw_bounds camera_bounds) -> draw_cull_stats;
+
+		/** Returns whether the next drawable is inside the camera, going through the drawables in the order they were added.
+		 * Must only be called after [[draw_culler::cull]], and at most once per added drawable.
+		 */
+		auto next_visible() noexcept -> bool { return _visible[_next++] != 0; }
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_DRAW_CULLER
@@ -0,0 +1,61 @@
+#ifndef COMPWOLF_GRAPHICS_FRAME_PACER
+#define COMPWOLF_GRAPHICS_FRAME_PACER
+
+#include <chrono>
+
+namespace compwolf
+{
+	/** Keeps a window from updating its image more often than a target frame rate.
+	 * Each frame is scheduled a fixed time after the previous one; if a frame is late, the schedule starts over from it instead of trying to catch up.
+	 * @see window_settings::target_frame_rate
+	 */
+	class frame_pacer
+	{
+	public:
+		/** The clock that the pacer schedules frames with. */
+		using clock = std::chrono::steady_clock;
+
+	private:
+		std::chrono::nanoseconds _frame_duration{};
+		clock::time_point _next_frame{};
+		std::chrono::nanoseconds _last_wait_time{};
+
+	public: // accessors
+		/** Returns how long there should at least be between frames; 0 if the frame rate is not limited. */
+		auto frame_duration() const noexcept -> std::chrono::nanoseconds { return _frame_duration; }
+
+		/** Returns when the next frame is scheduled to start. */
+		auto next_frame() const noexcept -> clock::time_point { return _next_frame; }
+
+		/** Returns how long the latest call to [[frame_pacer::wait]] waited. */
+		auto last_wait_time() const noexcept -> std::chrono::nanoseconds { return _last_wait_time; }
+
+	public: // modifiers
+		/** Sets how many frames there should at most be per second; 0 to not limit the frame rate. */
+		void set_target_frame_rate(double frames_per_second) noexcept;
+
+		/** Schedules the next frame, as if the current time is the given time.
+		 * @return How long to wait before the next frame should start.
+		 */
+		auto schedule(clock::time_point now) noexcept -> std::chrono::nanoseconds;
+
+		/** Waits until the next frame should start.
+		 * @return How long was waited.
+		 */
+		auto wait() -> std::chrono::nanoseconds;
+
+	public: // constructors
+		/** Constructs a pacer that does not limit the frame rate.
+		 * @overload
+		 */
+		frame_pacer() noexcept = default;
+
+		/** Constructs a pacer limiting the frame rate to the given amount of frames per second; 0 to not limit the frame rate. */
+		explicit frame_pacer(double frames_per_second) noexcept
+		{
+			set_target_frame_rate(frames_per_second);
+		}
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_FRAME_PACER
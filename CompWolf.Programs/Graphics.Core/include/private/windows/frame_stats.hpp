@@ -0,0 +1,146 @@
+#ifndef COMPWOLF_GRAPHICS_FRAME_STATS
+#define COMPWOLF_GRAPHICS_FRAME_STATS
+
+#include <events>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace compwolf
+{
+	/** Something about a frame that [[frame_stats]] keeps track of. */
+	enum class frame_metric
+	{
+		/** The time on the cpu from the start of a frame to the start of the next one. */
+		cpu_frame_time,
+		/** The time that the gpu spent drawing a frame. This is only known when it is timed, like with [[window_camera_settings::gpu_timing]]. */
+		gpu_frame_time,
+		/** The time that the cpu waited to get the image to draw a frame onto. */
+		acquire_wait,
+		/** The time that the cpu waited while a frame was being given to be displayed. */
+		present_wait,
+		/** The time that the cpu waited for the gpu to be done with earlier frames, before it could reuse their data. */
+		fence_wait,
+	};
+	/** The amount of values in [[frame_metric]]. */
+	constexpr std::size_t frame_metric_count = 5;
+
+	/** Aggregate type containing statistics about a [[frame_metric]] over the latest frames.
+	 * @see frame_stats
+	 */
+	struct frame_time_summary
+	{
+		/** The amount of frames that the statistics are over; 0 if nothing is known about the metric. */
+		std::size_t samples;
+		/** The average time. */
+		std::chrono::nanoseconds mean;
+		/** The median time; half of the frames took at most this long. */
+		std::chrono::nanoseconds p50;
+		/** 95 percent of the frames took at most this long. */
+		std::chrono::nanoseconds p95;
+		/** 99 percent of the frames took at most this long; this shows stutter that the mean hides. */
+		std::chrono::nanoseconds p99;
+		/** The longest time. */
+		std::chrono::nanoseconds max;
+	};
+
+	/** Aggregate type containing statistics about each [[frame_metric]] over the latest frames.
+	 * @see frame_stats
+	 */
+	struct frame_stats_report
+	{
+		/** The amount of frames that had been recorded when the report was made. */
+		std::size_t frame_count;
+		/** @see frame_metric::cpu_frame_time */
+		frame_time_summary cpu_frame_time;
+		/** @see frame_metric::gpu_frame_time */
+		frame_time_summary gpu_frame_time;
+		/** @see frame_metric::acquire_wait */
+		frame_time_summary acquire_wait;
+		/** @see frame_metric::present_wait */
+		frame_time_summary present_wait;
+		/** @see frame_metric::fence_wait */
+		frame_time_summary fence_wait;
+	};
+
+	/** Keeps the times of a window's latest frames, and statistics about them.
+	 * Each [[frame_metric]] is kept separately, as some are only known some frames later.
+	 * @see window_settings::frame_stats_size
+	 */
+	class frame_stats
+	{
+		/** The latest times of a single metric, as a ring buffer. */
+		struct metric_samples
+		{
+			std::vector<std::chrono::nanoseconds> samples;
+			/** The index in samples that the next time is put at. */
+			std::size_t next;
+		};
+
+		std::size_t _capacity{};
+		std::array<metric_samples, frame_metric_count> _metrics{};
+		std::size_t _frame_count{};
+
+		std::size_t _report_interval{};
+		std::size_t _frames_since_report{};
+		event<const frame_stats_report&> _reported;
+
+		mutable std::vector<std::chrono::nanoseconds> _sorted;
+
+	public: // accessors
+		/** Returns how many of the latest frames the statistics are over. */
+		auto capacity() const noexcept -> std::size_t { return _capacity; }
+
+		/** Returns how many frames have been recorded with end_frame. */
+		auto frame_count() const noexcept -> std::size_t { return _frame_count; }
+
+		/** Returns how many frames there are between each invocation of reported(); 0 if it is never invoked. */
+		auto report_interval() const noexcept -> std::size_t { return _report_interval; }
+
+		/** Returns the latest times of the given metric, from oldest to newest. */
+		auto samples(frame_metric) const -> std::vector<std::chrono::nanoseconds>;
+
+		/** Returns statistics about the given metric over the latest frames. */
+		auto summary(frame_metric) const -> frame_time_summary;
+
+		/** Returns statistics about each metric over the latest frames. */
+		auto report() const -> frame_stats_report;
+
+		/** Event invoked with report() every report_interval() frames. */
+		auto reported() const noexcept -> const event<const frame_stats_report&>& { return _reported; }
+
+	public: // modifiers
+		/** Adds a time to the given metric, replacing its oldest time if there already are capacity() times. */
+		void add(frame_metric, std::chrono::nanoseconds) noexcept;
+
+		/** Should be called when a frame is done; invokes reported() if it is time to. */
+		void end_frame();
+
+		/** Sets how many frames there should be between each invocation of reported(); 0 to never invoke it. */
+		void set_report_interval(std::size_t frames) noexcept
+		{
+			_report_interval = frames;
+			_frames_since_report = 0;
+		}
+
+		/** Removes all times. */
+		void clear() noexcept;
+
+	public: // constructors
+		/** Constructs stats over the latest 240 frames, which are never reported.
+		 * @overload
+		 */
+		frame_stats() : frame_stats(240) {}
+		frame_stats(frame_stats&&) = default;
+		auto operator=(frame_stats&&) -> frame_stats& = default;
+
+		/** Constructs stats over the given amount of latest frames, reported every given amount of frames.
+		 * @param capacity How many of the latest frames the statistics are over. If 0, 240 is used.
+		 * @param report_interval How many frames there should be between each invocation of reported(); 0 to never invoke it.
+		 */
+		explicit frame_stats(std::size_t capacity, std::size_t report_interval = 0);
+	};
+}
+
+#endif // ! COMPWOLF_GRAPHICS_FRAME_STATS
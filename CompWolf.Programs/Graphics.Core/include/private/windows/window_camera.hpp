@@ -2,11 +2,25 @@
 #define COMPWOLF_GRAPHICS_WINDOW_CAMERA
 
 #include "window_settings.hpp"
+#include "draw_bounds.hpp"
 #include <dimensions>
 #include <events>
 
 namespace compwolf
 {
+	/** How much of a camera's drawing the gpu should time.
+	 * @see window_camera_settings
+	 */
+	enum class camera_gpu_timing
+	{
+		/** Nothing is timed. */
+		none,
+		/** The camera's frames, and the parts of them done by the camera itself, are timed. */
+		passes,
+		/** Like passes, but each drawable is also timed. This makes drawing many drawables slower. */
+		drawables,
+	};
+
 	struct window_camera_settings
 	{
 		/** How far towards the window's left border that the camera will be displayed.
@@ -28,6 +42,18 @@ namespace compwolf
 
 		/** The color the camera displays where there is nothing */
 		float3 background_color;
+
+		/** Whether the gpu, instead of the cpu, should decide which drawables are inside the camera and so should be drawn.
+		 * This makes drawing many objects cheaper for the cpu, but requires the gpu to be able to run computations.
+		 * An implementation may still let the cpu decide, if the gpu cannot do what the culling needs.
+		 */
+		bool gpu_culling = false;
+
+		/** How much of the camera's drawing the gpu should time.
+		 * The times are reported by the camera's implementation, some frames after they were drawn.
+		 * The time of each whole frame is also added to the window's frame statistics.
+		 */
+		camera_gpu_timing gpu_timing = camera_gpu_timing::none;
 	};
 
 	/** A rectangular part of a window that you can actually draw onto.
@@ -48,6 +74,9 @@ namespace compwolf
 		/** The color the camera displays where there is nothing */
 		float3 _background_color{};
 
+		bool _gpu_culling{};
+		camera_gpu_timing _gpu_timing{};
+
 		event_key<> _window_destructing_key{};
 
 	public: // accessors
@@ -82,6 +111,23 @@ namespace compwolf
 		/** The color the camera displays where there is nothing */
 		auto background_color() const noexcept -> float3 { return _background_color; }
 
+		/** Returns the area of the window that the camera is displayed on.
+		 * @see draw_bounds
+		 */
+		auto bounds() const noexcept -> draw_bounds
+		{
+			return draw_bounds{
+				.min = { -screen_left(), -screen_top() },
+				.max = { screen_right(), screen_bottom() },
+			};
+		}
+
+		/** Whether the gpu, instead of the cpu, decides which drawables are inside the camera and so should be drawn. */
+		auto gpu_culling() const noexcept -> bool { return _gpu_culling; }
+
+		/** How much of the camera's drawing the gpu times. */
+		auto gpu_timing() const noexcept -> camera_gpu_timing { return _gpu_timing; }
+
 	protected: // modifiers
 		/** Sets this camera to a default-constructed camera. */
 		virtual void destruct() noexcept
@@ -105,6 +151,8 @@ namespace compwolf
 			, _left(settings.screen_left), _right(settings.screen_right)
 			, _top(settings.screen_top), _bottom(settings.screen_bottom)
 			, _background_color(settings.background_color)
+			, _gpu_culling(settings.gpu_culling)
+			, _gpu_timing(settings.gpu_timing)
 			, _window_destructing_key(window.destructing().subscribe([this]()
 				{
 					destruct();
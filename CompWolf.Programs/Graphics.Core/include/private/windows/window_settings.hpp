@@ -3,9 +3,30 @@
 
 #include <string_view>
 #include <dimensions>
+#include <cstddef>
 
 namespace compwolf
 {
+	/* How a window's images are shown on the screen. */
+	enum class present_policy
+	{
+		/* Uses mailbox if the window's gpu supports it, and otherwise fifo. */
+		automatic,
+		/* Images are shown in the order they are drawn, each waiting for the screen to refresh.
+		 * This prevents tearing, but limits the frame rate to the screen's refresh rate.
+		 * This is supported everywhere, and is used if the window's gpu does not support the requested policy.
+		 */
+		fifo,
+		/* Like fifo, except that an image that is late for a screen refresh is shown at once, possibly with tearing. */
+		fifo_relaxed,
+		/* Images are shown at the screen's refresh, but newer images replace older ones waiting to be shown.
+		 * This prevents tearing, without limiting the frame rate.
+		 */
+		mailbox,
+		/* Images are shown as soon as they are drawn, possibly with tearing. This gives the lowest latency. */
+		immediate,
+	};
+
 	/* Aggregate type used by window's constructor to specify its behaviour. */
 	struct window_settings
 	{
@@ -17,6 +38,22 @@ namespace compwolf
 		 * This size does not include any border around the window.
 		 */
 		int2 pixel_size;
+		/* How many frames the cpu may prepare while the gpu is still drawing earlier ones.
+		 * More frames lets the cpu and gpu work at the same time, at the cost of memory and of latency between input and display.
+		 * This is independent of how many images the window actually has. If 0, 2 is used.
+		 */
+		std::size_t frames_in_flight;
+		/* How the window's images are shown on the screen. */
+		present_policy present;
+		/* How many times per second the window's image should at most be updated.
+		 * The window waits right before the input for the next frame is gotten, so that the input is as fresh as possible when drawn.
+		 * If 0, the frame rate is not limited.
+		 */
+		double target_frame_rate;
+		/* How many of the latest frames the window's frame statistics are over. If 0, 240 is used. */
+		std::size_t frame_stats_size;
+		/* How many frames there should be between each report of the window's frame statistics; 0 to not report them. */
+		std::size_t frame_stats_interval;
 	};
 }
 
@@ -2,11 +2,18 @@
 
 layout(location = 0) in vec2 inPosition;
 
-layout(binding = 0) uniform TransformObject {
-    vec2 position;
-    vec2 scale;
-} transform;
+// Each drawable's push fields, at the drawable's instance; see vulkan_draw_fields.
+layout(std430, set = 1, binding = 0) readonly buffer DrawFields {
+    vec4 drawFields[];
+};
+
+layout(location = 0) flat out uint drawIndex;
 
 void main() {
-    gl_Position = vec4(inPosition * transform.scale + transform.position, 0.0, 1.0);
+    vec4 transform = drawFields[gl_InstanceIndex * 8];
+    vec2 position = transform.xy;
+    vec2 scale = transform.zw;
+
+    gl_Position = vec4(inPosition * scale + position, 0.0, 1.0);
+    drawIndex = gl_InstanceIndex;
 }
\ No newline at end of file
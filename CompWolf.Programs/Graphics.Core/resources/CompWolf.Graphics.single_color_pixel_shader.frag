@@ -1,11 +1,15 @@
 #version 450
 
-layout(binding = 4) uniform ColorObject {
-    vec3 color;
-} colorObject;
+// Each drawable's push fields, at the drawable's instance; see vulkan_draw_fields.
+layout(std430, set = 1, binding = 0) readonly buffer DrawFields {
+    vec4 drawFields[];
+};
+
+layout(location = 0) flat in uint drawIndex;
 
 layout(location = 0) out vec4 outColor;
 
 void main() {
-    outColor = vec4(colorObject.color, 1);
+    vec3 color = drawFields[drawIndex * 8 + 1].xyz;
+    outColor = vec4(color, 1);
 }
\ No newline at end of file
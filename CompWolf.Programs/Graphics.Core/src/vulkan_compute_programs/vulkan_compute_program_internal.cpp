@@ -0,0 +1,299 @@
+#include <private/vulkan_compute_programs/vulkan_compute_program_internal.hpp>
+
+#include "compwolf_vulkan.hpp"
+#include <stdexcept>
+#include <chrono>
+#include <vector>
+
+namespace compwolf::vulkan::internal
+{
+	/******************************** vulkan-specific ********************************/
+
+	void vulkan_compute_program_internal::record(vulkan_gpu_connection& gpu
+		, const vulkan_code_parameters& args
+		, const vulkan_compute_program_info& info
+		, const vulkan_handle::buffer* field_buffers
+		, const void* const* field_push_data
+		, std::array<uint32_t, 3> group_count
+	) const
+	{
+		auto& field_indices = *info.field_indices;
+		auto command = to_vulkan(args.command);
+		auto logicDevice = to_vulkan(gpu.vulkan_device());
+		auto vkPipelineLayout = to_vulkan(vulkan_pipeline_layout.get());
+		auto descriptorSet = to_vulkan(vulkan_descriptor_set);
+
+		vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_COMPUTE, to_vulkan(vulkan_pipeline.get()));
+
+		std::vector<VkDescriptorBufferInfo> bufferInfos;
+		std::vector<VkWriteDescriptorSet> writers;
+		bufferInfos.reserve(field_indices.size());
+		writers.reserve(field_indices.size());
+		for (std::size_t i = 0; i < field_indices.size(); ++i)
+		{
+			if (info.field_is_push_field[i])
+			{
+				vkCmdPushConstants(command, vkPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT
+					, static_cast<uint32_t>(info.field_push_offsets[i])
+					, static_cast<uint32_t>(info.field_sizes[i])
+					, field_push_data[i]
+				);
+				continue;
+			}
+
+			auto& bufferInfo = bufferInfos.emplace_back(VkDescriptorBufferInfo{
+				.buffer = to_vulkan(field_buffers[i]),
+				.offset = 0,
+				.range = VK_WHOLE_SIZE,
+			});
+			writers.emplace_back(VkWriteDescriptorSet{
+				.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+				.dstSet = descriptorSet,
+				.dstBinding = static_cast<uint32_t>(field_indices[i]),
+				.dstArrayElement = 0,
+				.descriptorCount = 1,
+				.descriptorType = info.field_is_storage_field[i]
+					? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+					: VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+				.pBufferInfo = &bufferInfo,
+			});
+		}
+		if (!writers.empty())
+		{
+			vkUpdateDescriptorSets(logicDevice, static_cast<uint32_t>(writers.size()), writers.data(), 0, nullptr);
+			vkCmdBindDescriptorSets(command
+				, VK_PIPELINE_BIND_POINT_COMPUTE
+				, vkPipelineLayout
+				, 0
+				, 1
+				, &descriptorSet
+				, 0
+				, nullptr
+			);
+		}
+
+		// The shader writes the storage fields, which later uses must wait for.
+		for (std::size_t i = 0; i < field_indices.size(); ++i)
+		{
+			if (!info.field_is_storage_field[i]) continue;
+			args.barriers->use(field_buffers[i], vulkan_resource_access::compute_shader_write);
+		}
+		args.barriers->flush();
+
+		vkCmdDispatch(command, group_count[0], group_count[1], group_count[2]);
+
+		// The storage fields are host-visible, so the cpu may read them once the program is done.
+		for (std::size_t i = 0; i < field_indices.size(); ++i)
+		{
+			if (!info.field_is_storage_field[i]) continue;
+			args.barriers->use(field_buffers[i], vulkan_resource_access::host_read);
+		}
+		args.barriers->flush();
+	}
+
+	/******************************** constructors ********************************/
+
+	vulkan_compute_program_internal::vulkan_compute_program_internal(vulkan_gpu_connection& gpu
+		, const vulkan_compute_program_info& info
+		, vulkan_handle::shader shader
+	) {
+		auto logicDevice = to_vulkan(gpu.vulkan_device());
+		auto deletion_queue = &gpu.deletion_queue();
+
+		uint32_t uniformCount = 0;
+		uint32_t storageCount = 0;
+		VkDescriptorSetLayout descriptorSetLayout;
+		{
+			std::vector<VkDescriptorSetLayoutBinding> bindings;
+			bindings.reserve(info.field_indices->size());
+			for (std::size_t i = 0; i < info.field_indices->size(); ++i)
+			{
+				if (info.field_is_push_field[i]) continue;
+
+				bool is_storage = info.field_is_storage_field[i];
+				++(is_storage ? storageCount : uniformCount);
+				bindings.emplace_back(VkDescriptorSetLayoutBinding{
+					.binding = static_cast<uint32_t>(info.field_indices->at(i)),
+					.descriptorType = is_storage
+						? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+						: VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+					.descriptorCount = 1,
+					.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+				});
+			}
+
+			VkDescriptorSetLayoutCreateInfo createInfo{
+				.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+				.bindingCount = static_cast<uint32_t>(bindings.size()),
+				.pBindings = bindings.data(),
+			};
+
+			auto result = vkCreateDescriptorSetLayout(logicDevice, &createInfo, nullptr, &descriptorSetLayout);
+
+			switch (result)
+			{
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not create a compute program's descriptor set layout on the GPU: ")
+					throw std::runtime_error(message);
+			}
+
+			vulkan_descriptor_set_layout = unique_deleter_ptr<vulkan_handle::descriptor_set_layout_t>(from_vulkan(descriptorSetLayout),
+				[logicDevice](vulkan_handle::descriptor_set_layout l)
+				{
+					vkDestroyDescriptorSetLayout(logicDevice, to_vulkan(l), nullptr);
+				}
+			);
+		}
+
+		VkPipelineLayout pipelineLayout;
+		{
+			VkPushConstantRange pushRange{
+				.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+				.offset = 0,
+				.size = static_cast<uint32_t>(info.field_push_offsets.back()),
+			};
+
+			VkPipelineLayoutCreateInfo createInfo{
+				.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+				.setLayoutCount = 1,
+				.pSetLayouts = &descriptorSetLayout,
+				.pushConstantRangeCount = (pushRange.size == 0)
+					? static_cast<uint32_t>(0)
+					: static_cast<uint32_t>(1),
+				.pPushConstantRanges = &pushRange,
+			};
+
+			auto result = vkCreatePipelineLayout(logicDevice, &createInfo, nullptr, &pipelineLayout);
+
+			switch (result)
+			{
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not create a compute program's pipeline layout on the GPU: ")
+					throw std::runtime_error(message);
+			}
+
+			vulkan_pipeline_layout = unique_deleter_ptr<vulkan_handle::pipeline_layout_t>(from_vulkan(pipelineLayout),
+				[logicDevice](vulkan_handle::pipeline_layout l)
+				{
+					vkDestroyPipelineLayout(logicDevice, to_vulkan(l), nullptr);
+				}
+			);
+		}
+
+		{
+			VkComputePipelineCreateInfo createInfo{
+				.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+				.stage = {
+					.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+					.stage = VK_SHADER_STAGE_COMPUTE_BIT,
+					.module = to_vulkan(shader),
+					.pName = "main",
+				},
+				.layout = pipelineLayout,
+				.basePipelineHandle = nullptr,
+				.basePipelineIndex = -1,
+			};
+
+			VkPipeline pipeline;
+			auto& pipelineCache = gpu.pipeline_cache();
+			auto start_time = std::chrono::steady_clock::now();
+			auto result = vkCreateComputePipelines(logicDevice, to_vulkan(pipelineCache.vulkan_cache()), 1, &createInfo, nullptr, &pipeline);
+			pipelineCache.add_creation_time(std::chrono::steady_clock::now() - start_time);
+
+			switch (result)
+			{
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not create a compute program's pipeline on the GPU: ")
+					throw std::runtime_error(message);
+			}
+
+			vulkan_pipeline = unique_deleter_ptr<vulkan_handle::pipeline_t>(from_vulkan(pipeline),
+				[logicDevice, deletion_queue](vulkan_handle::pipeline p)
+				{
+					deletion_queue->defer([logicDevice, p]()
+						{
+							vkDestroyPipeline(logicDevice, to_vulkan(p), nullptr);
+						}
+					);
+				}
+			);
+		}
+
+		// A program without any buffer fields has no descriptors to allocate.
+		if (uniformCount + storageCount == 0) return;
+
+		VkDescriptorPool descriptorPool;
+		{
+			std::vector<VkDescriptorPoolSize> poolSizes;
+			if (uniformCount > 0) poolSizes.emplace_back(VkDescriptorPoolSize{
+				.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+				.descriptorCount = uniformCount,
+			});
+			if (storageCount > 0) poolSizes.emplace_back(VkDescriptorPoolSize{
+				.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+				.descriptorCount = storageCount,
+			});
+			VkDescriptorPoolCreateInfo createInfo{
+				.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+				.maxSets = 1,
+				.poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+				.pPoolSizes = poolSizes.data(),
+			};
+
+			auto result = vkCreateDescriptorPool(logicDevice, &createInfo, nullptr, &descriptorPool);
+
+			switch (result)
+			{
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not create a compute program's descriptor pool on the GPU: ")
+					throw std::runtime_error(message);
+			}
+
+			vulkan_descriptor_pool = unique_deleter_ptr<vulkan_handle::descriptor_pool_t>(from_vulkan(descriptorPool),
+				[logicDevice, deletion_queue](vulkan_handle::descriptor_pool p)
+				{
+					deletion_queue->defer([logicDevice, p]()
+						{
+							vkDestroyDescriptorPool(logicDevice, to_vulkan(p), nullptr);
+						}
+					);
+				}
+			);
+		}
+		{
+			VkDescriptorSetAllocateInfo allocateInfo{
+				.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+				.descriptorPool = descriptorPool,
+				.descriptorSetCount = 1,
+				.pSetLayouts = &descriptorSetLayout,
+			};
+
+			VkDescriptorSet descriptorSet;
+			auto result = vkAllocateDescriptorSets(logicDevice, &allocateInfo, &descriptorSet);
+
+			switch (result)
+			{
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not create a compute program's descriptor set on the GPU: ")
+					throw std::runtime_error(message);
+			}
+
+			vulkan_descriptor_set = from_vulkan(descriptorSet);
+		}
+	}
+}
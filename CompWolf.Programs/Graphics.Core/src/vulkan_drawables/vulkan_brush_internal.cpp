@@ -2,6 +2,7 @@
 
 #include "compwolf_vulkan.hpp"
 #include <stdexcept>
+#include <chrono>
 #include <vector>
 #include <array>
 
@@ -20,6 +21,8 @@ namespace compwolf::vulkan::internal
 			uniformBindings.reserve(info.field_indices->size() * 2);
 			for (std::size_t i = 0; i < info.field_indices->size(); ++i)
 			{
+				if (info.field_is_push_field[i]) continue;
+
 				VkDescriptorSetLayoutBinding layoutBinding{
 					.binding = static_cast<uint32_t>(info.field_indices->at(i)),
 					.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
@@ -58,13 +61,20 @@ namespace compwolf::vulkan::internal
 			);
 		}
 
+		vulkan_draw_fields_layout = new_draw_fields_layout(gpu);
+
 		VkPipelineLayout pipelineLayout;
 		{
+			// The push fields are not pushed, but read from the camera's buffer of them, so that drawables with different push fields can be drawn together.
+			std::array<VkDescriptorSetLayout, 2> setLayouts{
+				descriptorSetLayout,
+				to_vulkan(vulkan_draw_fields_layout.get()),
+			};
+
 			VkPipelineLayoutCreateInfo createInfo{
 				.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-				.setLayoutCount = 1,
-				.pSetLayouts = &descriptorSetLayout,
-				.pushConstantRangeCount = 0,
+				.setLayoutCount = static_cast<uint32_t>(setLayouts.size()),
+				.pSetLayouts = setLayouts.data(),
 			};
 
 			auto result = vkCreatePipelineLayout(logicDevice, &createInfo, nullptr, &pipelineLayout);
@@ -88,30 +98,30 @@ namespace compwolf::vulkan::internal
 		}
 	}
 	
-	vulkan_window_brush::vulkan_window_brush(vulkan_window& window
-		, vulkan_brush_info& info, vulkan_handle::shader input_shader, vulkan_handle::shader pixel_shader
-		, vulkan_handle::descriptor_set_layout descriptor_set_layout, vulkan_handle::pipeline_layout pipeline_layout
-	)
+	namespace
 	{
-		auto& frames = window.swapchain().frames();
-		auto renderpass = to_vulkan(window.surface().vulkan_render_pass());
-
-		auto& gpu = window.gpu();
-		auto logicDevice = to_vulkan(gpu.vulkan_device());
-		auto descriptorSetLayout = to_vulkan(descriptor_set_layout);
-		auto pipelineLayout = to_vulkan(pipeline_layout);
-
+		/** Creates a brush' pipeline; this is run on another thread than the one that creates the brush, as it may take a while. */
+		auto create_brush_pipeline(VkDevice logicDevice
+			, vulkan_deletion_queue* deletion_queue
+			, VkPipelineCache pipelineCache
+			, VkRenderPass renderpass
+			, VkFormat imageFormat
+			, const vulkan_brush_info& info
+			, VkShaderModule inputShader
+			, VkShaderModule pixelShader
+			, VkPipelineLayout pipelineLayout
+		) -> vulkan_brush_pipeline_result
 		{
 			VkPipelineShaderStageCreateInfo vertexCreateInfo{
 				.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
 				.stage = VK_SHADER_STAGE_VERTEX_BIT,
-				.module = to_vulkan(input_shader),
+				.module = inputShader,
 				.pName = "main",
 			};
 			VkPipelineShaderStageCreateInfo fragCreateInfo{
 				.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
 				.stage = VK_SHADER_STAGE_FRAGMENT_BIT,
-				.module = to_vulkan(pixel_shader),
+				.module = pixelShader,
 				.pName = "main",
 			};
 			std::array<VkPipelineShaderStageCreateInfo, 2> stageCreateInfo { std::move(vertexCreateInfo), std::move(fragCreateInfo) };
@@ -159,6 +169,157 @@ namespace compwolf::vulkan::internal
 				.pDynamicStates = dynamicStates.data(),
 			};
 
+			// The viewport and scissor are dynamic, so that the pipeline does not depend on the size of the window.
+			VkPipelineViewportStateCreateInfo viewportCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+				.viewportCount = 1,
+				.pViewports = nullptr,
+				.scissorCount = 1,
+				.pScissors = nullptr,
+			};
+
+			VkPipelineRasterizationStateCreateInfo rasterizationCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+				.depthClampEnable = VK_FALSE,
+				.rasterizerDiscardEnable = VK_FALSE,
+				.polygonMode = VK_POLYGON_MODE_FILL,
+				.cullMode = VK_CULL_MODE_BACK_BIT,
+				.frontFace = VK_FRONT_FACE_CLOCKWISE,
+				.depthBiasEnable = VK_FALSE,
+				.lineWidth = 1.f,
+			};
+
+			VkPipelineMultisampleStateCreateInfo multisampleCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+				.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+				.sampleShadingEnable = VK_FALSE,
+			};
+
+			VkPipelineColorBlendAttachmentState blendState{
+				.blendEnable = VK_FALSE,
+				.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+			};
+			VkPipelineColorBlendStateCreateInfo blendCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+				.logicOpEnable = VK_FALSE,
+				.attachmentCount = 1,
+				.pAttachments = &blendState,
+			};
+
+			// Without a render pass, the pipeline is made for dynamic rendering on images of the given format.
+			VkPipelineRenderingCreateInfo renderingCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+				.colorAttachmentCount = 1,
+				.pColorAttachmentFormats = &imageFormat,
+			};
+
+			VkGraphicsPipelineCreateInfo createInfo{
+				.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+				.pNext = renderpass ? nullptr : &renderingCreateInfo,
+				.stageCount = static_cast<uint32_t>(stageCreateInfo.size()),
+				.pStages = stageCreateInfo.data(),
+				.pVertexInputState = &inputCreateInfo,
+				.pInputAssemblyState = &inputAssemblyCreateInfo,
+				.pViewportState = &viewportCreateInfo,
+				.pRasterizationState = &rasterizationCreateInfo,
+				.pMultisampleState = &multisampleCreateInfo,
+				.pDepthStencilState = nullptr,
+				.pColorBlendState = &blendCreateInfo,
+				.pDynamicState = &dynamic_create_info,
+				.layout = pipelineLayout,
+				.renderPass = renderpass,
+				.subpass = 0,
+				.basePipelineHandle = nullptr,
+				.basePipelineIndex = -1,
+			};
+
+			VkPipeline pipeline;
+			auto start_time = std::chrono::steady_clock::now();
+			auto result = vkCreateGraphicsPipelines(logicDevice, pipelineCache, 1, &createInfo, nullptr, &pipeline);
+			auto creation_time = std::chrono::steady_clock::now() - start_time;
+
+			switch (result)
+			{
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not create a brush' pipeline on the GPU: ")
+					throw std::runtime_error(message);
+			}
+
+			return vulkan_brush_pipeline_result{
+				.vulkan_pipeline = unique_deleter_ptr<vulkan_handle::pipeline_t>(from_vulkan(pipeline),
+					[logicDevice, deletion_queue](vulkan_handle::pipeline p)
+					{
+						deletion_queue->defer([logicDevice, p]()
+							{
+								vkDestroyPipeline(logicDevice, to_vulkan(p), nullptr);
+							}
+						);
+					}
+				),
+				.creation_time = std::chrono::duration_cast<std::chrono::nanoseconds>(creation_time),
+			};
+		}
+	}
+
+	/******************************** accessors ********************************/
+
+	auto vulkan_brush_pipeline::pipeline_ready() -> bool
+	{
+		if (vulkan_pipeline) return true;
+		if (!pipeline_creation.valid()) return false;
+		if (pipeline_creation.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return false;
+
+		take_pipeline();
+		return true;
+	}
+	void vulkan_brush_pipeline::wait_for_pipeline()
+	{
+		if (vulkan_pipeline || !pipeline_creation.valid()) return;
+		take_pipeline();
+	}
+	void vulkan_brush_pipeline::take_pipeline()
+	{
+		// get() rethrows any exception thrown while creating the pipeline.
+		auto created = pipeline_creation.get();
+		vulkan_pipeline = std::move(created.vulkan_pipeline);
+		gpu->pipeline_cache().add_creation_time(created.creation_time);
+	}
+
+	/******************************** constructors ********************************/
+
+	vulkan_brush_pipeline::vulkan_brush_pipeline(vulkan_gpu_connection& gpu_connection
+		, vulkan_handle::render_pass render_pass, vulkan_handle::format image_format
+		, const vulkan_brush_info& info, vulkan_handle::shader input_shader, vulkan_handle::shader pixel_shader
+		, vulkan_handle::pipeline_layout pipeline_layout
+	)
+		: gpu(&gpu_connection)
+	{
+		// The pipeline is created on another thread, so that whoever needs the brush does not have to wait for its shaders to compile.
+		pipeline_creation = std::async(std::launch::async, &create_brush_pipeline
+			, to_vulkan(gpu->vulkan_device())
+			, &gpu->deletion_queue()
+			, to_vulkan(gpu->pipeline_cache().vulkan_cache())
+			, to_vulkan(render_pass)
+			, static_cast<VkFormat>(image_format)
+			, std::cref(info)
+			, to_vulkan(input_shader)
+			, to_vulkan(pixel_shader)
+			, to_vulkan(pipeline_layout)
+		);
+	}
+
+	vulkan_window_brush::vulkan_window_brush(vulkan_window& window, vulkan_handle::descriptor_set_layout descriptor_set_layout)
+	{
+		auto& frames = window.swapchain().frames_in_flight();
+
+		auto logicDevice = to_vulkan(window.gpu().vulkan_device());
+		auto deletion_queue = &window.gpu().deletion_queue();
+		auto descriptorSetLayout = to_vulkan(descriptor_set_layout);
+
+		{
 			auto descriptorSize = static_cast<uint32_t>(frames.size());
 			VkDescriptorPool descriptorPool;
 			{
@@ -192,10 +353,13 @@ namespace compwolf::vulkan::internal
 				}
 
 				vulkan_descriptor_pool = unique_deleter_ptr<vulkan_handle::descriptor_pool_t>(from_vulkan(descriptorPool),
-					[logicDevice](vulkan_handle::descriptor_pool p)
+					[logicDevice, deletion_queue](vulkan_handle::descriptor_pool p)
 					{
-						vkDeviceWaitIdle(logicDevice);
-						vkDestroyDescriptorPool(logicDevice, to_vulkan(p), nullptr);
+						deletion_queue->defer([logicDevice, p]()
+							{
+								vkDestroyDescriptorPool(logicDevice, to_vulkan(p), nullptr);
+							}
+						);
 					}
 				);
 			}
@@ -229,142 +393,6 @@ namespace compwolf::vulkan::internal
 					vulkan_descriptor_set[i] = from_vulkan(descriptorSets[i]);
 				}
 			}
-
-			uint32_t width, height;
-			{
-				auto size = window.pixel_size();
-				width = static_cast<uint32_t>(size.x());
-				height = static_cast<uint32_t>(size.y());
-			}
-			VkViewport viewport{
-				.x = 0.f,
-				.y = 0.f,
-				.width = static_cast<float>(width),
-				.height = static_cast<float>(height),
-				.minDepth = 0.f,
-				.maxDepth = 1.f,
-			};
-			VkRect2D scissor{
-				.offset = {0, 0},
-				.extent = {
-					.width = width,
-					.height = height,
-				},
-			};
-			VkPipelineViewportStateCreateInfo viewportCreateInfo{
-				.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
-				.viewportCount = 1,
-				.pViewports = &viewport,
-				.scissorCount = 1,
-				.pScissors = &scissor,
-			};
-
-			VkPipelineRasterizationStateCreateInfo rasterizationCreateInfo{
-				.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
-				.depthClampEnable = VK_FALSE,
-				.rasterizerDiscardEnable = VK_FALSE,
-				.polygonMode = VK_POLYGON_MODE_FILL,
-				.cullMode = VK_CULL_MODE_BACK_BIT,
-				.frontFace = VK_FRONT_FACE_CLOCKWISE,
-				.depthBiasEnable = VK_FALSE,
-				.lineWidth = 1.f,
-			};
-
-			VkPipelineMultisampleStateCreateInfo multisampleCreateInfo{
-				.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
-				.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
-				.sampleShadingEnable = VK_FALSE,
-			};
-
-			VkPipelineColorBlendAttachmentState blendState{
-				.blendEnable = VK_FALSE,
-				.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
-			};
-			VkPipelineColorBlendStateCreateInfo blendCreateInfo{
-				.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
-				.logicOpEnable = VK_FALSE,
-				.attachmentCount = 1,
-				.pAttachments = &blendState,
-			};
-
-			VkPipeline pipeline;
-			{
-				VkGraphicsPipelineCreateInfo createInfo{
-					.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-					.stageCount = static_cast<uint32_t>(stageCreateInfo.size()),
-					.pStages = stageCreateInfo.data(),
-					.pVertexInputState = &inputCreateInfo,
-					.pInputAssemblyState = &inputAssemblyCreateInfo,
-					.pViewportState = &viewportCreateInfo,
-					.pRasterizationState = &rasterizationCreateInfo,
-					.pMultisampleState = &multisampleCreateInfo,
-					.pDepthStencilState = nullptr,
-					.pColorBlendState = &blendCreateInfo,
-					.pDynamicState = &dynamic_create_info,
-					.layout = pipelineLayout,
-					.renderPass = renderpass,
-					.subpass = 0,
-					.basePipelineHandle = nullptr,
-					.basePipelineIndex = -1,
-				};
-
-				auto result = vkCreateGraphicsPipelines(logicDevice, VK_NULL_HANDLE, 1, &createInfo, nullptr, &pipeline);
-
-				switch (result)
-				{
-				case VK_SUCCESS: break;
-				default:
-					const char* message;
-					GET_VULKAN_ERROR_STRING(result, message,
-						"Could not create a brush' pipeline on the GPU: ")
-						throw std::runtime_error(message);
-				}
-
-				vulkan_pipeline = unique_deleter_ptr<vulkan_handle::pipeline_t>(from_vulkan(pipeline),
-					[logicDevice](vulkan_handle::pipeline p)
-					{
-						vkDeviceWaitIdle(logicDevice);
-						vkDestroyPipeline(logicDevice, to_vulkan(p), nullptr);
-					}
-				);
-			}
-
-			vulkan_frame_buffer.reserve(frames.size());
-			for (std::size_t frame_iterator = 0; frame_iterator < frames.size(); ++frame_iterator)
-			{
-				VkImageView swapchainImage = to_vulkan(frames[frame_iterator].image());
-
-				VkFramebufferCreateInfo create_info{
-					.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
-					.renderPass = renderpass,
-					.attachmentCount = 1,
-					.pAttachments = &swapchainImage,
-					.width = width,
-					.height = height,
-					.layers = 1,
-				};
-
-				VkFramebuffer framebuffer;
-				auto result = vkCreateFramebuffer(logicDevice, &create_info, nullptr, &framebuffer);
-
-				switch (result)
-				{
-				case VK_SUCCESS: break;
-				default:
-					const char* message;
-					GET_VULKAN_ERROR_STRING(result, message,
-						"Could not create a brush' frame buffer on the GPU: ")
-						throw std::runtime_error(message);
-				}
-
-				vulkan_frame_buffer.push_back(unique_deleter_ptr<vulkan_handle::frame_buffer_t>(from_vulkan(framebuffer),
-					[logicDevice](vulkan_handle::frame_buffer b)
-					{
-						vkDeviceWaitIdle(logicDevice);
-						vkDestroyFramebuffer(logicDevice, to_vulkan(b), nullptr);
-					}
-				));
-			}
 		}
 	}
 }
@@ -2,6 +2,9 @@
 
 #include "compwolf_vulkan.hpp"
 #include <stdexcept>
+#include <array>
+#include <span>
+#include <cstddef>
 
 namespace compwolf::vulkan::internal
 {
@@ -12,16 +15,44 @@ namespace compwolf::vulkan::internal
 		, vulkan_handle::buffer vertex_buffer
 		, vulkan_handle::buffer vertex_index_buffer
 		, const vulkan_handle::buffer* field_buffers
-		, const std::vector<std::size_t>& field_indices
+		, const void* const* field_push_data
+		, const vulkan_brush_info& brush_info
 		, const std::vector<vulkan_handle::descriptor_set>& descriptor_sets
+		, const draw_bounds* bounds
 	)
 	{
+		auto& field_indices = *brush_info.field_indices;
 		auto& gpu = args.window->gpu();
 		auto command = to_vulkan(args.command);
 		auto logicDevice = to_vulkan(gpu.vulkan_device());
 		auto vkPipeline = to_vulkan(pipeline);
 		auto vkPipelineLayout = to_vulkan(pipeline_layout);
-		auto descriptorSet = to_vulkan(descriptor_sets[args.frame_index]);
+		auto descriptorSet = to_vulkan(descriptor_sets[args.frame_in_flight_index]);
+
+		// The push fields are read by the shaders from the camera's buffer, at the slot drawn as the first instance.
+		auto instance = args.draw_fields->add(field_push_data
+			, brush_info.field_is_push_field
+			, brush_info.field_push_offsets
+			, brush_info.field_sizes
+		);
+		if (!instance)
+		{
+			*args.record_again = true;
+			return;
+		}
+
+		// A drawable with the same state as the one drawn right before it is drawn by the same draw, so it does not set its state again.
+		// As push fields are not part of the state, drawables differing only in them, like simple shapes, are drawn together.
+		vulkan_draw_state state{
+			.pipeline = pipeline,
+			.vertex_buffer = vertex_buffer,
+			.vertex_index_buffer = vertex_index_buffer,
+			.field_buffers = std::span<const vulkan_handle::buffer>(field_buffers, field_indices.size()),
+		};
+		if (args.culling && bounds)
+		{
+			if (args.culling->draw_in_group(state, vertex_index_count, *bounds, *instance)) return;
+		}
 
 		{
 			vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_GRAPHICS, vkPipeline);
@@ -62,8 +93,11 @@ namespace compwolf::vulkan::internal
 
 			vkCmdBindIndexBuffer(command, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
 		}
+		bool has_descriptor_fields = false;
 		for (size_t i = 0; i < field_indices.size(); ++i)
 		{
+			if (brush_info.field_is_push_field[i]) continue;
+
 			VkDescriptorBufferInfo bufferInfo{
 				.buffer = to_vulkan(field_buffers[i]),
 				.offset = 0,
@@ -80,18 +114,27 @@ namespace compwolf::vulkan::internal
 			};
 
 			vkUpdateDescriptorSets(logicDevice, 1, &writer, 0, nullptr);
-
+			has_descriptor_fields = true;
+		}
+		{
+			// Set 1, the camera's push fields, is bound with every pipeline, as pipelines with different fields may not keep it bound.
+			std::array<VkDescriptorSet, 2> descriptorSets{
+				descriptorSet,
+				to_vulkan(args.draw_fields->vulkan_descriptor_set()),
+			};
+			auto firstSet = has_descriptor_fields ? 0 : 1;
 			vkCmdBindDescriptorSets(command
 				, VK_PIPELINE_BIND_POINT_GRAPHICS
 				, vkPipelineLayout
-				, 0
-				, 1
-				, &descriptorSet
+				, static_cast<uint32_t>(firstSet)
+				, static_cast<uint32_t>(descriptorSets.size() - firstSet)
+				, descriptorSets.data() + firstSet
 				, 0
 				, nullptr
 			);
 		}
 
-		vkCmdDrawIndexed(command, vertex_index_count, 1, 0, 0, 0);
+		if (args.culling && bounds) args.culling->draw_indexed(args.command, vertex_index_count, *bounds, *instance, state);
+		else vkCmdDrawIndexed(command, vertex_index_count, 1, 0, 0, *instance);
 	}
 }
@@ -2,33 +2,73 @@
 
 #include "compwolf_vulkan.hpp"
 #include <stdexcept>
+#include <cstring>
+#include <vector>
 
 namespace compwolf::vulkan::internal
 {
 	/******************************** constructors ********************************/
 
+	namespace
+	{
+		auto vulkan_buffer_usage(gpu_buffer_usage usage_type) -> uint32_t
+		{
+			switch (usage_type)
+			{
+			// Buffers on the gpu can be written to by a [[vulkan_upload_engine]].
+			case gpu_buffer_usage::input_index: return VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			case gpu_buffer_usage::input: return VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			case gpu_buffer_usage::field: return VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			case gpu_buffer_usage::push_field: return 0;
+			case gpu_buffer_usage::storage_field: return VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			default: throw std::invalid_argument("Could not create a buffer on the GPU; the given type is unknown.");
+			}
+		}
+	}
+
 	vulkan_gpu_buffer_internal::vulkan_gpu_buffer_internal(vulkan_gpu_connection& gpu
 		, gpu_buffer_usage usage_type
 		, std::size_t stride, std::size_t size)
+		: vulkan_gpu_buffer_internal(gpu, vulkan_buffer_usage(usage_type), stride, size)
+	{ }
+
+	vulkan_gpu_buffer_internal::vulkan_gpu_buffer_internal(vulkan_gpu_connection& gpu
+		, uint32_t vulkan_usage
+		, std::size_t stride, std::size_t size)
 		: stride(stride), size(size)
 	{
+		if (vulkan_usage == 0)
+		{
+			// Push fields are copied into the gpu-instructions when these are recorded, so they do not need any memory on the gpu.
+			push_data = std::make_unique<std::byte[]>(stride * size);
+			accessed_push_data = std::make_unique<std::byte[]>(stride * size);
+			return;
+		}
+
 		auto logicDevice = to_vulkan(gpu.vulkan_device());
 		auto physicalDevice = to_vulkan(gpu.vulkan_physical_device());
+		auto deletion_queue = &gpu.deletion_queue();
 
 		VkBuffer vkBuffer;
 		{
+			// A buffer written to on a transfer queue is shared by all queue families, so that it does not need to be handed over between them.
+			std::vector<uint32_t> queueFamilies;
+			if ((vulkan_usage & VK_BUFFER_USAGE_TRANSFER_DST_BIT) && gpu.thread_families().size() > 1)
+			{
+				queueFamilies.resize(gpu.thread_families().size());
+				for (uint32_t i = 0; i < queueFamilies.size(); ++i) queueFamilies[i] = i;
+			}
+
 			VkBufferCreateInfo createInfo{
 				.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
 				.size = static_cast<VkDeviceSize>(stride * size),
-				.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+				.usage = static_cast<VkBufferUsageFlags>(vulkan_usage),
+				.sharingMode = queueFamilies.empty()
+					? VK_SHARING_MODE_EXCLUSIVE
+					: VK_SHARING_MODE_CONCURRENT,
+				.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilies.size()),
+				.pQueueFamilyIndices = queueFamilies.data(),
 			};
-			switch (usage_type)
-			{
-			case gpu_buffer_usage::input_index: createInfo.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT; break;
-			case gpu_buffer_usage::input: createInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT; break;
-			case gpu_buffer_usage::field: createInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT; break;
-			default: throw std::invalid_argument("Could not create a buffer on the GPU; the given type is unknown.");
-			}
 
 			auto result = vkCreateBuffer(logicDevice, &createInfo, nullptr, &vkBuffer);
 
@@ -43,9 +83,13 @@ namespace compwolf::vulkan::internal
 			}
 
 			vulkan_buffer = unique_deleter_ptr<vulkan_handle::buffer_t>(from_vulkan(vkBuffer),
-				[logicDevice](vulkan_handle::buffer b)
+				[logicDevice, deletion_queue](vulkan_handle::buffer b)
 				{
-					vkDestroyBuffer(logicDevice, to_vulkan(b), nullptr);
+					deletion_queue->defer([logicDevice, b]()
+						{
+							vkDestroyBuffer(logicDevice, to_vulkan(b), nullptr);
+						}
+					);
 				}
 			);
 		}
@@ -96,9 +140,13 @@ namespace compwolf::vulkan::internal
 			}
 
 			vulkan_memory = unique_deleter_ptr<vulkan_handle::memory_t>(from_vulkan(vkMemory),
-				[logicDevice](vulkan_handle::memory m)
+				[logicDevice, deletion_queue](vulkan_handle::memory m)
 				{
-					vkFreeMemory(logicDevice, to_vulkan(m), nullptr);
+					deletion_queue->defer([logicDevice, m]()
+						{
+							vkFreeMemory(logicDevice, to_vulkan(m), nullptr);
+						}
+					);
 				}
 			);
 		}
@@ -122,6 +170,12 @@ namespace compwolf::vulkan::internal
 
 	auto vulkan_gpu_buffer_internal::get_data(vulkan_gpu_connection& gpu) -> void*
 	{
+		if (push_data)
+		{
+			if (push_data_accesses++ == 0) std::memcpy(accessed_push_data.get(), push_data.get(), stride * size);
+			return push_data.get();
+		}
+
 		auto logicDevice = to_vulkan(gpu.vulkan_device());
 		auto vkMemory = to_vulkan(vulkan_memory.get());
 
@@ -133,7 +187,20 @@ namespace compwolf::vulkan::internal
 	{
 		auto logicDevice = to_vulkan(gpu.vulkan_device());
 		auto vkMemory = to_vulkan(memory);
+		if (vkMemory == VK_NULL_HANDLE) return;
 
 		vkUnmapMemory(logicDevice, vkMemory);
 	}
+	void vulkan_gpu_buffer_internal::end_access(vulkan_gpu_connection& gpu) noexcept
+	{
+		if (!push_data)
+		{
+			free_data(gpu, vulkan_memory.get());
+			return;
+		}
+
+		// Reading a push field, like to find a drawable's bounds, must not make cameras record their instructions again.
+		if (--push_data_accesses != 0) return;
+		if (std::memcmp(accessed_push_data.get(), push_data.get(), stride * size) != 0) gpu.add_push_data_change();
+	}
 }
@@ -0,0 +1,148 @@
+#include <private/vulkan_gpu_buffers/vulkan_upload_engine.hpp>
+
+#include "compwolf_vulkan.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <map>
+
+namespace compwolf::vulkan
+{
+	/******************************** modifiers ********************************/
+
+	void vulkan_upload_engine::upload_bytes(vulkan_handle::buffer target, const void* data, std::size_t size, std::size_t offset)
+	{
+		if (size == 0) return;
+
+		if (_chunks.empty() || _chunks.back().buffer.size - _chunks.back().used < size)
+		{
+			auto chunk_size = std::max(size, min_staging_size);
+			internal::vulkan_gpu_buffer_internal buffer(gpu(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, 1, chunk_size);
+			auto chunk_data = static_cast<std::byte*>(buffer.get_data(gpu()));
+			_chunks.push_back(staging_chunk{
+				.buffer = std::move(buffer),
+				.data = chunk_data,
+				.used = 0,
+			});
+		}
+
+		auto& chunk = _chunks.back();
+		std::memcpy(chunk.data + chunk.used, data, size);
+		_copies.push_back(pending_copy{
+			.source = chunk.buffer.vulkan_buffer.get(),
+			.target = target,
+			.source_offset = chunk.used,
+			.target_offset = offset,
+			.size = size,
+		});
+		chunk.used += size;
+		_pending_bytes += size;
+	}
+
+	auto vulkan_upload_engine::submit() -> vulkan_gpu_fence
+	{
+		if (_copies.empty()) return _manager.latest_fence();
+
+		auto code = [this](const vulkan_code_parameters& args)
+		{
+			auto command = to_vulkan(args.command);
+
+			std::vector<VkBufferCopy> regions;
+			regions.reserve(_copies.size());
+			std::map<vulkan_handle::buffer, std::map<std::size_t, std::size_t>> written;
+			std::vector<vulkan_handle::buffer> used;
+			for (std::size_t group_first = 0; group_first < _copies.size();)
+			{
+				// Copies that do not write the same data can wait for earlier work with a single barrier;
+				// a copy writing data that an earlier copy in the group wrote must wait for it, so it starts the next group.
+				written.clear();
+				used.clear();
+				std::size_t group_last = group_first;
+				for (; group_last < _copies.size(); ++group_last)
+				{
+					auto& copy = _copies[group_last];
+
+					// The written ranges do not overlap, so only the last one starting before the copy's end can overlap it.
+					auto& ranges = written[copy.target];
+					auto next = ranges.lower_bound(copy.target_offset + copy.size);
+					if (next != ranges.begin() && std::prev(next)->second > copy.target_offset) break;
+					ranges.emplace(copy.target_offset, copy.target_offset + copy.size);
+
+					// Uses given between flushes happen together, so each buffer is only given once.
+					if (std::find(used.begin(), used.end(), copy.source) == used.end())
+					{
+						used.push_back(copy.source);
+						args.barriers->use(copy.source, vulkan_resource_access::copy_read);
+					}
+					if (std::find(used.begin(), used.end(), copy.target) == used.end())
+					{
+						used.push_back(copy.target);
+						args.barriers->use(copy.target, vulkan_resource_access::copy_write);
+					}
+				}
+				args.barriers->flush();
+
+				// Copies between the same buffers are given to the gpu together.
+				for (std::size_t first = group_first; first < group_last;)
+				{
+					auto& copy = _copies[first];
+
+					regions.clear();
+					std::size_t last = first;
+					for (; last < group_last; ++last)
+					{
+						auto& other = _copies[last];
+						if (other.source != copy.source || other.target != copy.target) break;
+
+						regions.push_back(VkBufferCopy{
+							.srcOffset = static_cast<VkDeviceSize>(other.source_offset),
+							.dstOffset = static_cast<VkDeviceSize>(other.target_offset),
+							.size = static_cast<VkDeviceSize>(other.size),
+						});
+					}
+
+					vkCmdCopyBuffer(command, to_vulkan(copy.source), to_vulkan(copy.target), static_cast<uint32_t>(regions.size()), regions.data());
+					first = last;
+				}
+				group_first = group_last;
+			}
+		};
+
+		auto program = std::find_if(_programs.begin(), _programs.end()
+			, [](const std::unique_ptr<vulkan_gpu_program>& p) { return p->last_fence().completed(); }
+		);
+		if (program == _programs.end())
+		{
+			_programs.push_back(std::make_unique<vulkan_gpu_program>(_manager, code));
+			program = std::prev(_programs.end());
+			// Only the copies use the buffers, so only they wait for earlier work.
+			(*program)->set_wait_stages(vulkan_access_info(vulkan_resource_access::copy_write).stages);
+		}
+		else (*program)->record(code);
+
+		auto submission = (*program)->prepare_execution();
+		submit_programs(std::span(&submission, 1));
+		auto fence = vulkan_gpu_fence(gpu(), submission.timeline, submission.signal_value);
+
+		// The staging buffers are destroyed by the gpu's deletion queue, once the copies are done.
+		for (auto& chunk : _chunks) internal::vulkan_gpu_buffer_internal::free_data(gpu(), chunk.buffer.vulkan_memory.get());
+		_chunks.clear();
+		_copies.clear();
+		_pending_bytes = 0;
+
+		return fence;
+	}
+
+	/******************************** constructors ********************************/
+
+	vulkan_upload_engine::vulkan_upload_engine(vulkan_gpu_connection& gpu)
+		: _manager(vulkan_gpu_program_manager::new_manager_for(gpu, gpu_program_manager_settings{
+			.type = { gpu_work_type::transfer },
+		}))
+	{}
+
+	vulkan_upload_engine::~vulkan_upload_engine() noexcept
+	{
+		for (auto& chunk : _chunks) internal::vulkan_gpu_buffer_internal::free_data(gpu(), chunk.buffer.vulkan_memory.get());
+	}
+}
@@ -0,0 +1,114 @@
+#include "private/vulkan_graphics_environments/vulkan_deletion_queue.hpp"
+#include "compwolf_vulkan.hpp"
+
+#include <algorithm>
+
+namespace compwolf::vulkan
+{
+	/******************************** modifiers ********************************/
+
+	void vulkan_deletion_queue::track_timeline(std::shared_ptr<vulkan_tracked_timeline> timeline)
+	{
+		std::lock_guard lock(_mutex);
+		_timelines.push_back(timeline);
+	}
+
+	void vulkan_deletion_queue::defer(std::function<void()> deleter) noexcept
+	{
+		pending_deletion deletion;
+		try
+		{
+			{
+				std::lock_guard lock(_mutex);
+
+				std::erase_if(_timelines, [](const std::weak_ptr<vulkan_tracked_timeline>& t) { return t.expired(); });
+				for (auto& weak_timeline : _timelines)
+				{
+					auto timeline = weak_timeline.lock();
+					auto value = timeline->submitted_value.load(std::memory_order_acquire);
+					if (!reached(*timeline, value)) deletion.waits.emplace_back(std::move(timeline), value);
+				}
+
+				// Earlier objects may depend on this one, so it must wait for them even if the gpu is done with it.
+				if (!deletion.waits.empty() || !_pending.empty())
+				{
+					deletion.deleter = std::move(deleter);
+					_pending.push_back(std::move(deletion));
+					return;
+				}
+			}
+			deleter();
+		}
+		catch (...)
+		{
+			// Without memory to note the deletion, the only safe option left is to wait for the gpu.
+			flush();
+			vkDeviceWaitIdle(to_vulkan(_vulkan_device));
+			if (deletion.deleter) deletion.deleter();
+			else if (deleter) deleter();
+		}
+	}
+
+	void vulkan_deletion_queue::collect() noexcept
+	{
+		std::vector<pending_deletion> ready;
+		{
+			std::lock_guard lock(_mutex);
+			while (!_pending.empty())
+			{
+				auto& deletion = _pending.front();
+				bool done = std::all_of(deletion.waits.begin(), deletion.waits.end()
+					, [this](const auto& wait) { return reached(*wait.first, wait.second); }
+				);
+				if (!done) break;
+
+				try
+				{
+					ready.push_back(std::move(deletion));
+				}
+				catch (...)
+				{
+					break;
+				}
+				_pending.pop_front();
+			}
+		}
+
+		// The deleters are called without the lock, so that they may give more objects to the queue.
+		for (auto& deletion : ready) deletion.deleter();
+	}
+
+	void vulkan_deletion_queue::flush() noexcept
+	{
+		std::deque<pending_deletion> all;
+		{
+			std::lock_guard lock(_mutex);
+			std::swap(all, _pending);
+		}
+
+		vkDeviceWaitIdle(to_vulkan(_vulkan_device));
+		for (auto& deletion : all) deletion.deleter();
+	}
+
+	/******************************** constructors ********************************/
+
+	vulkan_deletion_queue::vulkan_deletion_queue(vulkan_handle::device device) noexcept
+		: _vulkan_device(device)
+	{}
+
+	vulkan_deletion_queue::~vulkan_deletion_queue() noexcept
+	{
+		if (_vulkan_device) flush();
+	}
+
+	/******************************** private ********************************/
+
+	auto vulkan_deletion_queue::reached(const vulkan_tracked_timeline& timeline, uint64_t value) const noexcept -> bool
+	{
+		if (value == 0) return true;
+
+		uint64_t reached_value;
+		if (vkGetSemaphoreCounterValue(to_vulkan(_vulkan_device), to_vulkan(timeline.semaphore.get()), &reached_value) != VK_SUCCESS) return false;
+		return reached_value >= value;
+	}
+}
@@ -19,9 +19,13 @@ namespace compwolf::vulkan
 			.apiVersion = VK_API_VERSION_1_3,
 		};
 
-		uint32_t glfw_extension_count;
-		const char** glfw_extensions = glfwGetRequiredInstanceExtensions(&glfw_extension_count);
-		std::vector<const char*> extensions(glfw_extensions, glfw_extensions + glfw_extension_count);
+		std::vector<const char*> extensions;
+		if (!settings.headless)
+		{
+			uint32_t glfw_extension_count;
+			const char** glfw_extensions = glfwGetRequiredInstanceExtensions(&glfw_extension_count);
+			extensions.assign(glfw_extensions, glfw_extensions + glfw_extension_count);
+		}
 
 		std::vector<const char*> validation_layers;
 		if (settings.internal_debug_callback)
@@ -31,9 +35,25 @@ namespace compwolf::vulkan
 		}
 		auto debugMessengerCreateInfo = vulkan_debug_messenger_create_info(&settings.internal_debug_callback);
 
+		VkValidationFeatureEnableEXT enabledValidationFeatures[] = { VK_VALIDATION_FEATURE_ENABLE_SYNCHRONIZATION_VALIDATION_EXT };
+		VkValidationFeaturesEXT validationFeatures{
+			.sType = VK_STRUCTURE_TYPE_VALIDATION_FEATURES_EXT,
+			.pNext = &debugMessengerCreateInfo,
+			.enabledValidationFeatureCount = 1,
+			.pEnabledValidationFeatures = enabledValidationFeatures,
+		};
+
+		const void* createInfoNext = nullptr;
+		if (settings.internal_debug_callback)
+		{
+			createInfoNext = settings.synchronization_validation
+				? static_cast<const void*>(&validationFeatures)
+				: static_cast<const void*>(&debugMessengerCreateInfo);
+		}
+
 		VkInstanceCreateInfo createInfo{
 			.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
-			.pNext = settings.internal_debug_callback ? &debugMessengerCreateInfo : nullptr,
+			.pNext = createInfoNext,
 			.pApplicationInfo = &app_info,
 			.enabledLayerCount = static_cast<uint32_t>(validation_layers.size()),
 			.ppEnabledLayerNames = validation_layers.data(),
@@ -0,0 +1,128 @@
+#include "private/vulkan_graphics_environments/vulkan_fence_reactor.hpp"
+#include "compwolf_vulkan.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace compwolf::vulkan
+{
+	/******************************** modifiers ********************************/
+
+	void vulkan_fence_reactor::when_reached(vulkan_handle::semaphore timeline, uint64_t value, std::function<void()> callback)
+	{
+		std::lock_guard lock(_mutex);
+		_pending[timeline].emplace(value, std::move(callback));
+		++_pending_count;
+	}
+
+	auto vulkan_fence_reactor::poll() -> std::size_t
+	{
+		std::vector<std::function<void()>> ready;
+		{
+			std::lock_guard lock(_mutex);
+			auto logicDevice = to_vulkan(_vulkan_device);
+
+			std::size_t queries = 0;
+			for (auto timeline = _pending.begin(); timeline != _pending.end();)
+			{
+				auto& callbacks = timeline->second;
+				if (callbacks.empty())
+				{
+					timeline = _pending.erase(timeline);
+					continue;
+				}
+
+				uint64_t reached_value = 0;
+				if (timeline->first && callbacks.rbegin()->first > 0)
+				{
+					++queries;
+					if (vkGetSemaphoreCounterValue(logicDevice, to_vulkan(timeline->first), &reached_value) != VK_SUCCESS) reached_value = 0;
+				}
+
+				auto done_end = callbacks.upper_bound(reached_value);
+				for (auto i = callbacks.begin(); i != done_end; ++i) ready.push_back(std::move(i->second));
+				callbacks.erase(callbacks.begin(), done_end);
+
+				if (callbacks.empty()) timeline = _pending.erase(timeline);
+				else ++timeline;
+			}
+			_pending_count -= ready.size();
+
+			_stats = vulkan_fence_reactor_stats{
+				.queries = queries,
+				.callbacks = ready.size(),
+				.pending = _pending_count,
+			};
+		}
+
+		// The functions are called without the lock, so that they may give the reactor new functions.
+		for (std::size_t i = 0; i < ready.size(); ++i)
+		{
+			try
+			{
+				ready[i]();
+			}
+			catch (...)
+			{
+				// The functions not called yet are kept; as their work is done, they are called by the next poll.
+				if (i + 1 < ready.size())
+				{
+					std::lock_guard lock(_mutex);
+					auto& remaining = _pending[nullptr];
+					for (auto j = i + 1; j < ready.size(); ++j) remaining.emplace(0, std::move(ready[j]));
+					_pending_count += ready.size() - i - 1;
+				}
+				throw;
+			}
+		}
+		return ready.size();
+	}
+
+	auto vulkan_fence_reactor::wait_any(std::chrono::nanoseconds timeout) -> std::size_t
+	{
+		std::vector<VkSemaphore> semaphores;
+		std::vector<uint64_t> values;
+		bool any_done = false;
+		{
+			std::lock_guard lock(_mutex);
+			if (_pending_count == 0) return 0;
+
+			semaphores.reserve(_pending.size());
+			values.reserve(_pending.size());
+			for (auto& [timeline, callbacks] : _pending)
+			{
+				if (callbacks.empty()) continue;
+
+				// Any of the timeline's functions is done once its first one is.
+				auto value = callbacks.begin()->first;
+				if (!timeline || value == 0)
+				{
+					any_done = true;
+					break;
+				}
+
+				semaphores.push_back(to_vulkan(timeline));
+				values.push_back(value);
+			}
+		}
+		if (any_done) return poll();
+
+		VkSemaphoreWaitInfo waitInfo{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+			.flags = VK_SEMAPHORE_WAIT_ANY_BIT,
+			.semaphoreCount = static_cast<uint32_t>(semaphores.size()),
+			.pSemaphores = semaphores.data(),
+			.pValues = values.data(),
+		};
+		auto result = vkWaitSemaphores(to_vulkan(_vulkan_device), &waitInfo, static_cast<uint64_t>(std::max(timeout.count(), std::chrono::nanoseconds::rep(0))));
+		if (result != VK_SUCCESS) return 0;
+
+		return poll();
+	}
+
+	/******************************** constructors ********************************/
+
+	vulkan_fence_reactor::vulkan_fence_reactor(vulkan_handle::device device) noexcept
+		: _vulkan_device(device)
+	{}
+}
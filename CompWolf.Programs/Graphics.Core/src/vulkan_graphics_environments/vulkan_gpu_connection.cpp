@@ -10,7 +10,8 @@ namespace compwolf::vulkan
 {
 	vulkan_gpu_connection::vulkan_gpu_connection(
 		vulkan_graphics_environment& environment,
-		vulkan_handle::physical_device vulkan_physical_device)
+		vulkan_handle::physical_device vulkan_physical_device,
+		const vulkan_graphics_environment_settings& settings)
 		: gpu_connection<vulkan_graphics_environment>(environment, 0)
 		, _vulkan_physical_device(vulkan_physical_device)
 	{
@@ -48,13 +49,84 @@ namespace compwolf::vulkan
 			[](VkExtensionProperties a) { return 0 == std::strcmp(a.extensionName, VK_KHR_SWAPCHAIN_EXTENSION_NAME); }
 		);
 
-		bool is_present_device = has_swapchain_extension && features.samplerAnisotropy;
+		// Without windows, the gpu does not display anything; the instance also lacks the surface-extensions that the swapchain-extension requires.
+		bool is_present_device = !settings.headless && has_swapchain_extension && features.samplerAnisotropy;
 		if (is_present_device)
 		{
 			enabled_extensions.emplace_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
 			enabled_features.samplerAnisotropy = VK_TRUE;
 		}
 
+		// Several draws at once lets a camera's culling draw all of its visible drawables with the same state together.
+		_max_draw_indirect_count = 1;
+		if (features.multiDrawIndirect)
+		{
+			enabled_features.multiDrawIndirect = VK_TRUE;
+			_max_draw_indirect_count = properties.limits.maxDrawIndirectCount;
+		}
+		// A camera's culling gives each indirect draw the drawable's slot of push fields as its first instance.
+		if (features.drawIndirectFirstInstance)
+		{
+			enabled_features.drawIndirectFirstInstance = VK_TRUE;
+			_supports_draw_indirect_first_instance = true;
+		}
+
+		// Work on the gpu is synchronized with timeline semaphores, which are part of vulkan 1.2, and given to the gpu with vkQueueSubmit2, which is part of vulkan 1.3.
+		if (properties.apiVersion < VK_API_VERSION_1_3)
+			throw std::runtime_error("Could not set up a connection to a gpu; the machine does not support vulkan 1.3.");
+
+		VkPhysicalDeviceVulkan12Features enabled_vulkan12_features{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+			.timelineSemaphore = VK_TRUE,
+		};
+		{
+			VkPhysicalDeviceVulkan12Features vulkan12_features{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+			};
+			VkPhysicalDeviceFeatures2 features2{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+				.pNext = &vulkan12_features,
+			};
+			vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+
+			if (!vulkan12_features.timelineSemaphore)
+				throw std::runtime_error("Could not set up a connection to a gpu; the machine does not support timeline semaphores.");
+
+			if (vulkan12_features.drawIndirectCount)
+			{
+				enabled_vulkan12_features.drawIndirectCount = VK_TRUE;
+				_supports_draw_indirect_count = true;
+			}
+		}
+
+		VkPhysicalDeviceVulkan13Features enabled_vulkan13_features{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES,
+			.synchronization2 = VK_TRUE,
+		};
+		{
+			VkPhysicalDeviceVulkan13Features vulkan13_features{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES,
+			};
+			VkPhysicalDeviceFeatures2 features2{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+				.pNext = &vulkan13_features,
+			};
+			vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+
+			if (!vulkan13_features.synchronization2)
+				throw std::runtime_error("Could not set up a connection to a gpu; the machine does not support vkQueueSubmit2.");
+
+			if (settings.dynamic_rendering && vulkan13_features.dynamicRendering)
+			{
+				enabled_vulkan13_features.dynamicRendering = VK_TRUE;
+				_uses_dynamic_rendering = true;
+			}
+		}
+
+		const void* enabled_feature_chain = &enabled_vulkan13_features;
+		enabled_vulkan12_features.pNext = const_cast<void*>(enabled_feature_chain);
+		enabled_feature_chain = &enabled_vulkan12_features;
+
 		const float queue_priority_item = .0f;
 		std::vector<float> queue_priority(8, queue_priority_item);
 
@@ -71,7 +143,7 @@ namespace compwolf::vulkan
 			{
 				auto& queueFamily = queueFamilies[queue_index];
 
-				vulkan_gpu_thread_family connection;
+				vulkan_gpu_thread_family connection{};
 
 				bool draw_queue = queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT;
 				if (draw_queue) connection.work_types[gpu_work_type::draw] = true;
@@ -80,6 +152,13 @@ namespace compwolf::vulkan
 					&& glfwGetPhysicalDevicePresentationSupport(instance, physicalDevice, static_cast<uint32_t>(queue_index));
 				if (present_queue) connection.work_types[gpu_work_type::present] = true;
 
+				bool compute_queue = queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT;
+				if (compute_queue) connection.work_types[gpu_work_type::compute] = true;
+
+				// Queues that can draw or compute can also copy, even if they do not say so.
+				bool transfer_queue = queueFamily.queueFlags & (VK_QUEUE_TRANSFER_BIT | VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+				if (transfer_queue) connection.work_types[gpu_work_type::transfer] = true;
+
 				auto queue_count = queueFamily.queueCount;
 				connection.threads.resize(queue_count);
 				if (queue_priority.size() < queue_count) queue_priority.resize(queue_count, queue_priority_item);
@@ -99,6 +178,7 @@ namespace compwolf::vulkan
 
 		VkDeviceCreateInfo createInfo{
 			.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+			.pNext = enabled_feature_chain,
 			.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size()),
 			.pQueueCreateInfos = queueCreateInfos.data(),
 			.enabledExtensionCount = static_cast<uint32_t>(enabled_extensions.size()),
@@ -128,6 +208,11 @@ namespace compwolf::vulkan
 			}
 		);
 
+		_deletion_queue = std::make_unique<vulkan_deletion_queue>(_vulkan_device.get());
+		_fence_reactor = std::make_unique<vulkan_fence_reactor>(_vulkan_device.get());
+		_object_pool = std::make_unique<vulkan_object_pool>(_vulkan_device.get(), *_deletion_queue);
+		_pipeline_cache = vulkan_pipeline_cache(vulkan_physical_device, _vulkan_device.get(), settings.pipeline_cache_directory);
+
 		for (uint32_t family_index = 0; family_index < _thread_families.size(); ++family_index)
 		{
 			auto& family = _thread_families[family_index];
@@ -146,4 +231,85 @@ namespace compwolf::vulkan
 	{
 		return environment().vulkan_instance();
 	}
+
+	auto vulkan_gpu_connection::outstanding_work(const vulkan_gpu_thread& thread) const noexcept -> uint64_t
+	{
+		auto logicDevice = to_vulkan(vulkan_device());
+
+		uint64_t work = 0;
+		for (auto& weak_timeline : thread.timelines)
+		{
+			auto timeline = weak_timeline.lock();
+			if (!timeline) continue;
+
+			auto submitted_value = timeline->submitted_value.load(std::memory_order_acquire);
+			uint64_t reached_value;
+			if (vkGetSemaphoreCounterValue(logicDevice, to_vulkan(timeline->semaphore.get()), &reached_value) != VK_SUCCESS) reached_value = 0;
+
+			if (submitted_value > reached_value) work += submitted_value - reached_value;
+		}
+		return work;
+	}
+
+	auto vulkan_gpu_connection::vulkan_render_pass(vulkan_handle::format format, bool offscreen) -> vulkan_handle::render_pass
+	{
+		auto key = std::make_pair(format, offscreen);
+		auto i = _render_passes.find(key);
+		if (i != _render_passes.end()) return i->second.get();
+
+		auto logicDevice = to_vulkan(vulkan_device());
+
+		VkRenderPass renderPass;
+		{
+			VkAttachmentDescription colorAttachment{
+				.format = static_cast<VkFormat>(format),
+				.samples = VK_SAMPLE_COUNT_1_BIT,
+				.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+				.storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+				.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+				.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+				.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+				.finalLayout = offscreen
+					? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+					: VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+			};
+
+			VkAttachmentReference colorAttachmentReference{
+				.attachment = 0,
+				.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+			};
+			VkSubpassDescription subpass{
+				.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
+				.colorAttachmentCount = 1,
+				.pColorAttachments = &colorAttachmentReference,
+			};
+
+			VkRenderPassCreateInfo createInfo{
+				.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+				.attachmentCount = 1,
+				.pAttachments = &colorAttachment,
+				.subpassCount = 1,
+				.pSubpasses = &subpass,
+			};
+
+			auto result = vkCreateRenderPass(logicDevice, &createInfo, nullptr, &renderPass);
+
+			switch (result)
+			{
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not create a window's \"render pass\" for drawing on it: ")
+					throw std::runtime_error(message);
+			}
+		}
+
+		return _render_passes.emplace(key, unique_deleter_ptr<vulkan_handle::render_pass_t>(from_vulkan(renderPass),
+			[logicDevice](vulkan_handle::render_pass p)
+			{
+				vkDestroyRenderPass(logicDevice, to_vulkan(p), nullptr);
+			}
+		)).first->second.get();
+	}
 }
@@ -1,6 +1,7 @@
 #include "private/vulkan_graphics_environments/vulkan_graphics_environment.hpp"
 #include "compwolf_vulkan.hpp"
 
+#include <profilers>
 #include <atomic>
 #include <stdexcept>
 
@@ -23,7 +24,7 @@ namespace compwolf::vulkan
 		auto newInstanceCount = ++_instanceCount;
 		if (newInstanceCount == 1) try
 		{
-			_glfw_environment = glfw_environment(_settings);
+			if (!_settings.headless) _glfw_environment = glfw_environment(_settings);
 			_vulkan_environment = vulkan_environment(_settings);
 			_vulkan_debug_environment = vulkan_debug_environment(_settings, vulkan_instance());
 
@@ -52,7 +53,7 @@ namespace compwolf::vulkan
 				for (auto& physical_device : physicalDevices)
 				{
 					auto vulkan_physical_device = from_vulkan(physical_device);
-					vulkan_gpu_connection new_gpu(*this, vulkan_physical_device);
+					vulkan_gpu_connection new_gpu(*this, vulkan_physical_device, _settings);
 					_gpus.push_back(std::move(new_gpu));
 				}
 			}
@@ -85,8 +86,15 @@ namespace compwolf::vulkan
 
 	void vulkan_graphics_environment::update()
 	{
+		COMPWOLF_PROFILE_ZONE("graphics_environment::update");
 		if (!is_this_main_thread()) throw std::logic_error("graphics_environment.update() was called on a thread that is not the main graphics thread.");
 
-		glfwPollEvents();
+		if (!headless()) glfwPollEvents();
+
+		for (auto& gpu : gpus())
+		{
+			gpu.fence_reactor().poll();
+			gpu.deletion_queue().collect();
+		}
 	}
 }
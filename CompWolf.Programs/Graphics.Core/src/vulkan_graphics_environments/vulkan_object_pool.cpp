@@ -0,0 +1,248 @@
+#include "private/vulkan_graphics_environments/vulkan_object_pool.hpp"
+#include "compwolf_vulkan.hpp"
+
+#include <stdexcept>
+
+namespace compwolf::vulkan
+{
+	/******************************** modifiers ********************************/
+
+	auto vulkan_object_pool::new_semaphore() -> unique_deleter_ptr<vulkan_handle::semaphore_t>
+	{
+		auto logicDevice = to_vulkan(_vulkan_device);
+
+		vulkan_handle::semaphore semaphore = nullptr;
+		{
+			std::lock_guard lock(_mutex);
+			if (!_free_semaphores.empty())
+			{
+				semaphore = _free_semaphores.back();
+				_free_semaphores.pop_back();
+				++_stats.semaphores.reused;
+			}
+		}
+
+		if (!semaphore)
+		{
+			VkSemaphoreCreateInfo createInfo{
+				.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+			};
+
+			VkSemaphore vkSemaphore;
+			auto result = vkCreateSemaphore(logicDevice, &createInfo, nullptr, &vkSemaphore);
+
+			switch (result)
+			{
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not create a gpu semaphore: ")
+					throw std::runtime_error(message);
+			}
+			semaphore = from_vulkan(vkSemaphore);
+
+			std::lock_guard lock(_mutex);
+			++_stats.semaphores.created;
+		}
+
+		auto deletion_queue = _deletion_queue;
+		return unique_deleter_ptr<vulkan_handle::semaphore_t>(semaphore,
+			[this, logicDevice, deletion_queue](vulkan_handle::semaphore s)
+			{
+				deletion_queue->defer([this, logicDevice, s]()
+					{
+						std::lock_guard lock(_mutex);
+						try
+						{
+							_free_semaphores.push_back(s);
+						}
+						catch (...)
+						{
+							vkDestroySemaphore(logicDevice, to_vulkan(s), nullptr);
+						}
+					}
+				);
+			}
+		);
+	}
+
+	auto vulkan_object_pool::new_timeline() -> std::shared_ptr<vulkan_tracked_timeline>
+	{
+		vulkan_tracked_timeline* free_timeline = nullptr;
+		{
+			std::lock_guard lock(_mutex);
+			if (!_free_timelines.empty())
+			{
+				free_timeline = _free_timelines.back();
+				_free_timelines.pop_back();
+				++_stats.timelines.reused;
+			}
+		}
+		if (free_timeline)
+		{
+			auto timeline = share_timeline(free_timeline);
+			_deletion_queue->track_timeline(timeline);
+			return timeline;
+		}
+
+		auto logicDevice = to_vulkan(_vulkan_device);
+
+		VkSemaphoreTypeCreateInfo typeInfo{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+			.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+			.initialValue = 0,
+		};
+		VkSemaphoreCreateInfo createInfo{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+			.pNext = &typeInfo,
+		};
+
+		VkSemaphore semaphore;
+		auto result = vkCreateSemaphore(logicDevice, &createInfo, nullptr, &semaphore);
+
+		switch (result)
+		{
+		case VK_SUCCESS: break;
+		default:
+			const char* message;
+			GET_VULKAN_ERROR_STRING(result, message,
+				"Could not create a gpu timeline semaphore: ")
+				throw std::runtime_error(message);
+		}
+
+		auto semaphore_ptr = unique_deleter_ptr<vulkan_handle::semaphore_t>(from_vulkan(semaphore),
+			[logicDevice](vulkan_handle::semaphore s)
+			{
+				vkDestroySemaphore(logicDevice, to_vulkan(s), nullptr);
+			}
+		);
+		auto new_timeline = new vulkan_tracked_timeline{};
+		new_timeline->semaphore = std::move(semaphore_ptr);
+
+		auto timeline = share_timeline(new_timeline);
+		{
+			std::lock_guard lock(_mutex);
+			++_stats.timelines.created;
+		}
+		_deletion_queue->track_timeline(timeline);
+		return timeline;
+	}
+
+	auto vulkan_object_pool::new_command(vulkan_handle::command_pool command_pool) -> unique_deleter_ptr<vulkan_handle::command_t>
+	{
+		auto logicDevice = to_vulkan(_vulkan_device);
+		auto vkCommandPool = to_vulkan(command_pool);
+
+		vulkan_handle::command command = nullptr;
+		{
+			std::lock_guard lock(_mutex);
+			auto i = _free_commands.find(command_pool);
+			if (i != _free_commands.end() && !i->second.empty())
+			{
+				command = i->second.back();
+				i->second.pop_back();
+				++_stats.commands.reused;
+			}
+		}
+
+		if (!command)
+		{
+			VkCommandBufferAllocateInfo createInfo{
+				.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+				.commandPool = vkCommandPool,
+				.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+				.commandBufferCount = 1,
+			};
+
+			VkCommandBuffer commandBuffer;
+			auto result = vkAllocateCommandBuffers(logicDevice, &createInfo, &commandBuffer);
+
+			switch (result)
+			{
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not set up a gpu program's \"command buffer\": ")
+					throw std::runtime_error(message);
+			}
+			command = from_vulkan(commandBuffer);
+
+			std::lock_guard lock(_mutex);
+			++_stats.commands.created;
+		}
+
+		auto deletion_queue = _deletion_queue;
+		return unique_deleter_ptr<vulkan_handle::command_t>(command,
+			[this, logicDevice, vkCommandPool, command_pool, deletion_queue](vulkan_handle::command c)
+			{
+				deletion_queue->defer([this, logicDevice, vkCommandPool, command_pool, c]()
+					{
+						std::lock_guard lock(_mutex);
+						try
+						{
+							_free_commands[command_pool].push_back(c);
+						}
+						catch (...)
+						{
+							auto vkCommand = to_vulkan(c);
+							vkFreeCommandBuffers(logicDevice, vkCommandPool, 1, &vkCommand);
+						}
+					}
+				);
+			}
+		);
+	}
+
+	void vulkan_object_pool::forget_command_pool(vulkan_handle::command_pool command_pool) noexcept
+	{
+		std::lock_guard lock(_mutex);
+		_free_commands.erase(command_pool);
+	}
+
+	/******************************** constructors ********************************/
+
+	vulkan_object_pool::vulkan_object_pool(vulkan_handle::device device, vulkan_deletion_queue& deletion_queue) noexcept
+		: _vulkan_device(device)
+		, _deletion_queue(&deletion_queue)
+	{}
+
+	vulkan_object_pool::~vulkan_object_pool() noexcept
+	{
+		auto logicDevice = to_vulkan(_vulkan_device);
+		for (auto semaphore : _free_semaphores) vkDestroySemaphore(logicDevice, to_vulkan(semaphore), nullptr);
+		for (auto timeline : _free_timelines) delete timeline;
+		// The command buffers are freed together with their command pools.
+	}
+
+	/******************************** private ********************************/
+
+	void vulkan_object_pool::give_back_timeline(vulkan_tracked_timeline* timeline) noexcept
+	{
+		// The timeline can only be reused once the gpu is done with it, as its new owner would otherwise wait on the old owner's work.
+		uint64_t reached_value;
+		auto result = vkGetSemaphoreCounterValue(to_vulkan(_vulkan_device), to_vulkan(timeline->semaphore.get()), &reached_value);
+		if (result == VK_SUCCESS && reached_value >= timeline->submitted_value.load(std::memory_order_acquire))
+		{
+			std::lock_guard lock(_mutex);
+			try
+			{
+				_free_timelines.push_back(timeline);
+				return;
+			}
+			catch (...) {}
+		}
+		delete timeline;
+	}
+
+	auto vulkan_object_pool::share_timeline(vulkan_tracked_timeline* timeline) -> std::shared_ptr<vulkan_tracked_timeline>
+	{
+		return std::shared_ptr<vulkan_tracked_timeline>(timeline,
+			[this](vulkan_tracked_timeline* t)
+			{
+				give_back_timeline(t);
+			}
+		);
+	}
+}
@@ -0,0 +1,147 @@
+#include "private/vulkan_graphics_environments/vulkan_pipeline_cache.hpp"
+#include "compwolf_vulkan.hpp"
+
+#include <stdexcept>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <system_error>
+
+namespace compwolf::vulkan
+{
+	namespace
+	{
+		/** The size of the header that Vulkan puts at the start of a pipeline cache's data, as VkPipelineCacheHeaderVersionOne. */
+		constexpr std::size_t pipeline_cache_header_size = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+
+		/** Returns whether the given data, loaded from a file, is a pipeline cache made for the given gpu and driver. */
+		auto valid_pipeline_cache(const std::vector<char>& data, const VkPhysicalDeviceProperties& properties) noexcept -> bool
+		{
+			if (data.size() < pipeline_cache_header_size) return false;
+
+			uint32_t header[4];
+			std::memcpy(header, data.data(), sizeof(header));
+			auto header_size = header[0];
+			auto header_version = header[1];
+			auto vendor_id = header[2];
+			auto device_id = header[3];
+
+			if (header_size < pipeline_cache_header_size || data.size() < header_size) return false;
+			if (header_version != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) return false;
+			if (vendor_id != properties.vendorID || device_id != properties.deviceID) return false;
+			return 0 == std::memcmp(data.data() + sizeof(header), properties.pipelineCacheUUID, VK_UUID_SIZE);
+		}
+
+		/** Writes the given cache's data to the given file.
+		 * The data is first written to another file, which then replaces the given file, so that a crash cannot leave a half-written cache.
+		 * @return Whether the cache was written.
+		 */
+		auto write_pipeline_cache(VkDevice logicDevice, VkPipelineCache cache, const std::filesystem::path& path) noexcept -> bool
+		{
+			try
+			{
+				std::vector<char> data;
+				{
+					std::size_t size;
+					if (vkGetPipelineCacheData(logicDevice, cache, &size, nullptr) != VK_SUCCESS) return false;
+					data.resize(size);
+					if (vkGetPipelineCacheData(logicDevice, cache, &size, data.data()) != VK_SUCCESS) return false;
+					data.resize(size);
+				}
+
+				std::error_code error;
+				std::filesystem::create_directories(path.parent_path(), error);
+
+				auto temporary_path = path;
+				temporary_path += ".tmp";
+				{
+					std::ofstream stream(temporary_path, std::ios::binary | std::ios::out | std::ios::trunc);
+					if (!stream.is_open()) return false;
+					stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+					if (!stream) return false;
+				}
+				std::filesystem::rename(temporary_path, path, error);
+				return !error;
+			}
+			catch (...)
+			{
+				return false;
+			}
+		}
+	}
+
+	/******************************** modifiers ********************************/
+
+	void vulkan_pipeline_cache::save()
+	{
+		if (_path.empty()) return;
+
+		if (!write_pipeline_cache(to_vulkan(_vulkan_device), to_vulkan(_vulkan_pipeline_cache.get()), _path))
+			throw std::runtime_error("Could not save a pipeline cache to \"" + _path.string() + "\".");
+	}
+
+	/******************************** constructors ********************************/
+
+	vulkan_pipeline_cache::vulkan_pipeline_cache(vulkan_handle::physical_device physical_device
+		, vulkan_handle::device device
+		, std::string_view directory)
+		: _vulkan_device(device)
+	{
+		auto physicalDevice = to_vulkan(physical_device);
+		auto logicDevice = to_vulkan(device);
+
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+		std::vector<char> data;
+		if (!directory.empty())
+		{
+			// The file is named after the gpu and driver, so that machines with several gpus keep a cache for each.
+			_path = std::filesystem::path(directory) / ("CompWolf.pipeline_cache."
+				+ std::to_string(properties.vendorID) + "."
+				+ std::to_string(properties.deviceID) + "."
+				+ std::to_string(properties.driverVersion) + ".bin");
+
+			std::ifstream stream(_path, std::ios::binary | std::ios::in | std::ios::ate);
+			if (stream.is_open())
+			{
+				data.resize(static_cast<std::size_t>(stream.tellg()));
+				stream.seekg(0);
+				stream.read(data.data(), static_cast<std::streamsize>(data.size()));
+				if (!stream || !valid_pipeline_cache(data, properties)) data.clear();
+			}
+		}
+
+		VkPipelineCache pipelineCache;
+		{
+			VkPipelineCacheCreateInfo createInfo{
+				.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+				.initialDataSize = data.size(),
+				.pInitialData = data.empty() ? nullptr : data.data(),
+			};
+
+			auto result = vkCreatePipelineCache(logicDevice, &createInfo, nullptr, &pipelineCache);
+
+			switch (result)
+			{
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not create a pipeline cache on the GPU: ")
+					throw std::runtime_error(message);
+			}
+
+			_vulkan_pipeline_cache = unique_deleter_ptr<vulkan_handle::pipeline_cache_t>(from_vulkan(pipelineCache),
+				[logicDevice, path = _path](vulkan_handle::pipeline_cache c)
+				{
+					if (!path.empty()) write_pipeline_cache(logicDevice, to_vulkan(c), path);
+					vkDestroyPipelineCache(logicDevice, to_vulkan(c), nullptr);
+				}
+			);
+		}
+
+		_stats.loaded_size = data.size();
+	}
+}
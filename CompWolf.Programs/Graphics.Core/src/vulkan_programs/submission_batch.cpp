@@ -0,0 +1,58 @@
+#include <private/vulkan_programs/submission_batch.hpp>
+
+#include <algorithm>
+#include <span>
+#include <utility>
+
+namespace compwolf::vulkan
+{
+	/******************************** modifiers ********************************/
+
+	auto submission_batch::flush() -> std::size_t
+	{
+		// The work is taken out of the batch first, so that it is not given to the gpu again if submitting it throws.
+		auto submissions = std::move(_submissions);
+		_submissions.clear();
+		auto submit_calls = submit_programs(std::span<const vulkan_gpu_submission>(submissions));
+
+		_stats = submission_batch_stats{
+			.submissions = submissions.size(),
+			.programs = static_cast<std::size_t>(std::count_if(submissions.begin(), submissions.end()
+				, [](const vulkan_gpu_submission& submission) { return submission.command != nullptr; }
+			)),
+			.submit_calls = submit_calls,
+		};
+
+		// The vector is kept, so that the batch does not allocate again when reused.
+		submissions.clear();
+		_submissions = std::move(submissions);
+		return submit_calls;
+	}
+
+	/******************************** constructors ********************************/
+
+	auto submission_batch::operator=(submission_batch&& other) -> submission_batch&
+	{
+		if (this == &other) return *this;
+
+		if (!empty()) flush();
+		_submissions = std::move(other._submissions);
+		other._submissions.clear();
+		_stats = other._stats;
+		return *this;
+	}
+
+	submission_batch::~submission_batch() noexcept
+	{
+		if (empty()) return;
+
+		try
+		{
+			flush();
+		}
+		catch (...)
+		{
+			// The work that could not be given to the gpu still signals its fences, so nothing is left waiting for it.
+		}
+	}
+}
@@ -0,0 +1,231 @@
+#include "private/vulkan_programs/vulkan_barrier_batch.hpp"
+#include "compwolf_vulkan.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace compwolf::vulkan
+{
+	/******************************** free functions ********************************/
+
+	auto vulkan_access_info(vulkan_resource_access access) noexcept -> vulkan_resource_access_info
+	{
+		// Buffer-only uses give VK_IMAGE_LAYOUT_GENERAL, as it is valid for any use of an image.
+		switch (access)
+		{
+		case vulkan_resource_access::indirect_read:
+			return { VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, false };
+		case vulkan_resource_access::index_read:
+			return { VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT, VK_ACCESS_2_INDEX_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, false };
+		case vulkan_resource_access::vertex_read:
+			return { VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, false };
+		case vulkan_resource_access::vertex_shader_read:
+			return { VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_UNIFORM_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, false };
+		case vulkan_resource_access::fragment_shader_read:
+			return { VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_UNIFORM_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, false };
+		case vulkan_resource_access::compute_shader_read:
+			return { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_UNIFORM_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, false };
+		case vulkan_resource_access::compute_shader_write:
+			return { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL, true };
+		case vulkan_resource_access::color_attachment_write:
+			return { VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, true };
+		case vulkan_resource_access::copy_read:
+			return { VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, false };
+		case vulkan_resource_access::copy_write:
+			return { VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, true };
+		case vulkan_resource_access::clear_write:
+			return { VK_PIPELINE_STAGE_2_CLEAR_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, true };
+		case vulkan_resource_access::host_read:
+			return { VK_PIPELINE_STAGE_2_HOST_BIT, VK_ACCESS_2_HOST_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, false };
+		case vulkan_resource_access::host_write:
+			return { VK_PIPELINE_STAGE_2_HOST_BIT, VK_ACCESS_2_HOST_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL, true };
+		case vulkan_resource_access::present:
+		default:
+			// Presenting is not part of any stage; the semaphore waited on before presenting already waits for all of the work.
+			return { VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, false };
+		}
+	}
+
+	auto vulkan_resource_state::after(vulkan_resource_access access) noexcept -> vulkan_resource_state
+	{
+		auto info = vulkan_access_info(access);
+		return vulkan_resource_state{
+			.write_stages = info.stages,
+			.write_access = info.writes ? info.access : VK_ACCESS_2_NONE,
+			.read_stages = info.writes ? VK_PIPELINE_STAGE_2_NONE : info.stages,
+			.visible_stages = info.stages,
+			.visible_access = info.access,
+			.layout = info.layout,
+		};
+	}
+
+	/******************************** accessors ********************************/
+
+	auto vulkan_barrier_batch::state(vulkan_handle::buffer buffer) const -> vulkan_resource_state
+	{
+		auto i = _buffers.find(buffer);
+		return i == _buffers.end() ? vulkan_resource_state{} : i->second;
+	}
+	auto vulkan_barrier_batch::state(vulkan_handle::image image) const -> vulkan_resource_state
+	{
+		auto i = _images.find(image);
+		return i == _images.end() ? vulkan_resource_state{} : i->second;
+	}
+
+	/******************************** modifiers ********************************/
+
+	void vulkan_barrier_batch::track(vulkan_handle::buffer buffer, vulkan_resource_state state)
+	{
+		_buffers[buffer] = state;
+	}
+	void vulkan_barrier_batch::track(vulkan_handle::image image, vulkan_resource_state state)
+	{
+		_images[image] = state;
+	}
+
+	void vulkan_barrier_batch::use(vulkan_handle::buffer buffer, vulkan_resource_access access)
+	{
+		add_use(_buffers[buffer], buffer, nullptr, access, false);
+	}
+	void vulkan_barrier_batch::use(vulkan_handle::image image, vulkan_resource_access access, bool discard_contents)
+	{
+		add_use(_images[image], nullptr, image, access, discard_contents);
+	}
+
+	void vulkan_barrier_batch::flush()
+	{
+		if (_pending.empty()) return;
+
+		VkImageSubresourceRange subresourceRange{
+			.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+			.baseMipLevel = 0,
+			.levelCount = 1,
+			.baseArrayLayer = 0,
+			.layerCount = 1,
+		};
+
+		std::vector<VkBufferMemoryBarrier2> bufferBarriers;
+		std::vector<VkImageMemoryBarrier2> imageBarriers;
+		for (auto& barrier : _pending)
+		{
+			if (barrier.buffer)
+			{
+				bufferBarriers.push_back(VkBufferMemoryBarrier2{
+					.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+					.srcStageMask = barrier.src_stages,
+					.srcAccessMask = barrier.src_access,
+					.dstStageMask = barrier.dst_stages,
+					.dstAccessMask = barrier.dst_access,
+					.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+					.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+					.buffer = to_vulkan(barrier.buffer),
+					.offset = 0,
+					.size = VK_WHOLE_SIZE,
+				});
+			}
+			else
+			{
+				imageBarriers.push_back(VkImageMemoryBarrier2{
+					.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+					.srcStageMask = barrier.src_stages,
+					.srcAccessMask = barrier.src_access,
+					.dstStageMask = barrier.dst_stages,
+					.dstAccessMask = barrier.dst_access,
+					.oldLayout = static_cast<VkImageLayout>(barrier.old_layout),
+					.newLayout = static_cast<VkImageLayout>(barrier.new_layout),
+					.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+					.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+					.image = to_vulkan(barrier.image),
+					.subresourceRange = subresourceRange,
+				});
+			}
+		}
+
+		VkDependencyInfo dependencyInfo{
+			.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+			.bufferMemoryBarrierCount = static_cast<uint32_t>(bufferBarriers.size()),
+			.pBufferMemoryBarriers = bufferBarriers.data(),
+			.imageMemoryBarrierCount = static_cast<uint32_t>(imageBarriers.size()),
+			.pImageMemoryBarriers = imageBarriers.data(),
+		};
+		vkCmdPipelineBarrier2(to_vulkan(_command), &dependencyInfo);
+
+		_stats.barriers += _pending.size();
+		++_stats.calls;
+		_pending.clear();
+	}
+
+	/******************************** private ********************************/
+
+	void vulkan_barrier_batch::add_use(vulkan_resource_state& state
+		, vulkan_handle::buffer buffer, vulkan_handle::image image
+		, vulkan_resource_access access, bool discard_contents
+	) {
+		auto info = vulkan_access_info(access);
+		bool transition = image && (discard_contents || state.layout != info.layout);
+
+		vulkan_handle::pipeline_stages src_stages;
+		bool needs_barrier;
+		if (info.writes || transition)
+		{
+			// Writes, including layout changes, must wait for every earlier use, so that the earlier uses do not see the new data.
+			src_stages = state.write_stages | state.read_stages;
+			needs_barrier = transition || src_stages != VK_PIPELINE_STAGE_2_NONE;
+		}
+		else
+		{
+			// Reads only wait for the latest write, and only if the write is not already visible to them.
+			src_stages = state.write_stages;
+			needs_barrier = src_stages != VK_PIPELINE_STAGE_2_NONE
+				&& ((info.stages & ~state.visible_stages) != 0 || (info.access & ~state.visible_access) != 0);
+		}
+
+		if (needs_barrier)
+		{
+			auto pending = std::find_if(_pending.begin(), _pending.end()
+				, [buffer, image](const vulkan_pending_barrier& p) { return p.buffer == buffer && p.image == image; }
+			);
+			if (pending == _pending.end())
+			{
+				_pending.push_back(vulkan_pending_barrier{
+					.buffer = buffer,
+					.image = image,
+					.src_stages = src_stages,
+					.src_access = state.write_access,
+					.dst_stages = info.stages,
+					.dst_access = info.access,
+					.old_layout = discard_contents ? vulkan_handle::image_layout{ VK_IMAGE_LAYOUT_UNDEFINED } : state.layout,
+					.new_layout = info.layout,
+				});
+			}
+			else
+			{
+				// Uses between flushes happen together, so a single barrier can make the resource ready for all of them.
+				if (image && pending->new_layout != info.layout)
+					throw std::logic_error("Could not use an image in different layouts without flushing the barriers between the uses.");
+				pending->dst_stages |= info.stages;
+				pending->dst_access |= info.access;
+			}
+		}
+
+		if (info.writes || transition)
+		{
+			// A layout change is a write done by the barrier itself, so later uses in other stages must wait for it like any other write.
+			state.write_stages = info.stages;
+			state.write_access = info.writes ? info.access : VK_ACCESS_2_NONE;
+			state.read_stages = info.writes ? VK_PIPELINE_STAGE_2_NONE : info.stages;
+			state.visible_stages = info.stages;
+			state.visible_access = info.access;
+		}
+		else
+		{
+			if (needs_barrier)
+			{
+				state.visible_stages |= info.stages;
+				state.visible_access |= info.access;
+			}
+			state.read_stages |= info.stages;
+		}
+		if (image) state.layout = info.layout;
+	}
+}
@@ -1,69 +1,127 @@
 #include <private/vulkan_programs/vulkan_gpu_fence.hpp>
 
 #include "compwolf_vulkan.hpp"
-#include <stdexcept>
+#include <profilers>
+#include <algorithm>
 #include <limits>
+#include <vector>
+#include <utility>
 
 namespace compwolf::vulkan
 {
-	/******************************** constructors ********************************/
-
-	vulkan_gpu_fence::vulkan_gpu_fence(vulkan_gpu_connection& target_gpu, bool signaled)
-		: gpu_fence(target_gpu)
+	namespace
 	{
-		auto logicDevice = to_vulkan(gpu().vulkan_device());
-
-		VkFenceCreateInfo createInfo{
-			.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
-		};
-		if (signaled) createInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
-		VkFence fence;
-		auto result = vkCreateFence(logicDevice, &createInfo, nullptr, &fence);
-
-		switch (result)
+		/** Converts the given time to a timeout for vkWaitSemaphores; the maximum time is waited on forever. */
+		auto to_vulkan_timeout(std::chrono::nanoseconds timeout) noexcept -> uint64_t
 		{
-		case VK_SUCCESS: break;
-		default:
-			const char* message;
-			GET_VULKAN_ERROR_STRING(result, message,
-				"Could not create a gpu fence: ")
-				throw std::runtime_error(message);
+			if (timeout == std::chrono::nanoseconds::max()) return std::numeric_limits<uint64_t>::max();
+			if (timeout.count() < 0) return 0;
+			return static_cast<uint64_t>(timeout.count());
 		}
-
-		_vulkan_fence = unique_deleter_ptr<vulkan_handle::fence_t>(from_vulkan(fence),
-			[logicDevice](vulkan_handle::fence f)
-			{
-				auto fence = to_vulkan(f);
-				vkWaitForFences(logicDevice, 1, &fence, VK_TRUE, UINT64_MAX);
-				vkDestroyFence(logicDevice, fence, nullptr);
-			}
-		);
 	}
 
+	/******************************** constructors ********************************/
+
+	vulkan_gpu_fence::vulkan_gpu_fence(vulkan_gpu_connection& target_gpu, vulkan_handle::semaphore timeline, uint64_t value) noexcept
+		: gpu_fence(target_gpu)
+		, _vulkan_timeline(timeline)
+		, _value(value)
+	{}
+
 	auto vulkan_gpu_fence::completed() const noexcept -> bool
 	{
-		auto logicDevice = to_vulkan(gpu().vulkan_device());
-		auto fence = to_vulkan(vulkan_fence());
+		if (_value == 0) return true;
 
-		return vkWaitForFences(logicDevice, 1, &fence, VK_TRUE, 0) == VK_SUCCESS;
+		auto logicDevice = to_vulkan(gpu().vulkan_device());
+		uint64_t reached_value;
+		if (vkGetSemaphoreCounterValue(logicDevice, to_vulkan(vulkan_timeline()), &reached_value) != VK_SUCCESS) return false;
+		return reached_value >= _value;
 	}
 
 	/******************************** modifiers ********************************/
 
 	void vulkan_gpu_fence::wait() const noexcept
 	{
+		wait_for(std::chrono::nanoseconds::max());
+	}
+	auto vulkan_gpu_fence::wait_for(std::chrono::nanoseconds timeout) const noexcept -> bool
+	{
+		if (_value == 0) return true;
+
+		COMPWOLF_PROFILE_ZONE("vulkan_gpu_fence::wait");
 		auto logicDevice = to_vulkan(gpu().vulkan_device());
-		auto fence = to_vulkan(vulkan_fence());
+		auto semaphore = to_vulkan(vulkan_timeline());
 
-		vkWaitForFences(logicDevice, 1, &fence, VK_TRUE, UINT64_MAX);
+		VkSemaphoreWaitInfo waitInfo{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+			.semaphoreCount = 1,
+			.pSemaphores = &semaphore,
+			.pValues = &_value,
+		};
+		return vkWaitSemaphores(logicDevice, &waitInfo, to_vulkan_timeout(timeout)) == VK_SUCCESS;
 	}
 
-	void vulkan_gpu_fence::reset() noexcept
+	void vulkan_gpu_fence::when_done(std::function<void()> callback) const
 	{
-		auto logicDevice = to_vulkan(gpu().vulkan_device());
-		auto fence = to_vulkan(vulkan_fence());
+		// The fence only refers to the gpu; giving the gpu's reactor work does not change the fence.
+		auto& target_gpu = const_cast<vulkan_gpu_connection&>(gpu());
+		target_gpu.fence_reactor().when_reached(vulkan_timeline(), _value, std::move(callback));
+	}
+
+	/******************************** free functions ********************************/
+
+	auto wait_for_fences(std::span<const vulkan_gpu_fence* const> fences, bool wait_all, std::chrono::nanoseconds timeout) noexcept -> bool
+	{
+		COMPWOLF_PROFILE_ZONE("wait_for_fences");
+
+		// Each timeline only needs to be waited on once, for the highest value if all are waited on, otherwise the lowest.
+		std::vector<VkSemaphore> semaphores;
+		std::vector<uint64_t> values;
+		try
+		{
+			semaphores.reserve(fences.size());
+			values.reserve(fences.size());
+			for (auto fence : fences)
+			{
+				if (fence->value() == 0)
+				{
+					if (wait_all) continue;
+					return true;
+				}
 
-		vkResetFences(logicDevice, 1, &fence);
+				auto semaphore = to_vulkan(fence->vulkan_timeline());
+				auto i = std::find(semaphores.begin(), semaphores.end(), semaphore);
+				if (i == semaphores.end())
+				{
+					semaphores.push_back(semaphore);
+					values.push_back(fence->value());
+					continue;
+				}
+
+				auto& value = values[i - semaphores.begin()];
+				value = wait_all ? std::max(value, fence->value()) : std::min(value, fence->value());
+			}
+		}
+		catch (...)
+		{
+			// Without memory to merge the fences, they are waited on one at a time.
+			for (auto fence : fences)
+			{
+				bool done = fence->wait_for(timeout);
+				if (done != wait_all) return done;
+			}
+			return wait_all;
+		}
+		if (semaphores.empty()) return true;
+
+		VkSemaphoreWaitInfo waitInfo{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+			.flags = wait_all ? VkSemaphoreWaitFlags(0) : VkSemaphoreWaitFlags(VK_SEMAPHORE_WAIT_ANY_BIT),
+			.semaphoreCount = static_cast<uint32_t>(semaphores.size()),
+			.pSemaphores = semaphores.data(),
+			.pValues = values.data(),
+		};
+		auto logicDevice = to_vulkan(fences.front()->gpu().vulkan_device());
+		return vkWaitSemaphores(logicDevice, &waitInfo, to_vulkan_timeout(timeout)) == VK_SUCCESS;
 	}
 }
@@ -0,0 +1,233 @@
+#include "private/vulkan_programs/vulkan_gpu_profiler.hpp"
+#include "compwolf_vulkan.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+
+namespace compwolf::vulkan
+{
+	namespace
+	{
+		/** The index of the timestamp written at the start of a frame. */
+		constexpr uint32_t frame_start_query = 0;
+		/** The index of the timestamp written at the end of a frame. */
+		constexpr uint32_t frame_end_query = 1;
+		/** The index of the first timestamp written by a scope. */
+		constexpr uint32_t first_scope_query = 2;
+
+		/** The amount of timestamps that a pool can contain before any frame needed more. */
+		constexpr uint32_t initial_capacity = 64;
+
+		constexpr std::size_t invalid_scope = std::numeric_limits<std::size_t>::max();
+	}
+
+	/******************************** modifiers ********************************/
+
+	void vulkan_gpu_profiler::begin_frame(vulkan_handle::command command, std::size_t frame_in_flight_index)
+	{
+		if (!_supported) return;
+
+		auto& frame = _frames[frame_in_flight_index];
+
+		// The gpu is done with the frame in flight's last work, so its times can be read.
+		// If they still cannot be read, the work was never given to the gpu, and they are dropped.
+		collect();
+		if (frame.pending && !read(frame)) frame.pending = false;
+
+		if (frame.capacity < _needed_capacity) create_pool(frame, _needed_capacity);
+
+		frame.used = first_scope_query;
+		frame.timings.frame_number = _next_frame_number++;
+		frame.timings.frame_in_flight_index = frame_in_flight_index;
+		frame.timings.scopes.clear();
+		frame.timings.dropped_scopes = 0;
+		frame.scope_queries.clear();
+
+		auto commandBuffer = to_vulkan(command);
+		auto pool = to_vulkan(frame.pool.get());
+		vkCmdResetQueryPool(commandBuffer, pool, 0, frame.capacity);
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, pool, frame_start_query);
+
+		_recording = &frame;
+		_recording_command = command;
+	}
+
+	void vulkan_gpu_profiler::end_frame() noexcept
+	{
+		if (!_recording) return;
+		auto& frame = *_recording;
+
+		auto commandBuffer = to_vulkan(_recording_command);
+		auto pool = to_vulkan(frame.pool.get());
+
+		// Every timestamp must be written for the times to be readable, so scopes that were not ended are ended with the frame.
+		while (!_open_scopes.empty()) end_scope(_open_scopes.back());
+
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, pool, frame_end_query);
+
+		auto needed = first_scope_query + static_cast<uint32_t>(2 * (frame.timings.scopes.size() + frame.timings.dropped_scopes));
+		_needed_capacity = std::max(_needed_capacity, needed);
+
+		frame.pending = true;
+		_recording = nullptr;
+		_recording_command = nullptr;
+	}
+
+	auto vulkan_gpu_profiler::begin_scope(std::string_view name) -> std::size_t
+	{
+		if (!_recording) return invalid_scope;
+		auto& frame = *_recording;
+
+		if (frame.used + 2 > frame.capacity)
+		{
+			++frame.timings.dropped_scopes;
+			return invalid_scope;
+		}
+
+		auto query = frame.used;
+		frame.used += 2;
+
+		auto scope = frame.timings.scopes.size();
+		frame.timings.scopes.push_back(gpu_timing_scope{
+			.name = name,
+			.depth = _open_scopes.size(),
+		});
+		frame.scope_queries.push_back(query);
+		_open_scopes.push_back(scope);
+
+		vkCmdWriteTimestamp(to_vulkan(_recording_command), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, to_vulkan(frame.pool.get()), query);
+		return scope;
+	}
+
+	void vulkan_gpu_profiler::end_scope(std::size_t scope) noexcept
+	{
+		if (!_recording || scope == invalid_scope) return;
+		auto& frame = *_recording;
+
+		auto open = std::find(_open_scopes.begin(), _open_scopes.end(), scope);
+		if (open == _open_scopes.end()) return;
+		_open_scopes.erase(open);
+
+		vkCmdWriteTimestamp(to_vulkan(_recording_command), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, to_vulkan(frame.pool.get())
+			, frame.scope_queries[scope] + 1);
+	}
+
+	void vulkan_gpu_profiler::collect()
+	{
+		if (!_supported) return;
+
+		// The frames are read in the order they were recorded, so that frame_timed is invoked in that order.
+		while (true)
+		{
+			frame_data* oldest = nullptr;
+			for (auto& frame : _frames)
+			{
+				if (!frame.pending || &frame == _recording) continue;
+				if (!oldest || frame.timings.frame_number < oldest->timings.frame_number) oldest = &frame;
+			}
+
+			if (!oldest || !read(*oldest)) return;
+		}
+	}
+
+	auto vulkan_gpu_profiler::read(frame_data& frame) -> bool
+	{
+		if (!frame.pending) return true;
+
+		_results.resize(frame.used);
+		auto result = vkGetQueryPoolResults(to_vulkan(_gpu->vulkan_device()), to_vulkan(frame.pool.get())
+			, 0, frame.used
+			, _results.size() * sizeof(uint64_t), _results.data(), sizeof(uint64_t)
+			, VK_QUERY_RESULT_64_BIT
+		);
+
+		switch (result)
+		{
+		case VK_SUCCESS: break;
+		case VK_NOT_READY: return false;
+		default:
+			const char* message;
+			GET_VULKAN_ERROR_STRING(result, message,
+				"Could not read how long the gpu spent on some work: ")
+				throw std::runtime_error(message);
+		}
+		frame.pending = false;
+
+		auto to_duration = [this](uint64_t from, uint64_t to)
+		{
+			auto ticks = (to > from) ? to - from : 0;
+			return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(static_cast<double>(ticks) * _timestamp_period));
+		};
+
+		auto frame_start = _results[frame_start_query];
+		frame.timings.total = to_duration(frame_start, _results[frame_end_query]);
+		for (std::size_t i = 0; i < frame.timings.scopes.size(); ++i)
+		{
+			auto query = frame.scope_queries[i];
+			frame.timings.scopes[i].start = to_duration(frame_start, _results[query]);
+			frame.timings.scopes[i].duration = to_duration(_results[query], _results[query + 1]);
+		}
+
+		_frame_timed.invoke(frame.timings);
+		return true;
+	}
+
+	void vulkan_gpu_profiler::create_pool(frame_data& frame, uint32_t capacity)
+	{
+		auto logicDevice = to_vulkan(_gpu->vulkan_device());
+
+		VkQueryPool queryPool;
+		{
+			VkQueryPoolCreateInfo createInfo{
+				.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+				.queryType = VK_QUERY_TYPE_TIMESTAMP,
+				.queryCount = capacity,
+			};
+
+			auto result = vkCreateQueryPool(logicDevice, &createInfo, nullptr, &queryPool);
+
+			switch (result)
+			{
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not set up timing of the gpu's work: ")
+					throw std::runtime_error(message);
+			}
+		}
+
+		// Submitted work may still write times to an old pool, such as when a camera is destroyed right after drawing, so the pool is destroyed once the gpu is done with it.
+		auto deletion_queue = &_gpu->deletion_queue();
+		frame.pool = unique_deleter_ptr<vulkan_handle::query_pool_t>(from_vulkan(queryPool),
+			[logicDevice, deletion_queue](vulkan_handle::query_pool p)
+			{
+				deletion_queue->defer([logicDevice, p]()
+					{
+						vkDestroyQueryPool(logicDevice, to_vulkan(p), nullptr);
+					}
+				);
+			}
+		);
+		frame.capacity = capacity;
+	}
+
+	/******************************** constructors ********************************/
+
+	vulkan_gpu_profiler::vulkan_gpu_profiler(vulkan_gpu_connection& gpu, std::size_t frames_in_flight)
+		: _gpu(&gpu)
+		, _frames(frames_in_flight)
+		, _needed_capacity(initial_capacity)
+	{
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(to_vulkan(gpu.vulkan_physical_device()), &properties);
+
+		// Without timestampComputeAndGraphics, only some thread families can time their work, and which is not known here.
+		_supported = properties.limits.timestampComputeAndGraphics == VK_TRUE && properties.limits.timestampPeriod > 0.f;
+		_timestamp_period = static_cast<double>(properties.limits.timestampPeriod);
+		if (!_supported) return;
+
+		for (auto& frame : _frames) create_pool(frame, _needed_capacity);
+	}
+}
@@ -1,30 +1,52 @@
 #include <private/vulkan_programs/vulkan_gpu_program.hpp>
 
 #include "compwolf_vulkan.hpp"
+#include <profilers>
+#include <array>
 #include <stdexcept>
+#include <vector>
 
 namespace compwolf::vulkan
 {
 	/******************************** constructors ********************************/
 
 	vulkan_gpu_program::vulkan_gpu_program(vulkan_gpu_program_manager& manager
-		, std::function<void(const vulkan_code_parameters&)> code)
+		, std::function<void(const vulkan_code_parameters&)> code
+		, vulkan_gpu_profiler* profiler, std::size_t profiler_frame_index)
 		: gpu_specific_program(manager.gpu())
 		, _manager(&manager)
 	{
-		auto logicDevice = to_vulkan(gpu().vulkan_device());
+		_vulkan_command = gpu().object_pool().new_command(manager.vulkan_pool());
 
-		VkCommandBuffer commandBuffer;
+		record(code, profiler, profiler_frame_index);
+
+		// This is seemingly needed to get around compiler bug: https://stackoverflow.com/questions/29459040/why-copy-constructor-is-called-instead-of-move-constructor
 		{
-			auto vkCommandPool = to_vulkan(manager.vulkan_pool());
-			VkCommandBufferAllocateInfo createInfo{
-				.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
-				.commandPool = vkCommandPool,
-				.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
-				.commandBufferCount = 1,
+			_manager_destructing_key.~event_key<>();
+			new(&_manager_destructing_key)event_key(manager.destructing().subscribe([this]()
+				{
+					this->~vulkan_gpu_program();
+					new(this)vulkan_gpu_program();
+				}
+			));
+		}
+	}
+
+	/******************************** modifiers ********************************/
+
+	void vulkan_gpu_program::record(const std::function<void(const vulkan_code_parameters&)>& code
+		, vulkan_gpu_profiler* profiler, std::size_t profiler_frame_index)
+	{
+		COMPWOLF_PROFILE_ZONE("vulkan_gpu_program::record");
+		auto commandBuffer = to_vulkan(_vulkan_command.get());
+
+		// The manager's pool is created with VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, so beginning implicitly resets any earlier instructions, including those of an earlier program using the buffer.
+		{
+			VkCommandBufferBeginInfo beginInfo{
+				.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
 			};
 
-			auto result = vkAllocateCommandBuffers(logicDevice, &createInfo, &commandBuffer);
+			auto result = vkBeginCommandBuffer(commandBuffer, &beginInfo);
 
 			switch (result)
 			{
@@ -32,107 +54,243 @@ namespace compwolf::vulkan
 			default:
 				const char* message;
 				GET_VULKAN_ERROR_STRING(result, message,
-					"Could not set up a gpu program's \"command buffer\": ")
+					"Could not begin recording commands for a gpu program: ")
 					throw std::runtime_error(message);
 			}
+		}
 
-			_vulkan_command = unique_deleter_ptr<vulkan_handle::command_t>(from_vulkan(commandBuffer),
-				[logicDevice, vkCommandPool](vulkan_handle::command c)
-				{
-					auto vkCommand = to_vulkan(c);
-					vkDeviceWaitIdle(logicDevice);
-					vkFreeCommandBuffers(logicDevice, vkCommandPool, 1, &vkCommand);
-				}
-			);
+		vulkan_barrier_batch barriers(_vulkan_command.get());
+		vulkan_code_parameters compile_parameter{
+			.command = _vulkan_command.get(),
+			.profiler = profiler,
+			.barriers = &barriers,
+		};
+
+		if (profiler) profiler->begin_frame(_vulkan_command.get(), profiler_frame_index);
+		try
+		{
+			code(compile_parameter);
+			barriers.flush();
 		}
+		catch (...)
+		{
+			if (profiler) profiler->end_frame();
+			throw;
+		}
+		if (profiler) profiler->end_frame();
 
 		{
+			auto result = vkEndCommandBuffer(commandBuffer);
+
+			switch (result)
 			{
-				VkCommandBufferBeginInfo beginInfo{
-					.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
-				};
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not finish recording commands for a gpu program: ")
+					throw std::runtime_error(message);
+			}
+		}
 
-				auto result = vkBeginCommandBuffer(commandBuffer, &beginInfo);
+		_recorded_reset_count = manager().reset_count();
+	}
 
-				switch (result)
-				{
-				case VK_SUCCESS: break;
-				default:
-					const char* message;
-					GET_VULKAN_ERROR_STRING(result, message,
-						"Could not begin recording commands for a gpu program: ")
-						throw std::runtime_error(message);
-				}
-			}
+	auto vulkan_gpu_program::execute() -> const fence_type&
+	{
+		auto submission = prepare_execution();
+		submit_programs(std::span(&submission, 1));
+		return _fence;
+	}
 
-			vulkan_code_parameters compile_parameter{
-				.command = _vulkan_command.get()
-			};
+	auto vulkan_gpu_program::prepare_execution() -> vulkan_gpu_submission
+	{
+		if (!recorded()) throw std::logic_error("Could not execute a gpu program; its gpu-instructions were reset, and it has not been recorded since.");
 
-			code(compile_parameter);
+		auto submission = manager().prepare_submission(_vulkan_command.get(), nullptr, _wait_stages);
+		_fence = vulkan_gpu_fence(gpu(), submission.timeline, submission.signal_value);
+		return submission;
+	}
+
+	/******************************** free functions ********************************/
 
+	namespace
+	{
+		/** Gives the gpu work that only signals the timeline values of the given work that was not given to it, after the earlier values.
+		 * The values were already taken from the managers by prepare_submission, so waiting for them would otherwise never end.
+		 * Errors are ignored, as they mean that the gpu cannot do any more work anyway.
+		 */
+		void signal_unsubmitted(std::span<const vulkan_gpu_submission> submissions, const std::vector<bool>& submitted) noexcept
+		{
+			for (std::size_t i = 0; i < submissions.size(); ++i)
 			{
-				auto result = vkEndCommandBuffer(commandBuffer);
+				if (submitted[i]) continue;
+				auto& submission = submissions[i];
 
-				switch (result)
+				// The binary semaphore is still waited on, so that it is unsignaled like the work would have done;
+				// the work's binary semaphore is not signaled, as what waits for it expects the work's results.
+				std::array<VkSemaphoreSubmitInfo, 2> waitInfos;
+				uint32_t waitCount = 0;
+				if (submission.wait_semaphore)
 				{
-				case VK_SUCCESS: break;
-				default:
-					const char* message;
-					GET_VULKAN_ERROR_STRING(result, message,
-						"Could not finish recording commands for a gpu program: ")
-						throw std::runtime_error(message);
+					waitInfos[waitCount] = VkSemaphoreSubmitInfo{
+						.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+						.semaphore = to_vulkan(submission.wait_semaphore),
+						.value = 0,
+						.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+					};
+					++waitCount;
 				}
-			}
-		}
-
-		// This is seemingly needed to get around compiler bug: https://stackoverflow.com/questions/29459040/why-copy-constructor-is-called-instead-of-move-constructor
-		{
-			_manager_destructing_key.~event_key<>();
-			new(&_manager_destructing_key)event_key(manager.destructing().subscribe([this]()
+				if (submission.wait_value > 0)
 				{
-					this->~vulkan_gpu_program();
-					new(this)vulkan_gpu_program();
+					waitInfos[waitCount] = VkSemaphoreSubmitInfo{
+						.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+						.semaphore = to_vulkan(submission.timeline),
+						.value = submission.wait_value,
+						.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+					};
+					++waitCount;
 				}
-			));
+				VkSemaphoreSubmitInfo signalInfo{
+					.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+					.semaphore = to_vulkan(submission.timeline),
+					.value = submission.signal_value,
+					.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+				};
+
+				VkSubmitInfo2 submitInfo{
+					.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+					.waitSemaphoreInfoCount = waitCount,
+					.pWaitSemaphoreInfos = waitInfos.data(),
+					.signalSemaphoreInfoCount = 1,
+					.pSignalSemaphoreInfos = &signalInfo,
+				};
+				vkQueueSubmit2(to_vulkan(submission.queue), 1, &submitInfo, VK_NULL_HANDLE);
+			}
 		}
 	}
 
-	/******************************** modifiers ********************************/
-
-	auto vulkan_gpu_program::execute() -> const fence_type&
+	auto submit_programs(std::span<const vulkan_gpu_submission> submissions) -> std::size_t
 	{
-		auto& thread = manager().thread();
-		auto queue = to_vulkan(thread.queue);
+		/** The semaphores and command buffer of a single work; their addresses are given to vulkan, so they must not move until the work is submitted. */
+		struct submission_data
+		{
+			VkCommandBufferSubmitInfo commandInfo;
+			std::vector<VkSemaphoreSubmitInfo> waitInfos;
+			std::array<VkSemaphoreSubmitInfo, 2> signalInfos;
+		};
 
-		auto oldSemaphore = to_vulkan(manager().last_vulkan_semaphore());
-		auto& sync = manager().new_synchronization();
-		auto fence = to_vulkan(sync.fence.vulkan_fence());
-		auto semaphore = to_vulkan(sync.semaphore.vulkan_semaphore());
+		std::vector<VkSubmitInfo2> submitInfos;
+		std::vector<submission_data> data;
+		std::vector<bool> submitted(submissions.size(), false);
 
-		auto vulkanCommand = to_vulkan(_vulkan_command.get());
+		// The vectors must not reallocate after their elements' addresses are given to submitInfos.
+		submitInfos.reserve(submissions.size());
+		data.reserve(submissions.size());
 
+		std::size_t submit_count = 0;
+		for (std::size_t first = 0; first < submissions.size(); ++first)
 		{
-			VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-			VkSubmitInfo submitInfo{
-				.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-				.waitSemaphoreCount = (oldSemaphore == nullptr)
-					? static_cast<uint32_t>(0)
-					: static_cast<uint32_t>(1),
-				.pWaitSemaphores = &oldSemaphore,
-				.pWaitDstStageMask = waitStages,
-				.commandBufferCount = 1,
-				.pCommandBuffers = &vulkanCommand,
-				.signalSemaphoreCount = 1,
-				.pSignalSemaphores = &semaphore,
-			};
+			if (submitted[first]) continue;
+			auto queue = submissions[first].queue;
+
+			submitInfos.clear();
+			data.clear();
+			for (std::size_t i = first; i < submissions.size(); ++i)
+			{
+				auto& submission = submissions[i];
+				if (submitted[i] || submission.queue != queue) continue;
+				submitted[i] = true;
+
+				auto& item = data.emplace_back();
+				item.commandInfo = VkCommandBufferSubmitInfo{
+					.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+					.commandBuffer = to_vulkan(submission.command),
+				};
+
+				// Only the stages using what the earlier work uses have to wait for it; the stages before them may start right away.
+				VkPipelineStageFlags2 waitStages = submission.wait_stages
+					? submission.wait_stages
+					: VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+				// Values given for binary semaphores are ignored.
+				item.waitInfos.reserve(2 + submission.dependencies.size());
+				if (submission.wait_semaphore)
+				{
+					// The semaphore is signaled when a window's image can be drawn on, which is only needed once colors are output.
+					item.waitInfos.push_back(VkSemaphoreSubmitInfo{
+						.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+						.semaphore = to_vulkan(submission.wait_semaphore),
+						.value = 0,
+						.stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+					});
+				}
+				if (submission.wait_value > 0)
+				{
+					item.waitInfos.push_back(VkSemaphoreSubmitInfo{
+						.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+						.semaphore = to_vulkan(submission.timeline),
+						.value = submission.wait_value,
+						.stageMask = waitStages,
+					});
+				}
+				for (auto& dependency : submission.dependencies)
+				{
+					item.waitInfos.push_back(VkSemaphoreSubmitInfo{
+						.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+						.semaphore = to_vulkan(dependency.timeline),
+						.value = dependency.value,
+						.stageMask = waitStages,
+					});
+				}
 
-			auto result = vkQueueSubmit(queue, 1, &submitInfo, fence);
+				uint32_t signalCount = 0;
+				item.signalInfos[signalCount] = VkSemaphoreSubmitInfo{
+					.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+					.semaphore = to_vulkan(submission.timeline),
+					.value = submission.signal_value,
+					.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+				};
+				++signalCount;
+				if (submission.signal_semaphore)
+				{
+					item.signalInfos[signalCount] = VkSemaphoreSubmitInfo{
+						.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+						.semaphore = to_vulkan(submission.signal_semaphore),
+						.value = 0,
+						.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+					};
+					++signalCount;
+				}
+
+				submitInfos.push_back(VkSubmitInfo2{
+					.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+					.waitSemaphoreInfoCount = static_cast<uint32_t>(item.waitInfos.size()),
+					.pWaitSemaphoreInfos = item.waitInfos.data(),
+					.commandBufferInfoCount = (submission.command == nullptr)
+						? static_cast<uint32_t>(0)
+						: static_cast<uint32_t>(1),
+					.pCommandBufferInfos = &item.commandInfo,
+					.signalSemaphoreInfoCount = signalCount,
+					.pSignalSemaphoreInfos = item.signalInfos.data(),
+				});
+			}
+
+			COMPWOLF_PROFILE_ZONE("vkQueueSubmit2");
+			auto result = vkQueueSubmit2(to_vulkan(queue), static_cast<uint32_t>(submitInfos.size()), submitInfos.data(), VK_NULL_HANDLE);
+			++submit_count;
 
 			switch (result)
 			{
 			case VK_SUCCESS: break;
 			default:
+				// A failed vkQueueSubmit2 gives none of its work to the gpu.
+				for (std::size_t i = first; i < submissions.size(); ++i)
+				{
+					if (submissions[i].queue == queue) submitted[i] = false;
+				}
+				signal_unsubmitted(submissions, submitted);
+
 				const char* message;
 				GET_VULKAN_ERROR_STRING(result, message,
 					"Could not execute a gpu program; its commands could not be submitted to the gpu: ")
@@ -140,6 +298,6 @@ namespace compwolf::vulkan
 			}
 		}
 
-		return sync.fence;
+		return submit_count;
 	}
 }
@@ -1,22 +1,33 @@
 #include <private/vulkan_programs/vulkan_gpu_program_manager.hpp>
 
 #include "compwolf_vulkan.hpp"
+#include <limits>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace compwolf::vulkan
 {
-	static auto find_thread(const vulkan_gpu_thread_family& family) noexcept -> std::size_t
+	/** Returns the index of the thread in the given family with the least work that is not done yet.
+	 * Threads with the same amount of work are told apart by how many managers are on them, so that managers created at the same time are spread out.
+	 */
+	static auto find_thread(const vulkan_gpu_connection& gpu, const vulkan_gpu_thread_family& family) noexcept -> std::size_t
 	{
 		std::size_t best_thread_index = 0;
-		if (family.threads[best_thread_index].program_manager_count == 0) return best_thread_index;
+		auto best_work = gpu.outstanding_work(family.threads[best_thread_index]);
 
-		for (size_t thread_index = 1; thread_index < family.threads.size(); ++thread_index)
+		for (std::size_t thread_index = 1; thread_index < family.threads.size(); ++thread_index)
 		{
-			auto program_manager_count = family.threads[best_thread_index].program_manager_count;
-			if (program_manager_count < family.threads[best_thread_index].program_manager_count)
+			auto& thread = family.threads[thread_index];
+			auto work = gpu.outstanding_work(thread);
+
+			bool is_better = work < best_work;
+			if (work == best_work) is_better = thread.program_manager_count < family.threads[best_thread_index].program_manager_count;
+
+			if (is_better)
 			{
 				best_thread_index = thread_index;
-				if (program_manager_count == 0) return thread_index;
+				best_work = work;
 			}
 		}
 		return best_thread_index;
@@ -28,6 +39,7 @@ namespace compwolf::vulkan
 		const vulkan_gpu_thread_family* best_family = nullptr;
 		std::size_t best_family_index = 0;
 		best_score = std::numeric_limits<float>::lowest();
+		best_custom_score = std::numeric_limits<float>::lowest();
 
 		for (std::size_t family_index = 0; family_index < gpu.thread_families().size(); ++family_index)
 		{
@@ -66,13 +78,15 @@ namespace compwolf::vulkan
 	static auto find_family(gpu_program_manager_settings& settings, const std::vector<vulkan_gpu_connection>& gpus) noexcept
 		-> std::optional<std::pair<size_t, std::size_t>>
 	{
-		std::size_t best_gpu_index = 0;
+		std::optional<std::size_t> best_gpu_index;
 		std::size_t best_family_index = 0;
 		float best_score = std::numeric_limits<float>::lowest();
 		float best_custom_score = std::numeric_limits<float>::lowest();
 
-		for (auto& gpu : gpus)
+		for (std::size_t gpu_index = 0; gpu_index < gpus.size(); ++gpu_index)
 		{
+			auto& gpu = gpus[gpu_index];
+
 			auto additional_work_types_for_gpu = gpu.work_types() ^ settings.type;
 			if ((additional_work_types_for_gpu & settings.type).any()) continue;
 
@@ -82,10 +96,9 @@ namespace compwolf::vulkan
 
 			float score, custom_score;
 			auto index_container = find_family(settings, gpu, score, custom_score);
-			custom_score += custom_gpu_score;
-
 			if (!index_container.has_value()) continue;
 			auto family_index = index_container.value();
+			custom_score += custom_gpu_score;
 
 			constexpr float very_small_score_difference = .1f / static_cast<float>(gpu_work_type::size);
 			bool is_better = score > best_score + very_small_score_difference;
@@ -93,13 +106,15 @@ namespace compwolf::vulkan
 
 			if (is_better)
 			{
+				best_gpu_index = gpu_index;
 				best_family_index = family_index;
 				best_score = score;
 				best_custom_score = custom_score;
 			}
 		}
 
-		return std::make_pair(best_gpu_index, best_family_index);
+		if (!best_gpu_index) return std::nullopt;
+		return std::make_pair(best_gpu_index.value(), best_family_index);
 	}
 
 	/******************************** constructors ********************************/
@@ -109,7 +124,8 @@ namespace compwolf::vulkan
 		: _gpu(&gpu_in)
 		, _family_index(family_index_in)
 		, _thread_index(thread_index_in)
-		, _syncs_count(0)
+		, _timeline(gpu_in.object_pool().new_timeline())
+		, _submitted_value(_timeline->submitted_value.load(std::memory_order_acquire))
 	{
 		auto logicDevice = to_vulkan(gpu().vulkan_device());
 
@@ -135,18 +151,29 @@ namespace compwolf::vulkan
 
 			auto& family = gpu_in.thread_families()[_family_index];
 			auto& thread = family.threads[_thread_index];
+			auto deletion_queue = &gpu_in.deletion_queue();
+			auto object_pool = &gpu_in.object_pool();
 			_pool = unique_deleter_ptr<vulkan_handle::command_pool_t>(from_vulkan(commandPool),
-				[logicDevice, &family, &thread](vulkan_handle::command_pool c)
+				[logicDevice, deletion_queue, object_pool, &family, &thread](vulkan_handle::command_pool c)
 				{
-					vkDeviceWaitIdle(logicDevice);
-					vkDestroyCommandPool(logicDevice, to_vulkan(c), nullptr);
-
+					// The thread is free for new managers right away, even if the gpu is still running the pool's commands.
 					--family.program_manager_count;
 					--thread.program_manager_count;
+
+					// The programs' command buffers were given to the queue before this, so they are given back to the object pool before it forgets them.
+					deletion_queue->defer([logicDevice, object_pool, c]()
+						{
+							object_pool->forget_command_pool(c);
+							vkDestroyCommandPool(logicDevice, to_vulkan(c), nullptr);
+						}
+					);
 				}
 			);
 			++family.program_manager_count;
 			++thread.program_manager_count;
+
+			std::erase_if(thread.timelines, [](const std::weak_ptr<vulkan_tracked_timeline>& t) { return t.expired(); });
+			thread.timelines.push_back(_timeline);
 		}
 	}
 
@@ -158,7 +185,7 @@ namespace compwolf::vulkan
 		if (!i) throw std::runtime_error("The machine's GPUs could not perform a job because of the type of work it requires.");
 
 		auto family_index = i.value();
-		auto thread_index = find_thread(gpu.thread_families()[family_index]);
+		auto thread_index = find_thread(gpu, gpu.thread_families()[family_index]);
 		return vulkan_gpu_program_manager(gpu, family_index, thread_index);
 	}
 	auto vulkan_gpu_program_manager::new_manager_for(vulkan_graphics_environment& environment
@@ -170,18 +197,53 @@ namespace compwolf::vulkan
 
 		auto& [gpu_index, family_index] = i.value();
 		auto& gpu = gpus[gpu_index];
-		auto thread_index = find_thread(gpu.thread_families()[family_index]);
+		auto thread_index = find_thread(gpu, gpu.thread_families()[family_index]);
 		return vulkan_gpu_program_manager(gpu, family_index, thread_index);
 	}
 
 	/******************************** modifiers ********************************/
-	auto vulkan_gpu_program_manager::new_synchronization(bool signaled) noexcept -> gpu_program_sync&
+
+	void vulkan_gpu_program_manager::reset_programs()
+	{
+		auto result = vkResetCommandPool(to_vulkan(gpu().vulkan_device()), to_vulkan(vulkan_pool()), 0);
+
+		switch (result)
+		{
+		case VK_SUCCESS: break;
+		default:
+			const char* message;
+			GET_VULKAN_ERROR_STRING(result, message,
+				"Could not reset the gpu-instructions of some gpu-programs: ")
+				throw std::runtime_error(message);
+		}
+
+		++_reset_count;
+	}
+
+	auto vulkan_gpu_program_manager::prepare_submission(vulkan_handle::command command, vulkan_handle::semaphore signal_semaphore
+		, vulkan_handle::pipeline_stages wait_stages) noexcept
+		-> vulkan_gpu_submission
 	{
-		++_syncs_count;
-		if (_syncs_count > _syncs.size())
-			_syncs.emplace_back(vulkan_gpu_semaphore(gpu()), vulkan_gpu_fence(gpu(), signaled));
-		else
-			if (!signaled) latest_synchronization()->fence.reset(); // note semaphore does not need to be reset to be re-used
-		return *latest_synchronization();
+		auto wait_value = _submitted_value;
+		++_submitted_value;
+		_timeline->submitted_value.store(_submitted_value, std::memory_order_release);
+		++_gpu->thread_families()[_family_index].threads[_thread_index].submission_count;
+
+		auto wait_semaphore = _next_wait_semaphore;
+		_next_wait_semaphore = nullptr;
+		auto dependencies = std::move(_next_dependencies);
+		_next_dependencies.clear();
+
+		return vulkan_gpu_submission{
+			.queue = thread().queue,
+			.command = command,
+			.wait_semaphore = wait_semaphore,
+			.timeline = vulkan_timeline(),
+			.wait_value = wait_value,
+			.signal_value = _submitted_value,
+			.signal_semaphore = signal_semaphore,
+			.dependencies = std::move(dependencies),
+			.wait_stages = wait_stages,
+		};
 	}
 }
@@ -8,13 +8,30 @@ namespace compwolf::vulkan
 {
 	/******************************** constructors ********************************/
 
-	vulkan_gpu_semaphore::vulkan_gpu_semaphore(vulkan_gpu_connection& target_gpu)
+	vulkan_gpu_semaphore::vulkan_gpu_semaphore(vulkan_gpu_connection& target_gpu, bool timeline)
 	{
 		_gpu = &target_gpu;
+		_timeline = timeline;
+
+		// Binary semaphores are interchangeable once the gpu is done with them, unlike timeline semaphores whose value must start at 0.
+		if (!timeline)
+		{
+			_vulkan_semaphore = gpu().object_pool().new_semaphore();
+			return;
+		}
+
 		auto logicDevice = to_vulkan(gpu().vulkan_device());
+		auto deletion_queue = &gpu().deletion_queue();
+
+		VkSemaphoreTypeCreateInfo typeInfo{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+			.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+			.initialValue = 0,
+		};
 
 		VkSemaphoreCreateInfo createInfo{
 			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+			.pNext = &typeInfo,
 		};
 
 		VkSemaphore semaphore;
@@ -31,9 +48,13 @@ namespace compwolf::vulkan
 		}
 
 		_vulkan_semaphore = unique_deleter_ptr<vulkan_handle::semaphore_t>(from_vulkan(semaphore),
-			[logicDevice](vulkan_handle::semaphore s)
+			[logicDevice, deletion_queue](vulkan_handle::semaphore s)
 			{
-				vkDestroySemaphore(logicDevice, to_vulkan(s), nullptr);
+				deletion_queue->defer([logicDevice, s]()
+					{
+						vkDestroySemaphore(logicDevice, to_vulkan(s), nullptr);
+					}
+				);
 			}
 		);
 	}
@@ -0,0 +1,49 @@
+#include "private/vulkan_windows/offscreen_target.hpp"
+#include "compwolf_vulkan.hpp"
+
+#include <stdexcept>
+#include <cstring>
+
+namespace compwolf::vulkan
+{
+	static auto to_window_settings(const offscreen_target_settings& settings) noexcept -> window_settings
+	{
+		return window_settings{
+			.name = "Offscreen target",
+			.pixel_size = settings.pixel_size,
+			.frames_in_flight = settings.frames_in_flight,
+			.present = present_policy::automatic,
+			.target_frame_rate = settings.target_frame_rate,
+			.frame_stats_size = settings.frame_stats_size,
+			.frame_stats_interval = settings.frame_stats_interval,
+		};
+	}
+
+	/******************************** accessors ********************************/
+
+	auto offscreen_target::read_image() -> std::vector<std::byte>
+	{
+		if (!swapchain().readback()) throw std::logic_error("Could not read an offscreen target's image; the target was not set up to copy its images to the cpu.");
+
+		swapchain().current_frame_in_flight().draw_manager().wait();
+
+		auto& buffer = swapchain().current_frame().readback_buffer();
+		std::vector<std::byte> pixels(buffer.stride * buffer.size);
+
+		auto data = buffer.get_data(gpu());
+		std::memcpy(pixels.data(), data, pixels.size());
+		internal::vulkan_gpu_buffer_internal::free_data(gpu(), buffer.vulkan_memory.get());
+
+		return pixels;
+	}
+
+	/******************************** constructors ********************************/
+
+	offscreen_target::offscreen_target(vulkan_gpu_connection& gpu, offscreen_target_settings settings)
+		: vulkan_window(nullptr, &gpu, to_window_settings(settings), settings.readback)
+	{}
+
+	offscreen_target::offscreen_target(vulkan_graphics_environment& environment, offscreen_target_settings settings)
+		: vulkan_window(&environment, nullptr, to_window_settings(settings), settings.readback)
+	{}
+}
@@ -0,0 +1,106 @@
+#include "private/vulkan_windows/present_batch.hpp"
+#include "compwolf_vulkan.hpp"
+
+#include "private/vulkan_windows/vulkan_window.hpp"
+#include <profilers>
+#include <stdexcept>
+#include <utility>
+
+namespace compwolf::vulkan
+{
+	/******************************** modifiers ********************************/
+
+	void present_batch::add(vulkan_window& window)
+	{
+		window.update_image(*this);
+		_windows.push_back(&window);
+	}
+
+	void present_batch::submit()
+	{
+		auto start_time = std::chrono::steady_clock::now();
+
+		// The windows are taken out of the batch first, so that they are not displayed again by the next submit if this throws.
+		auto windows = std::move(_windows);
+		_windows.clear();
+
+		auto submit_calls = _work.flush();
+
+		// Offscreen targets are done once their work is submitted; the others are done once their queue's present is.
+		std::vector<std::chrono::nanoseconds> present_waits(windows.size()
+			, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time)
+		);
+
+		std::size_t present_calls = 0;
+		{
+			std::vector<bool> presented(windows.size(), false);
+			std::vector<VkSemaphore> semaphores;
+			std::vector<VkSwapchainKHR> swapchains;
+			std::vector<uint32_t> imageIndices;
+			semaphores.reserve(windows.size());
+			swapchains.reserve(windows.size());
+			imageIndices.reserve(windows.size());
+
+			for (std::size_t first = 0; first < windows.size(); ++first)
+			{
+				// Offscreen targets are not displayed; their work after drawing was added to the batch as any other work.
+				if (presented[first] || windows[first]->swapchain().offscreen()) continue;
+				auto queue = windows[first]->swapchain().current_frame_in_flight().draw_manager().thread().queue;
+
+				semaphores.clear();
+				swapchains.clear();
+				imageIndices.clear();
+				for (std::size_t i = first; i < windows.size(); ++i)
+				{
+					auto& swapchain = windows[i]->swapchain();
+					auto& draw_manager = swapchain.current_frame_in_flight().draw_manager();
+					if (presented[i] || swapchain.offscreen() || draw_manager.thread().queue != queue) continue;
+					presented[i] = true;
+
+					semaphores.push_back(to_vulkan(swapchain.current_frame().present_semaphore().vulkan_semaphore()));
+					swapchains.push_back(to_vulkan(swapchain.vulkan_swapchain()));
+					imageIndices.push_back(static_cast<uint32_t>(swapchain.current_frame_index()));
+				}
+
+				VkPresentInfoKHR presentInfo{
+					.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+					.waitSemaphoreCount = static_cast<uint32_t>(semaphores.size()),
+					.pWaitSemaphores = semaphores.data(),
+					.swapchainCount = static_cast<uint32_t>(swapchains.size()),
+					.pSwapchains = swapchains.data(),
+					.pImageIndices = imageIndices.data(),
+				};
+
+				auto present_start = std::chrono::steady_clock::now();
+				{
+					COMPWOLF_PROFILE_ZONE("vkQueuePresentKHR");
+					vkQueuePresentKHR(to_vulkan(queue), &presentInfo);
+				}
+				auto present_wait = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - present_start);
+				for (std::size_t i = first; i < windows.size(); ++i)
+				{
+					if (!windows[i]->swapchain().offscreen() && windows[i]->swapchain().current_frame_in_flight().draw_manager().thread().queue == queue)
+						present_waits[i] = present_wait;
+				}
+				++present_calls;
+			}
+		}
+
+		for (std::size_t i = 0; i < windows.size(); ++i) windows[i]->swapchain().mark_presented(present_waits[i]);
+
+		_stats = present_batch_stats{
+			.windows = windows.size(),
+			.programs = _work.stats().programs,
+			.submit_calls = submit_calls,
+			.present_calls = present_calls,
+			.submit_time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time),
+		};
+
+		// The windows generally have the same target frame rate, so after the first wait the others' are short.
+		for (auto window : windows) window->frame_pacer().wait();
+
+		// The vector is kept, so that the batch does not allocate again when reused.
+		windows.clear();
+		_windows = std::move(windows);
+	}
+}
@@ -2,79 +2,250 @@
 #include "compwolf_vulkan.hpp"
 
 #include "private/vulkan_windows/vulkan_window.hpp"
+#include "private/vulkan_windows/present_batch.hpp"
 #include <stdexcept>
 
 namespace compwolf::vulkan
 {
 	vulkan_camera::vulkan_camera(vulkan_window& window_in, window_camera_settings settings)
 		: window_camera(window_in, settings)
-		, _draw_programs(window_in.swapchain().frames().size())
+		, _draw_programs(window_in.swapchain().frames_in_flight().size() * window_in.swapchain().frames().size())
 	{
+		if (gpu_timing() != camera_gpu_timing::none)
+		{
+			_profiler = vulkan_gpu_profiler(window_in.gpu(), window_in.swapchain().frames_in_flight().size());
+			_frame_timed_key = _profiler.frame_timed().subscribe([this](const gpu_frame_timings& timings)
+				{
+					window().add_gpu_frame_time(timings.frame_in_flight_index, timings.total);
+				}
+			);
+		}
+
+		{
+			auto frame_count = window_in.swapchain().frames_in_flight().size();
+			_draw_field_sets = internal::vulkan_draw_fields_sets(window_in.gpu(), frame_count);
+
+			_draw_fields.reserve(frame_count);
+			for (std::size_t i = 0; i < frame_count; ++i)
+			{
+				_draw_fields.emplace_back(window_in.gpu(), _draw_field_sets.vulkan_descriptor_set[i]);
+			}
+		}
+
+		// The culling draws each drawable with its slot of push fields as its first instance, which the gpu must support for indirect draws.
+		if (gpu_culling() && window_in.gpu().supports_draw_indirect_first_instance())
+		{
+			auto frame_count = window_in.swapchain().frames_in_flight().size();
+			_culling_pipeline = internal::vulkan_draw_culling_pipeline(window_in.gpu(), frame_count);
+
+			_culling.reserve(frame_count);
+			for (std::size_t i = 0; i < frame_count; ++i)
+			{
+				_culling.emplace_back(window_in.gpu(), _culling_pipeline.vulkan_descriptor_set[i]);
+			}
+		}
+
 		// This is seemingly needed to get around compiler bug: https://stackoverflow.com/questions/29459040/why-copy-constructor-is-called-instead-of-move-constructor
 		_drawing_key.~event_key();
 		new(&_drawing_key)event_key(window().drawing().subscribe(
 			[this](const window_draw_parameters& draw_args)
 			{
-				if (_draw_programs.empty()) _draw_programs.resize(window().swapchain().frames().size());
-				auto& current_program = _draw_programs[draw_args.target_frame_index];
+				auto& current = _draw_programs[draw_args.target_frame_in_flight_index * window().swapchain().frames().size() + draw_args.target_frame_index];
+				auto& current_program = current.program;
+
+				// The instructions contain the drawables' push fields and which drawables are visible, so they are reused until any of that may have changed.
+				// A timed camera records every frame, as its profiler reads the times of the frame's earlier run while recording.
+				auto push_data_changes = gpu().push_data_changes();
+				bool up_to_date = current_program && current_program.recorded()
+					&& !current.record_again
+					&& current.changes == _changes
+					&& current.push_data_changes == push_data_changes
+					&& !_profiler;
 
-				if (!current_program)
+				// Recording may itself count as a change, so the program's changes are read after it.
+				if (!up_to_date)
 				{
-					// This is seemingly needed to get around compiler bug: https://stackoverflow.com/questions/29459040/why-copy-constructor-is-called-instead-of-move-constructor
-					current_program.~vulkan_gpu_program();
-					new(&current_program)vulkan_gpu_program(
-						draw_args.target_frame->draw_manager(),
-						[this, draw_args](const vulkan_code_parameters& code_args)
-						{
-							auto commandBuffer = to_vulkan(code_args.command);
-
-							VkClearValue clearColor = {
-								{{
-									background_color().x(),
-									background_color().y(),
-									background_color().z()
-								}}
-							};
-
-							uint32_t width, height;
-							{
-								auto size = draw_args.target_window->pixel_size();
-								width = static_cast<uint32_t>(size.x());
-								height = static_cast<uint32_t>(size.y());
-							}
-
-							VkRenderPassBeginInfo renderpassInfo{
-								.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-								.renderPass = to_vulkan(draw_args.target_window->surface().vulkan_render_pass()),
-								.framebuffer = to_vulkan(draw_args.target_frame->frame_buffer()),
-								.renderArea = {
-									.offset = {0, 0},
-									.extent = {
-										.width = width,
-										.height = height,
-									},
-								},
-								.clearValueCount = 1,
-								.pClearValues = &clearColor,
-							};
-
-							vkCmdBeginRenderPass(commandBuffer, &renderpassInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-							vulkan_draw_code_parameters draw_code_args{
-								code_args,
-								&window(),
-								draw_args.target_frame,
-								draw_args.target_frame_index
-							};
-							_drawing_code.invoke(draw_code_args);
-
-							vkCmdEndRenderPass(commandBuffer);
-						}
-					);
+					record_draw_program(current, draw_args);
+					current.changes = _changes;
+					current.push_data_changes = push_data_changes;
 				}
 
-				current_program.execute();
+				if (draw_args.batch) draw_args.batch->add(current_program.prepare_execution());
+				else current_program.execute();
 			}
 		));
 	}
+
+	/******************************** private ********************************/
+
+	void vulkan_camera::record_draw_program(draw_program& current, const window_draw_parameters& draw_args)
+	{
+		auto& current_program = current.program;
+
+		bool record_again = false;
+		auto draw_code = [this, draw_args, &record_again](const vulkan_code_parameters& code_args)
+		{
+			auto commandBuffer = to_vulkan(code_args.command);
+
+			// Without a render pass, the gpu uses dynamic rendering.
+			auto renderpass = to_vulkan(draw_args.target_window->surface().vulkan_render_pass());
+
+			// With dynamic rendering, the image's layout is not changed by a render pass, so it has to be changed explicitly.
+			// A window's image can only be drawn on once the semaphore waited on before outputting colors is signaled,
+			// so the layout change must wait for that stage; the image is cleared, so its contents are discarded.
+			// The change is flushed along with the culling's barrier, if there is one.
+			auto swapchainImage = draw_args.target_frame->swapchain_image();
+			if (!renderpass)
+			{
+				code_args.barriers->track(swapchainImage, vulkan_resource_state::after(vulkan_resource_access::color_attachment_write));
+				code_args.barriers->use(swapchainImage, vulkan_resource_access::color_attachment_write, true);
+			}
+
+			// The culling's compute shader is run on the same thread as the drawing, so it must be able to do both.
+			vulkan_draw_culling* culling = nullptr;
+			if (!_culling.empty()
+				&& draw_args.target_frame_in_flight->draw_manager().thread_family().work_types[gpu_work_type::compute])
+			{
+				culling = &_culling[draw_args.target_frame_in_flight_index];
+				auto capacity = culling->capacity();
+
+				std::size_t culling_scope{};
+				if (code_args.profiler) culling_scope = code_args.profiler->begin_scope("culling");
+				culling->begin(code_args.command, *code_args.barriers, _culling_pipeline, bounds(), _draw_code_count);
+				if (code_args.profiler) code_args.profiler->end_scope(culling_scope);
+
+				// The frame in flight's programs for the window's other frames use the same buffers, so replacing them by growing changes those programs.
+				if (capacity != 0 && culling->capacity() != capacity) mark_changed();
+			}
+
+			auto& draw_fields = _draw_fields[draw_args.target_frame_in_flight_index];
+			{
+				auto capacity = draw_fields.capacity();
+				draw_fields.begin(_draw_code_count);
+				if (capacity != 0 && draw_fields.capacity() != capacity) mark_changed();
+			}
+
+			VkClearValue clearColor = {
+				{{
+					background_color().x(),
+					background_color().y(),
+					background_color().z()
+				}}
+			};
+
+			uint32_t width, height;
+			{
+				auto size = draw_args.target_window->pixel_size();
+				width = static_cast<uint32_t>(size.x());
+				height = static_cast<uint32_t>(size.y());
+			}
+
+			VkRenderPassBeginInfo renderpassInfo{
+				.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+				.renderPass = renderpass,
+				.framebuffer = to_vulkan(draw_args.target_frame->frame_buffer()),
+				.renderArea = {
+					.offset = {0, 0},
+					.extent = {
+						.width = width,
+						.height = height,
+					},
+				},
+				.clearValueCount = 1,
+				.pClearValues = &clearColor,
+			};
+
+			vulkan_draw_code_parameters draw_code_args{
+				code_args,
+				&window(),
+				draw_args.target_frame,
+				draw_args.target_frame_index,
+				draw_args.target_frame_in_flight_index,
+				&draw_fields,
+				culling,
+				&record_again,
+			};
+
+			// Without the gpu deciding what to draw, the cpu culls the drawables before any of them are recorded.
+			if (!culling)
+			{
+				_culler.clear();
+				_draw_code_pass = draw_code_pass::collect_bounds;
+				_drawing_code.invoke(draw_code_args);
+
+				_culler.cull(bounds());
+				_draw_code_pass = draw_code_pass::draw_visible;
+			}
+
+			std::size_t render_scope{};
+			if (code_args.profiler) render_scope = code_args.profiler->begin_scope("render pass");
+
+			if (renderpass)
+			{
+				vkCmdBeginRenderPass(commandBuffer, &renderpassInfo, VK_SUBPASS_CONTENTS_INLINE);
+			}
+			else
+			{
+				code_args.barriers->flush();
+
+				VkRenderingAttachmentInfo colorAttachment{
+					.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+					.imageView = to_vulkan(draw_args.target_frame->image()),
+					.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+					.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+					.storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+					.clearValue = clearColor,
+				};
+				VkRenderingInfo renderingInfo{
+					.sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+					.renderArea = renderpassInfo.renderArea,
+					.layerCount = 1,
+					.colorAttachmentCount = 1,
+					.pColorAttachments = &colorAttachment,
+				};
+				vkCmdBeginRendering(commandBuffer, &renderingInfo);
+			}
+
+			_drawing_code.invoke(draw_code_args);
+			_draw_code_pass = draw_code_pass::draw;
+
+			if (renderpass)
+			{
+				vkCmdEndRenderPass(commandBuffer);
+			}
+			else
+			{
+				vkCmdEndRendering(commandBuffer);
+
+				// An offscreen target's image is copied from instead of displayed.
+				code_args.barriers->use(swapchainImage, draw_args.target_window->surface().offscreen()
+					? vulkan_resource_access::copy_read
+					: vulkan_resource_access::present
+				);
+				code_args.barriers->flush();
+			}
+
+			if (code_args.profiler) code_args.profiler->end_scope(render_scope);
+
+			if (culling)
+			{
+				culling->end();
+				if (culling->outgrown()) record_again = true;
+			}
+			if (draw_fields.outgrown()) record_again = true;
+		};
+
+		auto profiler = _profiler ? &_profiler : nullptr;
+		if (!current_program)
+		{
+			// This is seemingly needed to get around compiler bug: https://stackoverflow.com/questions/29459040/why-copy-constructor-is-called-instead-of-move-constructor
+			current_program.~vulkan_gpu_program();
+			new(&current_program)vulkan_gpu_program(draw_args.target_frame_in_flight->draw_manager(), draw_code
+				, profiler, draw_args.target_frame_in_flight_index);
+		}
+		else current_program.record(draw_code, profiler, draw_args.target_frame_in_flight_index);
+
+		current.record_again = record_again;
+		++_record_count;
+	}
 }
@@ -0,0 +1,491 @@
+#include "private/vulkan_windows/vulkan_draw_culling.hpp"
+#include "compwolf_vulkan.hpp"
+
+#include "private/vulkan_programs/vulkan_barrier_batch.hpp"
+#include <stdexcept>
+#include <chrono>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+namespace compwolf::vulkan
+{
+	namespace
+	{
+		constexpr const char draw_culling_shader_path[] = "resources/CompWolf.Graphics.draw_culling.spv";
+
+		/** The amount of invocations in each of the compute shader's work groups. */
+		constexpr std::size_t draw_culling_group_size = 64;
+		/** The smallest amount of drawables that the buffers are created to fit. */
+		constexpr std::size_t draw_culling_min_capacity = 64;
+
+		/** The header of the compute shader's input buffer. */
+		struct draw_culling_input_header
+		{
+			uint32_t draw_count;
+			uint32_t padding[3];
+		};
+		/** An element of the compute shader's input buffer, following [[draw_culling_input_header]]. */
+		struct draw_culling_input
+		{
+			float2 min;
+			float2 max;
+			uint32_t vertex_index_count;
+			/** The index in the counts-buffer of the drawable's group. */
+			uint32_t group;
+			/** The index in the commands-buffer of the first command of the drawable's group. */
+			uint32_t first_command;
+			/** The drawable's slot in [[vulkan_draw_fields]], which its command draws as its first instance. */
+			uint32_t instance;
+		};
+		/** The compute shader's push constants. */
+		struct draw_culling_push
+		{
+			draw_bounds camera_bounds;
+			/** Whether to pack the commands of each group's visible drawables together, instead of giving each drawable its own command. */
+			uint32_t compact;
+		};
+		static_assert(sizeof(draw_culling_input_header) == 16);
+		static_assert(sizeof(draw_culling_input) == 32);
+		static_assert(offsetof(draw_culling_push, compact) == 16);
+	}
+
+	/******************************** constructors ********************************/
+
+	namespace internal
+	{
+		vulkan_draw_culling_pipeline::vulkan_draw_culling_pipeline(vulkan_gpu_connection& gpu, std::size_t frame_count)
+			: shader(gpu, shader_code_from_file(draw_culling_shader_path))
+		{
+			auto logicDevice = to_vulkan(gpu.vulkan_device());
+			auto deletion_queue = &gpu.deletion_queue();
+
+			VkDescriptorSetLayout descriptorSetLayout;
+			{
+				std::array<VkDescriptorSetLayoutBinding, 3> bindings;
+				for (uint32_t i = 0; i < bindings.size(); ++i)
+				{
+					bindings[i] = VkDescriptorSetLayoutBinding{
+						.binding = i,
+						.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+						.descriptorCount = 1,
+						.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+					};
+				}
+
+				VkDescriptorSetLayoutCreateInfo createInfo{
+					.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+					.bindingCount = static_cast<uint32_t>(bindings.size()),
+					.pBindings = bindings.data(),
+				};
+
+				auto result = vkCreateDescriptorSetLayout(logicDevice, &createInfo, nullptr, &descriptorSetLayout);
+
+				switch (result)
+				{
+				case VK_SUCCESS: break;
+				default:
+					const char* message;
+					GET_VULKAN_ERROR_STRING(result, message,
+						"Could not create a camera's culling descriptor set layout on the GPU: ")
+						throw std::runtime_error(message);
+				}
+
+				vulkan_descriptor_set_layout = unique_deleter_ptr<vulkan_handle::descriptor_set_layout_t>(from_vulkan(descriptorSetLayout),
+					[logicDevice](vulkan_handle::descriptor_set_layout l)
+					{
+						vkDestroyDescriptorSetLayout(logicDevice, to_vulkan(l), nullptr);
+					}
+				);
+			}
+
+			VkPipelineLayout pipelineLayout;
+			{
+				VkPushConstantRange pushRange{
+					.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+					.offset = 0,
+					.size = static_cast<uint32_t>(offsetof(draw_culling_push, compact) + sizeof(uint32_t)),
+				};
+
+				VkPipelineLayoutCreateInfo createInfo{
+					.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+					.setLayoutCount = 1,
+					.pSetLayouts = &descriptorSetLayout,
+					.pushConstantRangeCount = 1,
+					.pPushConstantRanges = &pushRange,
+				};
+
+				auto result = vkCreatePipelineLayout(logicDevice, &createInfo, nullptr, &pipelineLayout);
+
+				switch (result)
+				{
+				case VK_SUCCESS: break;
+				default:
+					const char* message;
+					GET_VULKAN_ERROR_STRING(result, message,
+						"Could not create a camera's culling pipeline layout on the GPU: ")
+						throw std::runtime_error(message);
+				}
+
+				vulkan_pipeline_layout = unique_deleter_ptr<vulkan_handle::pipeline_layout_t>(from_vulkan(pipelineLayout),
+					[logicDevice](vulkan_handle::pipeline_layout l)
+					{
+						vkDestroyPipelineLayout(logicDevice, to_vulkan(l), nullptr);
+					}
+				);
+			}
+
+			{
+				VkComputePipelineCreateInfo createInfo{
+					.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+					.stage = {
+						.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+						.stage = VK_SHADER_STAGE_COMPUTE_BIT,
+						.module = to_vulkan(shader.vulkan_shader.get()),
+						.pName = "main",
+					},
+					.layout = pipelineLayout,
+					.basePipelineHandle = nullptr,
+					.basePipelineIndex = -1,
+				};
+
+				VkPipeline pipeline;
+				auto& pipelineCache = gpu.pipeline_cache();
+				auto start_time = std::chrono::steady_clock::now();
+				auto result = vkCreateComputePipelines(logicDevice, to_vulkan(pipelineCache.vulkan_cache()), 1, &createInfo, nullptr, &pipeline);
+				pipelineCache.add_creation_time(std::chrono::steady_clock::now() - start_time);
+
+				switch (result)
+				{
+				case VK_SUCCESS: break;
+				default:
+					const char* message;
+					GET_VULKAN_ERROR_STRING(result, message,
+						"Could not create a camera's culling pipeline on the GPU: ")
+						throw std::runtime_error(message);
+				}
+
+				vulkan_pipeline = unique_deleter_ptr<vulkan_handle::pipeline_t>(from_vulkan(pipeline),
+					[logicDevice, deletion_queue](vulkan_handle::pipeline p)
+					{
+						deletion_queue->defer([logicDevice, p]()
+							{
+								vkDestroyPipeline(logicDevice, to_vulkan(p), nullptr);
+							}
+						);
+					}
+				);
+			}
+
+			auto descriptorSize = static_cast<uint32_t>(frame_count);
+			VkDescriptorPool descriptorPool;
+			{
+				VkDescriptorPoolSize poolSize{
+					.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+					.descriptorCount = 3 * descriptorSize,
+				};
+				VkDescriptorPoolCreateInfo createInfo{
+					.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+					.maxSets = descriptorSize,
+					.poolSizeCount = 1,
+					.pPoolSizes = &poolSize,
+				};
+
+				auto result = vkCreateDescriptorPool(logicDevice, &createInfo, nullptr, &descriptorPool);
+
+				switch (result)
+				{
+				case VK_SUCCESS: break;
+				default:
+					const char* message;
+					GET_VULKAN_ERROR_STRING(result, message,
+						"Could not create a camera's culling descriptor pool on the GPU: ")
+						throw std::runtime_error(message);
+				}
+
+				vulkan_descriptor_pool = unique_deleter_ptr<vulkan_handle::descriptor_pool_t>(from_vulkan(descriptorPool),
+					[logicDevice, deletion_queue](vulkan_handle::descriptor_pool p)
+					{
+						deletion_queue->defer([logicDevice, p]()
+							{
+								vkDestroyDescriptorPool(logicDevice, to_vulkan(p), nullptr);
+							}
+						);
+					}
+				);
+			}
+			{
+				std::vector<VkDescriptorSetLayout> descriptorLayouts(descriptorSize, descriptorSetLayout);
+
+				VkDescriptorSetAllocateInfo allocateInfo{
+					.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+					.descriptorPool = descriptorPool,
+					.descriptorSetCount = descriptorSize,
+					.pSetLayouts = descriptorLayouts.data(),
+				};
+
+				std::vector<VkDescriptorSet> descriptorSets(descriptorSize);
+				auto result = vkAllocateDescriptorSets(logicDevice, &allocateInfo, descriptorSets.data());
+
+				switch (result)
+				{
+				case VK_SUCCESS: break;
+				default:
+					const char* message;
+					GET_VULKAN_ERROR_STRING(result, message,
+						"Could not create a camera's culling descriptor set on the GPU: ")
+						throw std::runtime_error(message);
+				}
+
+				vulkan_descriptor_set.resize(descriptorSize);
+				for (uint32_t i = 0; i < descriptorSize; i++)
+				{
+					vulkan_descriptor_set[i] = from_vulkan(descriptorSets[i]);
+				}
+			}
+		}
+	}
+
+	/******************************** accessors ********************************/
+
+	auto vulkan_draw_culling::stats() const noexcept -> draw_cull_stats
+	{
+		draw_cull_stats stats{
+			.total = std::min(_draw_count, _capacity),
+		};
+		if (_groups_drawables)
+		{
+			auto* counts = static_cast<const uint32_t*>(_count_data);
+			for (std::size_t i = 0; i < _group_count; ++i) stats.visible += counts[i];
+		}
+		else
+		{
+			auto* commands = static_cast<const VkDrawIndexedIndirectCommand*>(_command_data);
+			for (std::size_t i = 0; i < stats.total; ++i) stats.visible += commands[i].instanceCount;
+		}
+		stats.culled = stats.total - stats.visible;
+		return stats;
+	}
+
+	/******************************** vulkan-specific ********************************/
+
+	void vulkan_draw_culling::begin(vulkan_handle::command command
+		, vulkan_barrier_batch& barriers
+		, const internal::vulkan_draw_culling_pipeline& pipeline
+		, draw_bounds camera_bounds
+		, std::size_t draw_count
+	)
+	{
+		auto commandBuffer = to_vulkan(command);
+		auto logicDevice = to_vulkan(_gpu->vulkan_device());
+		auto descriptorSet = to_vulkan(_descriptor_set);
+
+		_draw_count = 0;
+		_group_count = 0;
+		_group_joinable = false;
+		_indirect_draw_count = 0;
+		_groups_drawables = _gpu->supports_draw_indirect_count() && _gpu->max_draw_indirect_count() > 1;
+
+		auto needed_capacity = std::max(draw_count, _needed_capacity);
+		if (_capacity < needed_capacity)
+		{
+			// The frame's previous gpu-instructions have finished by the time its new ones are recorded, so the old buffers are not in use.
+			auto new_capacity = std::max(_capacity, draw_culling_min_capacity);
+			while (new_capacity < needed_capacity) new_capacity *= 2;
+
+			_input_data = nullptr;
+			_command_data = nullptr;
+			_count_data = nullptr;
+			_inputs = internal::vulkan_gpu_buffer_internal(*_gpu
+				, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+				, sizeof(draw_culling_input), new_capacity + 1
+			);
+			_commands = internal::vulkan_gpu_buffer_internal(*_gpu
+				, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+				, sizeof(VkDrawIndexedIndirectCommand), new_capacity
+			);
+			_counts = internal::vulkan_gpu_buffer_internal(*_gpu
+				, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+				, sizeof(uint32_t), new_capacity
+			);
+			_input_data = _inputs.get_data(*_gpu);
+			_command_data = _commands.get_data(*_gpu);
+			_count_data = _counts.get_data(*_gpu);
+			_capacity = new_capacity;
+
+			std::array<VkDescriptorBufferInfo, 3> bufferInfos{
+				VkDescriptorBufferInfo{ .buffer = to_vulkan(_inputs.vulkan_buffer.get()), .offset = 0, .range = VK_WHOLE_SIZE, },
+				VkDescriptorBufferInfo{ .buffer = to_vulkan(_commands.vulkan_buffer.get()), .offset = 0, .range = VK_WHOLE_SIZE, },
+				VkDescriptorBufferInfo{ .buffer = to_vulkan(_counts.vulkan_buffer.get()), .offset = 0, .range = VK_WHOLE_SIZE, },
+			};
+			std::array<VkWriteDescriptorSet, 3> writers;
+			for (uint32_t i = 0; i < writers.size(); ++i)
+			{
+				writers[i] = VkWriteDescriptorSet{
+					.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+					.dstSet = descriptorSet,
+					.dstBinding = i,
+					.dstArrayElement = 0,
+					.descriptorCount = 1,
+					.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+					.pBufferInfo = &bufferInfos[i],
+				};
+			}
+			vkUpdateDescriptorSets(logicDevice, static_cast<uint32_t>(writers.size()), writers.data(), 0, nullptr);
+		}
+		_needed_capacity = 0;
+
+		// The drawables' bounds are written to the buffer while the rest of the instructions are recorded,
+		// which is fine as the cpu's writes are visible to the gpu once the instructions are submitted.
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, to_vulkan(pipeline.vulkan_pipeline.get()));
+		vkCmdBindDescriptorSets(commandBuffer
+			, VK_PIPELINE_BIND_POINT_COMPUTE
+			, to_vulkan(pipeline.vulkan_pipeline_layout.get())
+			, 0
+			, 1
+			, &descriptorSet
+			, 0
+			, nullptr
+		);
+		draw_culling_push push{
+			.camera_bounds = camera_bounds,
+			.compact = _groups_drawables ? 1u : 0u,
+		};
+		vkCmdPushConstants(commandBuffer, to_vulkan(pipeline.vulkan_pipeline_layout.get())
+			, VK_SHADER_STAGE_COMPUTE_BIT
+			, 0
+			, static_cast<uint32_t>(offsetof(draw_culling_push, compact) + sizeof(uint32_t))
+			, &push
+		);
+		auto commandsBuffer = _commands.vulkan_buffer.get();
+		auto countsBuffer = _counts.vulkan_buffer.get();
+
+		// The shader counts each group's visible drawables from 0.
+		// The counts are cleared by the gpu instead of the cpu, so that the instructions can be run again without being recorded again.
+		if (_groups_drawables)
+		{
+			barriers.use(countsBuffer, vulkan_resource_access::clear_write);
+			barriers.flush();
+			vkCmdFillBuffer(commandBuffer, to_vulkan(countsBuffer), 0, VK_WHOLE_SIZE, 0);
+		}
+
+		barriers.use(commandsBuffer, vulkan_resource_access::compute_shader_write);
+		barriers.use(countsBuffer, vulkan_resource_access::compute_shader_write);
+		barriers.flush();
+
+		vkCmdDispatch(commandBuffer
+			, static_cast<uint32_t>((_capacity + draw_culling_group_size - 1) / draw_culling_group_size)
+			, 1
+			, 1
+		);
+
+		// The draw commands and counts written by the shader are read by the indirect draws, so both wait for the shader with a single barrier;
+		// the cpu also reads them for stats().
+		barriers.use(commandsBuffer, vulkan_resource_access::indirect_read);
+		barriers.use(commandsBuffer, vulkan_resource_access::host_read);
+		barriers.use(countsBuffer, vulkan_resource_access::indirect_read);
+		barriers.use(countsBuffer, vulkan_resource_access::host_read);
+		barriers.flush();
+	}
+
+	void vulkan_draw_culling::draw_indexed(vulkan_handle::command command, shader_int vertex_index_count, draw_bounds bounds, uint32_t instance)
+	{
+		draw_indexed(command, vertex_index_count, bounds, instance, vulkan_draw_state{});
+		_group_joinable = false;
+	}
+
+	void vulkan_draw_culling::draw_indexed(vulkan_handle::command command, shader_int vertex_index_count, draw_bounds bounds, uint32_t instance, const vulkan_draw_state& state)
+	{
+		auto commandBuffer = to_vulkan(command);
+
+		_group_joinable = false;
+		auto slot = _draw_count;
+		if (slot >= _capacity)
+		{
+			_needed_capacity = ++_draw_count;
+			vkCmdDrawIndexed(commandBuffer, vertex_index_count, 1, 0, 0, instance);
+			return;
+		}
+
+		auto commandsBuffer = to_vulkan(_commands.vulkan_buffer.get());
+		auto commandsOffset = static_cast<VkDeviceSize>(slot * sizeof(VkDrawIndexedIndirectCommand));
+		++_indirect_draw_count;
+		if (_groups_drawables)
+		{
+			auto group = _group_count++;
+			add_input(vertex_index_count, bounds, instance, group, slot);
+
+			// The group's later drawables are packed into the commands after this one, so a single draw covers all of them.
+			vkCmdDrawIndexedIndirectCount(commandBuffer
+				, commandsBuffer, commandsOffset
+				, to_vulkan(_counts.vulkan_buffer.get()), static_cast<VkDeviceSize>(group * sizeof(uint32_t))
+				, static_cast<uint32_t>(max_group_size(slot))
+				, static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand))
+			);
+
+			_group_state = state;
+			_group_first = slot;
+			_group_size = 1;
+			_group_code = _code_count;
+			_group_joinable = true;
+		}
+		else
+		{
+			add_input(vertex_index_count, bounds, instance, 0, slot);
+
+			// The command of a culled drawable has no instances, so it draws nothing.
+			vkCmdDrawIndexedIndirect(commandBuffer
+				, commandsBuffer, commandsOffset
+				, 1
+				, static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand))
+			);
+		}
+	}
+
+	auto vulkan_draw_culling::draw_in_group(const vulkan_draw_state& state, shader_int vertex_index_count, draw_bounds bounds, uint32_t instance) -> bool
+	{
+		// Code run between the group's drawables may have drawn something, which the later drawables must be drawn on top of.
+		if (!_group_joinable || _group_code + 1 != _code_count) return false;
+		if (_draw_count >= _capacity || _group_size >= max_group_size(_group_first)) return false;
+		if (state != _group_state) return false;
+
+		add_input(vertex_index_count, bounds, instance, _group_count - 1, _group_first);
+		++_group_size;
+		_group_code = _code_count;
+		return true;
+	}
+
+	void vulkan_draw_culling::end() noexcept
+	{
+		if (!_input_data) return;
+
+		draw_culling_input_header header{
+			.draw_count = static_cast<uint32_t>(std::min(_draw_count, _capacity)),
+		};
+		std::memcpy(_input_data, &header, sizeof(header));
+	}
+
+	/******************************** private ********************************/
+
+	void vulkan_draw_culling::add_input(shader_int vertex_index_count, draw_bounds bounds, uint32_t instance, std::size_t group, std::size_t first_command) noexcept
+	{
+		draw_culling_input input{
+			.min = bounds.min,
+			.max = bounds.max,
+			.vertex_index_count = vertex_index_count,
+			.group = static_cast<uint32_t>(group),
+			.first_command = static_cast<uint32_t>(first_command),
+			.instance = instance,
+		};
+		auto* inputs = static_cast<std::byte*>(_input_data) + sizeof(draw_culling_input_header);
+		std::memcpy(inputs + _draw_count * sizeof(draw_culling_input), &input, sizeof(input));
+		++_draw_count;
+	}
+
+	auto vulkan_draw_culling::max_group_size(std::size_t first_command) const noexcept -> std::size_t
+	{
+		return std::min(_capacity - first_command, _gpu->max_draw_indirect_count());
+	}
+}
@@ -0,0 +1,194 @@
+#include "private/vulkan_windows/vulkan_draw_fields.hpp"
+#include "compwolf_vulkan.hpp"
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace compwolf::vulkan
+{
+	namespace
+	{
+		/** The smallest amount of drawables that the buffer is created to fit. */
+		constexpr std::size_t draw_fields_min_capacity = 64;
+	}
+
+	/******************************** constructors ********************************/
+
+	namespace internal
+	{
+		auto new_draw_fields_layout(vulkan_gpu_connection& gpu) -> unique_deleter_ptr<vulkan_handle::descriptor_set_layout_t>
+		{
+			auto logicDevice = to_vulkan(gpu.vulkan_device());
+
+			VkDescriptorSetLayoutBinding binding{
+				.binding = 0,
+				.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+				.descriptorCount = 1,
+				.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+			};
+			VkDescriptorSetLayoutCreateInfo createInfo{
+				.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+				.bindingCount = 1,
+				.pBindings = &binding,
+			};
+
+			VkDescriptorSetLayout descriptorSetLayout;
+			auto result = vkCreateDescriptorSetLayout(logicDevice, &createInfo, nullptr, &descriptorSetLayout);
+
+			switch (result)
+			{
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not create the descriptor set layout of drawables' push fields on the GPU: ")
+					throw std::runtime_error(message);
+			}
+
+			return unique_deleter_ptr<vulkan_handle::descriptor_set_layout_t>(from_vulkan(descriptorSetLayout),
+				[logicDevice](vulkan_handle::descriptor_set_layout l)
+				{
+					vkDestroyDescriptorSetLayout(logicDevice, to_vulkan(l), nullptr);
+				}
+			);
+		}
+
+		vulkan_draw_fields_sets::vulkan_draw_fields_sets(vulkan_gpu_connection& gpu, std::size_t frame_count)
+			: vulkan_descriptor_set_layout(new_draw_fields_layout(gpu))
+		{
+			auto logicDevice = to_vulkan(gpu.vulkan_device());
+			auto deletion_queue = &gpu.deletion_queue();
+
+			auto descriptorSize = static_cast<uint32_t>(frame_count);
+			VkDescriptorPool descriptorPool;
+			{
+				VkDescriptorPoolSize poolSize{
+					.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+					.descriptorCount = descriptorSize,
+				};
+				VkDescriptorPoolCreateInfo createInfo{
+					.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+					.maxSets = descriptorSize,
+					.poolSizeCount = 1,
+					.pPoolSizes = &poolSize,
+				};
+
+				auto result = vkCreateDescriptorPool(logicDevice, &createInfo, nullptr, &descriptorPool);
+
+				switch (result)
+				{
+				case VK_SUCCESS: break;
+				default:
+					const char* message;
+					GET_VULKAN_ERROR_STRING(result, message,
+						"Could not create a camera's push field descriptor pool on the GPU: ")
+						throw std::runtime_error(message);
+				}
+
+				vulkan_descriptor_pool = unique_deleter_ptr<vulkan_handle::descriptor_pool_t>(from_vulkan(descriptorPool),
+					[logicDevice, deletion_queue](vulkan_handle::descriptor_pool p)
+					{
+						deletion_queue->defer([logicDevice, p]()
+							{
+								vkDestroyDescriptorPool(logicDevice, to_vulkan(p), nullptr);
+							}
+						);
+					}
+				);
+			}
+			{
+				std::vector<VkDescriptorSetLayout> descriptorLayouts(descriptorSize, to_vulkan(vulkan_descriptor_set_layout.get()));
+
+				VkDescriptorSetAllocateInfo allocateInfo{
+					.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+					.descriptorPool = descriptorPool,
+					.descriptorSetCount = descriptorSize,
+					.pSetLayouts = descriptorLayouts.data(),
+				};
+
+				std::vector<VkDescriptorSet> descriptorSets(descriptorSize);
+				auto result = vkAllocateDescriptorSets(logicDevice, &allocateInfo, descriptorSets.data());
+
+				switch (result)
+				{
+				case VK_SUCCESS: break;
+				default:
+					const char* message;
+					GET_VULKAN_ERROR_STRING(result, message,
+						"Could not create a camera's push field descriptor set on the GPU: ")
+						throw std::runtime_error(message);
+				}
+
+				vulkan_descriptor_set.resize(descriptorSize);
+				for (uint32_t i = 0; i < descriptorSize; i++)
+				{
+					vulkan_descriptor_set[i] = from_vulkan(descriptorSets[i]);
+				}
+			}
+		}
+	}
+
+	/******************************** vulkan-specific ********************************/
+
+	void vulkan_draw_fields::begin(std::size_t draw_count)
+	{
+		_draw_count = 0;
+
+		auto needed_capacity = std::max(draw_count, _needed_capacity);
+		_needed_capacity = 0;
+		if (_capacity >= needed_capacity) return;
+
+		// The frame's previous gpu-instructions have finished by the time its new ones are recorded, so the old buffer is not in use.
+		auto new_capacity = std::max(_capacity, draw_fields_min_capacity);
+		while (new_capacity < needed_capacity) new_capacity *= 2;
+
+		_field_data = nullptr;
+		_fields = internal::vulkan_gpu_buffer_internal(*_gpu
+			, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+			, slot_size, new_capacity
+		);
+		_field_data = _fields.get_data(*_gpu);
+		_capacity = new_capacity;
+
+		VkDescriptorBufferInfo bufferInfo{
+			.buffer = to_vulkan(_fields.vulkan_buffer.get()),
+			.offset = 0,
+			.range = VK_WHOLE_SIZE,
+		};
+		VkWriteDescriptorSet writer{
+			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			.dstSet = to_vulkan(_descriptor_set),
+			.dstBinding = 0,
+			.dstArrayElement = 0,
+			.descriptorCount = 1,
+			.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			.pBufferInfo = &bufferInfo,
+		};
+		vkUpdateDescriptorSets(to_vulkan(_gpu->vulkan_device()), 1, &writer, 0, nullptr);
+	}
+
+	auto vulkan_draw_fields::add(const void* const* field_push_data
+		, const std::vector<bool>& field_is_push_field
+		, const std::vector<std::size_t>& field_push_offsets
+		, const std::vector<std::size_t>& field_sizes
+	) noexcept -> std::optional<uint32_t>
+	{
+		auto slot = _draw_count++;
+		if (slot >= _capacity)
+		{
+			_needed_capacity = _draw_count;
+			return std::nullopt;
+		}
+
+		// The buffer is written while the instructions are recorded, which is fine as the cpu's writes are visible to the gpu once the instructions are submitted.
+		auto* data = static_cast<std::byte*>(_field_data) + slot * slot_size;
+		for (std::size_t i = 0; i < field_is_push_field.size(); ++i)
+		{
+			if (!field_is_push_field[i]) continue;
+			std::memcpy(data + field_push_offsets[i], field_push_data[i], field_sizes[i]);
+		}
+		return static_cast<uint32_t>(slot);
+	}
+}
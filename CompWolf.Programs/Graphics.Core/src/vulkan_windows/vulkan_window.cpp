@@ -1,6 +1,8 @@
 #include "private/vulkan_windows/vulkan_window.hpp"
 #include "compwolf_vulkan.hpp"
 
+#include "private/vulkan_windows/present_batch.hpp"
+#include <profilers>
 #include <stdexcept>
 #include <utility>
 
@@ -9,6 +11,9 @@ namespace compwolf::vulkan
 	vulkan_window::vulkan_window(vulkan_graphics_environment* environment, vulkan_gpu_connection* gpu, window_settings settings)
 		: window(*environment, settings)
 	{
+		if ((environment ? *environment : gpu->environment()).headless())
+			throw std::logic_error("Could not create a window; the graphics environment is headless. An offscreen_target can be used instead.");
+
 		{
 			glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
 			glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
@@ -85,42 +90,90 @@ namespace compwolf::vulkan
 		set_gpu(gpu);
 
 		_swapchain = window_swapchain(settings, glfw_window(), _surface);
+		_frame_pacer.set_target_frame_rate(settings.target_frame_rate);
+		_frame_stats = compwolf::frame_stats(settings.frame_stats_size, settings.frame_stats_interval);
 	}
 
-	void vulkan_window::update_image()
+	vulkan_window::vulkan_window(vulkan_graphics_environment* environment, vulkan_gpu_connection* gpu, window_settings settings, bool readback)
+		: window(environment ? *environment : gpu->environment(), settings)
 	{
-		window::update_image();
+		_surface = window_surface(environment, gpu);
+		set_gpu(&_surface.gpu());
+
+		_swapchain = window_swapchain(settings, _surface, readback);
+		_frame_pacer.set_target_frame_rate(settings.target_frame_rate);
+		_frame_stats = compwolf::frame_stats(settings.frame_stats_size, settings.frame_stats_interval);
+	}
+
+	void vulkan_window::draw_next_frame(present_batch* batch)
+	{
+		// The swapchain still has the times of the last frame, which is over now that the next one starts.
+		auto frame_start = std::chrono::steady_clock::now();
+		if (_last_frame_start != std::chrono::steady_clock::time_point{})
+		{
+			_frame_stats.add(frame_metric::cpu_frame_time, std::chrono::duration_cast<std::chrono::nanoseconds>(frame_start - _last_frame_start));
+			_frame_stats.add(frame_metric::acquire_wait, swapchain().acquire_wait_time());
+			_frame_stats.add(frame_metric::fence_wait, swapchain().fence_wait_time());
+			_frame_stats.add(frame_metric::present_wait, swapchain().present_wait_time());
+			_frame_stats.end_frame();
+		}
+		_last_frame_start = frame_start;
+
+		// The frame is gotten as late as possible, so that it is not waiting to be drawn while the cpu does other things.
+		swapchain().to_next_frame();
 
 		auto& frame = swapchain().current_frame();
 		auto frame_index = swapchain().current_frame_index();
+		auto& frame_in_flight = swapchain().current_frame_in_flight();
+		auto frame_in_flight_index = swapchain().current_frame_in_flight_index();
 		_drawing.invoke(window_draw_parameters
 			{
 				.target_window = this,
 				.target_frame = &frame,
 				.target_frame_index = frame_index,
+				.target_frame_in_flight = &frame_in_flight,
+				.target_frame_in_flight_index = frame_in_flight_index,
+				.batch = batch,
 			}
 		);
+
+		// Every camera has now read its times of the frame in flight's last frame.
+		if (frame_in_flight_index < _gpu_frame_times.size() && _gpu_frame_times[frame_in_flight_index])
 		{
-			auto& draw_manager = frame.draw_manager();
-			auto vkSemaphore = to_vulkan(draw_manager.last_vulkan_semaphore());
-			auto vkSwapchain = to_vulkan(swapchain().vulkan_swapchain());
-			auto frameIndex = static_cast<uint32_t>(frame_index);
-			auto& thread = draw_manager.thread();
-
-			VkPresentInfoKHR presentInfo{
-				.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
-				.waitSemaphoreCount = (vkSemaphore == nullptr)
-					? static_cast<uint32_t>(0)
-					: static_cast<uint32_t>(1),
-				.pWaitSemaphores = &vkSemaphore,
-				.swapchainCount = 1,
-				.pSwapchains = &vkSwapchain,
-				.pImageIndices = &frameIndex,
-			};
-
-			vkQueuePresentKHR(to_vulkan(thread.queue), &presentInfo);
+			_frame_stats.add(frame_metric::gpu_frame_time, *_gpu_frame_times[frame_in_flight_index]);
+			_gpu_frame_times[frame_in_flight_index].reset();
 		}
+	}
 
-		swapchain().to_next_frame();
+	void vulkan_window::add_gpu_frame_time(std::size_t frame_in_flight_index, std::chrono::nanoseconds time)
+	{
+		if (_gpu_frame_times.size() <= frame_in_flight_index) _gpu_frame_times.resize(frame_in_flight_index + 1);
+
+		auto& frame_time = _gpu_frame_times[frame_in_flight_index];
+		frame_time = frame_time.value_or(std::chrono::nanoseconds(0)) + time;
+	}
+
+	void vulkan_window::update_image()
+	{
+		COMPWOLF_PROFILE_ZONE("window::update_image");
+		window::update_image();
+
+		draw_next_frame(nullptr);
+
+		swapchain().present();
+
+		// Waiting here, before the program gets the input for the next frame, keeps the input as fresh as possible when it is drawn.
+		_frame_pacer.wait();
+	}
+
+	void vulkan_window::update_image(present_batch& batch)
+	{
+		COMPWOLF_PROFILE_ZONE("window::update_image");
+		window::update_image();
+
+		draw_next_frame(&batch);
+
+		// The work after drawing goes in the same vkQueueSubmit2 as the drawing itself.
+		batch.add(swapchain().prepare_present());
 	}
 }
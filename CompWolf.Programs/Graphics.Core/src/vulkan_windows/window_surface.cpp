@@ -5,12 +5,14 @@
 #include <optional>
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 namespace compwolf::vulkan
 {
 	static std::optional<float> get_surface_format_score(const VkSurfaceFormatKHR& surface_format);
+	static auto get_preferred_present_mode(present_policy policy) noexcept -> VkPresentModeKHR;
 	static std::optional<vulkan_handle::surface_format_info_t> get_present_device_info(
-		const vulkan_gpu_connection& gpu, VkSurfaceKHR surface
+		const vulkan_gpu_connection& gpu, VkSurfaceKHR surface, present_policy policy
 	);
 	static auto find_best_gpu(vulkan_graphics_environment& environment, window_settings& settings,
 		vulkan_handle::surface surface, vulkan_handle::surface_format_info out_info) -> vulkan_gpu_connection*;
@@ -59,7 +61,7 @@ namespace compwolf::vulkan
 		if (optional_gpu)
 		{
 			_gpu = optional_gpu;
-			auto optional_surface = get_present_device_info(*optional_gpu, surface);
+			auto optional_surface = get_present_device_info(*optional_gpu, surface, settings.present);
 			if (!optional_surface.has_value()) throw std::runtime_error("Could not create a window; its specified gpu cannot draw on the window.");
 			surface_format = optional_surface.value();
 		}
@@ -68,61 +70,55 @@ namespace compwolf::vulkan
 			_gpu = find_best_gpu(*optional_environment, settings, vulkan_surface(), &surface_format);
 			if (!_gpu) throw std::runtime_error("Could not create a window; no suitable gpu.");
 		}
-		auto logicDevice = to_vulkan(gpu().vulkan_device());
+		// The render pass is shared by all windows with the same format, so that brushes can use the same pipeline for all of them.
+		if (!gpu().uses_dynamic_rendering())
+			_render_pass = gpu().vulkan_render_pass(vulkan_image_format());
+	}
 
-		VkRenderPass renderPass;
+	window_surface::window_surface(vulkan_graphics_environment* optional_environment,
+		vulkan_gpu_connection* optional_gpu)
+	{
+		if (optional_gpu)
+		{
+			if (!std::as_const(*optional_gpu).work_types()[gpu_work_type::draw]) throw std::runtime_error("Could not create an offscreen target; its specified gpu cannot draw.");
+			_gpu = optional_gpu;
+		}
+		else
 		{
-			VkAttachmentDescription colorAttachment{
-				.format = surface_format.format.format,
-				.samples = VK_SAMPLE_COUNT_1_BIT,
-				.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
-				.storeOp = VK_ATTACHMENT_STORE_OP_STORE,
-				.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-				.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
-				.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-				.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
-			};
-
-			VkAttachmentReference colorAttachmentReference{
-				.attachment = 0,
-				.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-			};
-			VkSubpassDescription subpass{
-				.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
-				.colorAttachmentCount = 1,
-				.pColorAttachments = &colorAttachmentReference,
-			};
-
-			VkRenderPassCreateInfo createInfo{
-				.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
-				.attachmentCount = 1,
-				.pAttachments = &colorAttachment,
-				.subpassCount = 1,
-				.pSubpasses = &subpass,
-			};
-
-			auto result = vkCreateRenderPass(logicDevice, &createInfo, nullptr, &renderPass);
+			for (auto& gpu : optional_environment->gpus())
+			{
+				if (!std::as_const(gpu).work_types()[gpu_work_type::draw]) continue;
+				_gpu = &gpu;
+				break;
+			}
+			if (!_gpu) throw std::runtime_error("Could not create an offscreen target; no gpu can draw.");
+		}
 
-			switch (result)
+		// The images are not displayed, so their format is picked to be simple for the cpu to read back.
+		_format = unique_deleter_ptr<vulkan_handle::surface_format_info_t>(new vulkan_handle::surface_format_info_t{
+				.capabilities = {},
+				.format = {
+					.format = VK_FORMAT_R8G8B8A8_UNORM,
+					.colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR,
+				},
+				.present_mode = VK_PRESENT_MODE_FIFO_KHR,
+			},
+			[](vulkan_handle::surface_format_info s)
 			{
-			case VK_SUCCESS: break;
-			default:
-				const char* message;
-				GET_VULKAN_ERROR_STRING(result, message,
-					"Could not create a window's \"render pass\" for drawing on it: ")
-					throw std::runtime_error(message);
+				delete s;
 			}
+		);
 
-			_render_pass = unique_deleter_ptr<vulkan_handle::render_pass_t>(from_vulkan(renderPass),
-				[logicDevice](vulkan_handle::render_pass p)
-				{
-					vkDestroyRenderPass(logicDevice, to_vulkan(p), nullptr);
-				}
-			);
-		}
+		if (!gpu().uses_dynamic_rendering())
+			_render_pass = gpu().vulkan_render_pass(vulkan_image_format(), true);
 	}
 
-	static auto find_best_gpu(vulkan_graphics_environment& environment, window_settings&,
+	auto window_surface::vulkan_image_format() const noexcept -> vulkan_handle::format
+	{
+		return static_cast<vulkan_handle::format>(_format->format.format);
+	}
+
+	static auto find_best_gpu(vulkan_graphics_environment& environment, window_settings& settings,
 		vulkan_handle::surface surface, vulkan_handle::surface_format_info out_info) -> vulkan_gpu_connection*
 	{
 		auto vkSurface = to_vulkan(surface);
@@ -131,7 +127,7 @@ namespace compwolf::vulkan
 		float best_gpu_score = -1;
 		for (auto& gpu : environment.gpus())
 		{
-			auto info_container = get_present_device_info(gpu, vkSurface);
+			auto info_container = get_present_device_info(gpu, vkSurface, settings.present);
 			if (!info_container.has_value()) continue;
 			auto& info = info_container.value();
 
@@ -148,7 +144,7 @@ namespace compwolf::vulkan
 				extent_score = std::clamp(extent_score, 0.f, 1.f);
 			}
 
-			float present_mode_score = (info.present_mode == VK_PRESENT_MODE_MAILBOX_KHR) ? 1.f : 0.f;
+			float present_mode_score = (info.present_mode == get_preferred_present_mode(settings.present)) ? 1.f : 0.f;
 
 			float score = 0
 				+ get_surface_format_score(info.format).value() * extent_score_step
@@ -165,8 +161,21 @@ namespace compwolf::vulkan
 
 		return best_gpu;
 	}
+	static auto get_preferred_present_mode(present_policy policy) noexcept -> VkPresentModeKHR
+	{
+		switch (policy)
+		{
+		case present_policy::fifo: return VK_PRESENT_MODE_FIFO_KHR;
+		case present_policy::fifo_relaxed: return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+		case present_policy::immediate: return VK_PRESENT_MODE_IMMEDIATE_KHR;
+		case present_policy::mailbox:
+		case present_policy::automatic:
+		default:
+			return VK_PRESENT_MODE_MAILBOX_KHR;
+		}
+	}
 	static std::optional<vulkan_handle::surface_format_info_t> get_present_device_info(
-		const vulkan_gpu_connection& gpu, VkSurfaceKHR surface)
+		const vulkan_gpu_connection& gpu, VkSurfaceKHR surface, present_policy policy)
 	{
 		auto physicalDevice = to_vulkan(gpu.vulkan_physical_device());
 
@@ -230,10 +239,11 @@ namespace compwolf::vulkan
 		);
 		if (presentModes.empty()) return std::nullopt;
 
-		bool has_better_present_mode = std::find(presentModes.begin(), presentModes.end(), VK_PRESENT_MODE_MAILBOX_KHR) != presentModes.end();
-		return_value.present_mode = has_better_present_mode
-			? VK_PRESENT_MODE_MAILBOX_KHR // Best, allows triple-buffering
-			: VK_PRESENT_MODE_FIFO_KHR; // Second best, always available
+		auto preferredPresentMode = get_preferred_present_mode(policy);
+		bool has_preferred_present_mode = std::find(presentModes.begin(), presentModes.end(), preferredPresentMode) != presentModes.end();
+		return_value.present_mode = has_preferred_present_mode
+			? preferredPresentMode
+			: VK_PRESENT_MODE_FIFO_KHR; // Always available
 
 		return return_value;
 	}
@@ -3,10 +3,236 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include <chrono>
+#include <vector>
+#include <span>
 #include <vulkan_programs>
+#include <profilers>
 
 namespace compwolf::vulkan
 {
+	namespace
+	{
+		auto create_image_view(VkDevice logicDevice, vulkan_deletion_queue* deletion_queue, VkImage image, VkFormat format) -> unique_deleter_ptr<vulkan_handle::image_view_t>
+		{
+			VkImageViewCreateInfo createInfo{
+				.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+				.image = image,
+				.viewType = VK_IMAGE_VIEW_TYPE_2D,
+				.format = format,
+				.components{
+					.r = VK_COMPONENT_SWIZZLE_IDENTITY,
+					.g = VK_COMPONENT_SWIZZLE_IDENTITY,
+					.b = VK_COMPONENT_SWIZZLE_IDENTITY,
+					.a = VK_COMPONENT_SWIZZLE_IDENTITY,
+				},
+				.subresourceRange{
+					.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+					.baseMipLevel = 0,
+					.levelCount = 1,
+					.baseArrayLayer = 0,
+					.layerCount = 1,
+				},
+			};
+
+			VkImageView view;
+			auto result = vkCreateImageView(logicDevice, &createInfo, nullptr, &view);
+
+			switch (result)
+			{
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not get a window's swapchain's images: ")
+					throw std::runtime_error(message);
+			}
+
+			return unique_deleter_ptr<vulkan_handle::image_view_t>(from_vulkan(view),
+				[logicDevice, deletion_queue](vulkan_handle::image_view i)
+				{
+					deletion_queue->defer([logicDevice, i]()
+						{
+							vkDestroyImageView(logicDevice, to_vulkan(i), nullptr);
+						}
+					);
+				}
+			);
+		}
+
+		auto create_frame_buffer(VkDevice logicDevice, vulkan_deletion_queue* deletion_queue, vulkan_handle::render_pass render_pass, vulkan_handle::image_view image
+			, uint32_t width, uint32_t height) -> unique_deleter_ptr<vulkan_handle::frame_buffer_t>
+		{
+			auto vkImage = to_vulkan(image);
+
+			VkFramebufferCreateInfo create_info{
+				.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+				.renderPass = to_vulkan(render_pass),
+				.attachmentCount = 1,
+				.pAttachments = &vkImage,
+				.width = width,
+				.height = height,
+				.layers = 1,
+			};
+
+			VkFramebuffer framebuffer;
+			auto result = vkCreateFramebuffer(logicDevice, &create_info, nullptr, &framebuffer);
+
+			switch (result)
+			{
+			case VK_SUCCESS: break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not set up a framebuffer for a window's swapchain: ")
+					throw std::runtime_error(message);
+			}
+
+			return unique_deleter_ptr<vulkan_handle::frame_buffer_t>(from_vulkan(framebuffer),
+				[logicDevice, deletion_queue](vulkan_handle::frame_buffer f)
+				{
+					deletion_queue->defer([logicDevice, f]()
+						{
+							vkDestroyFramebuffer(logicDevice, to_vulkan(f), nullptr);
+						}
+					);
+				}
+			);
+		}
+
+		auto create_frames_in_flight(vulkan_gpu_connection& gpu, const window_settings& settings, gpu_work_type_set work_types)
+			-> std::vector<frame_in_flight>
+		{
+			auto frames_in_flight_count = settings.frames_in_flight == 0 ? std::size_t(2) : settings.frames_in_flight;
+			std::vector<frame_in_flight> frames_in_flight(frames_in_flight_count);
+			for (auto& frame : frames_in_flight)
+			{
+				frame.draw_manager() = vulkan_gpu_program_manager::new_manager_for(gpu
+					, gpu_program_manager_settings
+					{
+						.type = work_types,
+					}
+				);
+				if (work_types[gpu_work_type::present]) frame.acquire_semaphore() = vulkan_gpu_semaphore(gpu);
+			}
+			return frames_in_flight;
+		}
+
+		/** Creates an image on the gpu, for an [[offscreen_target]] to draw on. */
+		void create_offscreen_image(VkDevice logicDevice, vulkan_deletion_queue* deletion_queue, VkPhysicalDevice physicalDevice, VkFormat format
+			, uint32_t width, uint32_t height, swapchain_frame& frame)
+		{
+			VkImage image;
+			{
+				VkImageCreateInfo createInfo{
+					.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+					.imageType = VK_IMAGE_TYPE_2D,
+					.format = format,
+					.extent = {
+						.width = width,
+						.height = height,
+						.depth = 1,
+					},
+					.mipLevels = 1,
+					.arrayLayers = 1,
+					.samples = VK_SAMPLE_COUNT_1_BIT,
+					.tiling = VK_IMAGE_TILING_OPTIMAL,
+					.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+					.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+					.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+				};
+
+				auto result = vkCreateImage(logicDevice, &createInfo, nullptr, &image);
+
+				switch (result)
+				{
+				case VK_SUCCESS: break;
+				default:
+					const char* message;
+					GET_VULKAN_ERROR_STRING(result, message,
+						"Could not create an image for an offscreen target: ")
+						throw std::runtime_error(message);
+				}
+
+				frame.owned_image_ptr() = unique_deleter_ptr<vulkan_handle::image_t>(from_vulkan(image),
+					[logicDevice, deletion_queue](vulkan_handle::image i)
+					{
+						deletion_queue->defer([logicDevice, i]()
+							{
+								vkDestroyImage(logicDevice, to_vulkan(i), nullptr);
+							}
+						);
+					}
+				);
+				frame.swapchain_image_ref() = from_vulkan(image);
+			}
+
+			VkDeviceMemory memory;
+			{
+				VkMemoryRequirements memoryRequirements;
+				vkGetImageMemoryRequirements(logicDevice, image, &memoryRequirements);
+
+				VkPhysicalDeviceMemoryProperties memoryProperties;
+				vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+				uint32_t heap_index;
+				for (heap_index = 0; heap_index < memoryProperties.memoryTypeCount; ++heap_index)
+				{
+					auto& memoryType = memoryProperties.memoryTypes[heap_index];
+
+					if ((memoryRequirements.memoryTypeBits & (1 << heap_index)) == 0) continue;
+					if ((memoryType.propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) == 0) continue;
+					break;
+				}
+				if (heap_index == memoryProperties.memoryTypeCount)
+					throw std::runtime_error("Could not create an image for an offscreen target: no suitable type of memory on the GPU.");
+
+				VkMemoryAllocateInfo allocateInfo{
+					.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+					.allocationSize = memoryRequirements.size,
+					.memoryTypeIndex = heap_index,
+				};
+
+				auto result = vkAllocateMemory(logicDevice, &allocateInfo, nullptr, &memory);
+
+				switch (result)
+				{
+				case VK_SUCCESS: break;
+				default:
+					const char* message;
+					GET_VULKAN_ERROR_STRING(result, message,
+						"Could not allocate an offscreen target's image's memory on the GPU: ")
+						throw std::runtime_error(message);
+				}
+
+				frame.owned_image_memory_ptr() = unique_deleter_ptr<vulkan_handle::memory_t>(from_vulkan(memory),
+					[logicDevice, deletion_queue](vulkan_handle::memory m)
+					{
+						deletion_queue->defer([logicDevice, m]()
+							{
+								vkFreeMemory(logicDevice, to_vulkan(m), nullptr);
+							}
+						);
+					}
+				);
+			}
+
+			{
+				auto result = vkBindImageMemory(logicDevice, image, memory, 0);
+
+				switch (result)
+				{
+				case VK_SUCCESS: break;
+				default:
+					const char* message;
+					GET_VULKAN_ERROR_STRING(result, message,
+						"Could not bind an offscreen target's image and its memory together: ")
+						throw std::runtime_error(message);
+				}
+			}
+		}
+	}
+
 	window_swapchain::window_swapchain(window_settings& settings,
 		vulkan_handle::glfw_window window, window_surface& surface)
 		: _gpu(&surface.gpu())
@@ -14,6 +240,7 @@ namespace compwolf::vulkan
 		auto glfwWindow = to_vulkan(window);
 
 		auto logicDevice = to_vulkan(gpu().vulkan_device());
+		auto deletion_queue = &gpu().deletion_queue();
 
 		auto vkSurface = to_vulkan(surface.vulkan_surface());
 		auto& surface_format = *surface.vulkan_format();
@@ -75,9 +302,11 @@ namespace compwolf::vulkan
 			}
 
 			_vulkan_swapchain = unique_deleter_ptr<vulkan_handle::swapchain_t>(from_vulkan(swapchain),
-				[logicDevice](vulkan_handle::swapchain s)
+				[logicDevice, deletion_queue](vulkan_handle::swapchain s)
 				{
-					vkDeviceWaitIdle(logicDevice);
+					// The surface cannot get a new swapchain, or be destroyed, until this one is; so this cannot be deferred.
+					// Flushing also destroys the frames' image views before their images.
+					deletion_queue->flush();
 					vkDestroySwapchainKHR(logicDevice, to_vulkan(s), nullptr);
 				}
 			);
@@ -105,133 +334,234 @@ namespace compwolf::vulkan
 			_frames = std::vector<swapchain_frame>(images.size());
 			for (std::size_t i = 0; i < images.size(); ++i)
 			{
-				VkImageViewCreateInfo createInfo{
-					.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
-					.image = images[i],
-					.viewType = VK_IMAGE_VIEW_TYPE_2D,
-					.format = surface_format.format.format,
-					.components{
-						.r = VK_COMPONENT_SWIZZLE_IDENTITY,
-						.g = VK_COMPONENT_SWIZZLE_IDENTITY,
-						.b = VK_COMPONENT_SWIZZLE_IDENTITY,
-						.a = VK_COMPONENT_SWIZZLE_IDENTITY,
-					},
-					.subresourceRange{
-						.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-						.baseMipLevel = 0,
-						.levelCount = 1,
-						.baseArrayLayer = 0,
-						.layerCount = 1,
-					},
-				};
-
-				VkImageView view;
-				auto result = vkCreateImageView(logicDevice, &createInfo, nullptr, &view);
+				_frames[i].swapchain_image_ref() = from_vulkan(images[i]);
+				_frames[i].image_ptr() = create_image_view(logicDevice, deletion_queue, images[i], surface_format.format.format);
+			}
 
-				switch (result)
+			// With dynamic rendering, the images are drawn on directly, without frame buffers.
+			if (surface.vulkan_render_pass())
+			{
+				for (auto& frame : _frames)
 				{
-				case VK_SUCCESS: break;
-				default:
-					const char* message;
-					GET_VULKAN_ERROR_STRING(result, message,
-						"Could not get a window's swapchain's images: ")
-						throw std::runtime_error(message);
+					frame.frame_buffer_ptr() = create_frame_buffer(logicDevice, deletion_queue, surface.vulkan_render_pass(), frame.image(), width, height);
 				}
-
-				_frames[i].image_ptr() = unique_deleter_ptr<vulkan_handle::image_view_t>(from_vulkan(view),
-					[logicDevice](vulkan_handle::image_view i)
-					{
-						vkDeviceWaitIdle(logicDevice);
-						vkDestroyImageView(logicDevice, to_vulkan(i), nullptr);
-					}
-				);
 			}
+		}
 
-			for (auto& frame : _frames)
-			{
-				auto swapchainImage = to_vulkan(frame.image());
-
-				VkFramebufferCreateInfo create_info{
-					.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
-					.renderPass = to_vulkan(surface.vulkan_render_pass()),
-					.attachmentCount = 1,
-					.pAttachments = &swapchainImage,
-					.width = width,
-					.height = height,
-					.layers = 1,
-				};
+		_frames_in_flight = create_frames_in_flight(gpu(), settings, { gpu_work_type::draw, gpu_work_type::present });
+		_current_frame_in_flight_index = _frames_in_flight.size() - 1;
 
-				VkFramebuffer framebuffer;
-				auto result = vkCreateFramebuffer(logicDevice, &create_info, nullptr, &framebuffer);
+		for (auto& frame : _frames) frame.present_semaphore() = vulkan_gpu_semaphore(gpu());
+	}
 
-				switch (result)
+	window_swapchain::window_swapchain(window_settings& settings, window_surface& surface, bool readback)
+		: _gpu(&surface.gpu())
+		, _readback(readback)
+	{
+		auto logicDevice = to_vulkan(gpu().vulkan_device());
+		auto deletion_queue = &gpu().deletion_queue();
+		auto physicalDevice = to_vulkan(gpu().vulkan_physical_device());
+		auto format = static_cast<VkFormat>(surface.vulkan_image_format());
+
+		uint32_t width, height;
+		{
+			auto size = settings.pixel_size;
+			width = static_cast<uint32_t>(size.x());
+			height = static_cast<uint32_t>(size.y());
+		}
+
+		// Nothing is displayed, so the frames in flight only need to draw.
+		_frames_in_flight = create_frames_in_flight(gpu(), settings, { gpu_work_type::draw });
+		_current_frame_in_flight_index = _frames_in_flight.size() - 1;
+
+		// Frames; each frame in flight always draws the same image, so there are as many images as frames in flight.
+		_frames = std::vector<swapchain_frame>(_frames_in_flight.size());
+		for (auto& frame : _frames)
+		{
+			create_offscreen_image(logicDevice, deletion_queue, physicalDevice, format, width, height, frame);
+			frame.image_ptr() = create_image_view(logicDevice, deletion_queue, to_vulkan(frame.swapchain_image()), format);
+
+			if (surface.vulkan_render_pass())
+				frame.frame_buffer_ptr() = create_frame_buffer(logicDevice, deletion_queue, surface.vulkan_render_pass(), frame.image(), width, height);
+
+			if (readback)
+				frame.readback_buffer() = internal::vulkan_gpu_buffer_internal(gpu(), VK_BUFFER_USAGE_TRANSFER_DST_BIT
+					, 4, static_cast<std::size_t>(width) * height);
+		}
+
+		// The images are kept in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL between frames, so they are moved into it once up front.
+		// This lets the images be read from even if nothing has drawn on them.
+		{
+			auto& draw_manager = _frames_in_flight.front().draw_manager();
+			vulkan_gpu_program program(draw_manager, [this](const vulkan_code_parameters& args)
 				{
-				case VK_SUCCESS: break;
-				default:
-					const char* message;
-					GET_VULKAN_ERROR_STRING(result, message,
-						"Could not set up a framebuffer for a window's swapchain: ")
-						throw std::runtime_error(message);
+					for (auto& frame : _frames) args.barriers->use(frame.swapchain_image(), vulkan_resource_access::copy_read, true);
+					args.barriers->flush();
 				}
+			);
 
-				frame.frame_buffer_ptr() = unique_deleter_ptr<vulkan_handle::frame_buffer_t>(from_vulkan(framebuffer),
-					[logicDevice](vulkan_handle::frame_buffer f)
-					{
-						vkDeviceWaitIdle(logicDevice);
-						vkDestroyFramebuffer(logicDevice, to_vulkan(f), nullptr);
-					}
-				);
-			}
-
-			for (auto& frame : _frames)
-			{
-				frame.draw_manager() = vulkan_gpu_program_manager::new_manager_for(gpu()
-					, gpu_program_manager_settings
-					{
-						.type = { gpu_work_type::draw, gpu_work_type::present },
-					}
-				);
-			}
+			program.execute().wait();
 		}
 
-		_temp_sync = gpu_program_sync
+		// The work done after drawing each frame, in place of displaying it.
+		_offscreen_programs = std::vector<vulkan_gpu_program>(_frames_in_flight.size());
+		for (std::size_t i = 0; i < _frames_in_flight.size(); ++i)
 		{
-			.semaphore = vulkan_gpu_semaphore(gpu()),
-			.fence = vulkan_gpu_fence(gpu(), true),
-		};
+			auto& frame = _frames[i];
+			auto code = [width, height, readback, &frame](const vulkan_code_parameters& args)
+				{
+					auto commandBuffer = to_vulkan(args.command);
+					auto image = to_vulkan(frame.swapchain_image());
+
+					// The image is left in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL by the drawing, which is earlier work of the same manager.
+					// The program's copy waits for that work with the manager's semaphore, so no barrier is needed before reading the image.
+					args.barriers->track(frame.swapchain_image(), vulkan_resource_state{
+						.layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+					});
+					args.barriers->use(frame.swapchain_image(), vulkan_resource_access::copy_read);
+					args.barriers->flush();
+
+					if (!readback) return;
+
+					auto readbackBuffer = frame.readback_buffer().vulkan_buffer.get();
+					auto buffer = to_vulkan(readbackBuffer);
+					args.barriers->use(readbackBuffer, vulkan_resource_access::copy_write);
+					args.barriers->flush();
+					VkBufferImageCopy region{
+						.bufferOffset = 0,
+						.bufferRowLength = 0,
+						.bufferImageHeight = 0,
+						.imageSubresource{
+							.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+							.mipLevel = 0,
+							.baseArrayLayer = 0,
+							.layerCount = 1,
+						},
+						.imageOffset = { 0, 0, 0 },
+						.imageExtent = { width, height, 1 },
+					};
+					vkCmdCopyImageToBuffer(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer, 1, &region);
+
+					args.barriers->use(readbackBuffer, vulkan_resource_access::host_read);
+					args.barriers->flush();
+				};
 
-		to_next_frame();
+			// The program is constructed in place, as it keeps a pointer to itself for when its manager is destructed.
+			_offscreen_programs[i].~vulkan_gpu_program();
+			new(&_offscreen_programs[i])vulkan_gpu_program(_frames_in_flight[i].draw_manager(), code);
+			// Only the copies use the image, so only they wait for the drawing.
+			_offscreen_programs[i].set_wait_stages(vulkan_access_info(vulkan_resource_access::copy_read).stages);
+		}
 	}
 
 	void window_swapchain::to_next_frame()
 	{
+		COMPWOLF_PROFILE_ZONE("window_swapchain::to_next_frame");
 		auto logicDevice = to_vulkan(gpu().vulkan_device());
 		auto swapchain = to_vulkan(vulkan_swapchain());
 
-		uint32_t index;
-		_temp_sync.fence.reset();
-		auto result = vkAcquireNextImageKHR(logicDevice, swapchain, UINT64_MAX,
-			to_vulkan(_temp_sync.semaphore.vulkan_semaphore()),
-			to_vulkan(_temp_sync.fence.vulkan_fence()),
-			&index
-		);
+		auto wait_start = std::chrono::steady_clock::now();
+
+		// Wait for the gpu to be done with the next frame in flight's earlier frame, so that its data can be reused.
+		_current_frame_in_flight_index = (_current_frame_in_flight_index + 1) % _frames_in_flight.size();
+		auto& flight = current_frame_in_flight();
+		flight.draw_manager().wait();
 
-		switch (result)
+		auto acquire_start = std::chrono::steady_clock::now();
+
+		if (offscreen())
 		{
-		case VK_SUCCESS:
-		case VK_SUBOPTIMAL_KHR:
-			break;
-		default:
-			const char* message;
-			GET_VULKAN_ERROR_STRING(result, message,
-				"Could not get the next frame image for a window: ")
-				throw std::runtime_error(message);
+			// Each frame in flight has its own image, so there is nothing to get from the gpu.
+			_current_frame_index = _current_frame_in_flight_index;
 		}
+		else
+		{
+			COMPWOLF_PROFILE_ZONE("vkAcquireNextImageKHR");
+			uint32_t index;
+			auto result = vkAcquireNextImageKHR(logicDevice, swapchain, UINT64_MAX,
+				to_vulkan(flight.acquire_semaphore().vulkan_semaphore()),
+				VK_NULL_HANDLE,
+				&index
+			);
+
+			switch (result)
+			{
+			case VK_SUCCESS:
+			case VK_SUBOPTIMAL_KHR:
+				break;
+			default:
+				const char* message;
+				GET_VULKAN_ERROR_STRING(result, message,
+					"Could not get the next frame image for a window: ")
+					throw std::runtime_error(message);
+			}
 
-		_current_frame_index = static_cast<std::size_t>(index);
-		current_frame().draw_manager().clear_syncs(); // Wait for the last usage of the frame image to be done
-		std::swap(_temp_sync,
-			current_frame().draw_manager().new_synchronization(true)
-		);
+			_current_frame_index = static_cast<std::size_t>(index);
+
+			// The frame's first work waits for the image; if nothing draws, the work signaling present_semaphore does.
+			flight.draw_manager().set_next_wait_semaphore(flight.acquire_semaphore().vulkan_semaphore());
+		}
+
+		auto acquire_end = std::chrono::steady_clock::now();
+
+		// The image may be handed out in another order than the frames in flight, so another frame in flight may still be drawing it.
+		auto& last_flight_index = current_frame().last_frame_in_flight_ref();
+		if (last_flight_index && *last_flight_index != _current_frame_in_flight_index)
+			_frames_in_flight[*last_flight_index].draw_manager().wait();
+		last_flight_index = _current_frame_in_flight_index;
+
+		_acquire_time = std::chrono::steady_clock::now();
+		_frame_wait_time = std::chrono::duration_cast<std::chrono::nanoseconds>(_acquire_time - wait_start);
+		_acquire_wait_time = std::chrono::duration_cast<std::chrono::nanoseconds>(acquire_end - acquire_start);
+		_fence_wait_time = _frame_wait_time - _acquire_wait_time;
+	}
+
+	void window_swapchain::present()
+	{
+		auto submission = prepare_present();
+		auto present_start = std::chrono::steady_clock::now();
+		submit_programs(std::span(&submission, 1));
+
+		if (offscreen())
+		{
+			mark_presented(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - present_start));
+			return;
+		}
+
+		auto& draw_manager = current_frame_in_flight().draw_manager();
+		auto vkSemaphore = to_vulkan(current_frame().present_semaphore().vulkan_semaphore());
+		auto vkSwapchain = to_vulkan(vulkan_swapchain());
+		auto frameIndex = static_cast<uint32_t>(current_frame_index());
+		auto& thread = draw_manager.thread();
+
+		VkPresentInfoKHR presentInfo{
+			.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+			.waitSemaphoreCount = 1,
+			.pWaitSemaphores = &vkSemaphore,
+			.swapchainCount = 1,
+			.pSwapchains = &vkSwapchain,
+			.pImageIndices = &frameIndex,
+		};
+
+		{
+			COMPWOLF_PROFILE_ZONE("vkQueuePresentKHR");
+			vkQueuePresentKHR(to_vulkan(thread.queue), &presentInfo);
+		}
+
+		mark_presented(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - present_start));
+	}
+
+	auto window_swapchain::prepare_present() -> vulkan_gpu_submission
+	{
+		if (offscreen()) return _offscreen_programs[current_frame_in_flight_index()].prepare_execution();
+
+		// The submission carries no work; its signal is still only done once all earlier work on the queue is.
+		return current_frame_in_flight().draw_manager().prepare_submission(nullptr, current_frame().present_semaphore().vulkan_semaphore());
+	}
+
+	void window_swapchain::mark_presented(std::chrono::nanoseconds present_wait) noexcept
+	{
+		_present_wait_time = present_wait;
+		_acquire_to_present_latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _acquire_time);
 	}
 }
@@ -0,0 +1,92 @@
+#include "private/windows/draw_culler.hpp"
+
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define COMPWOLF_GRAPHICS_DRAW_CULLER_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace compwolf
+{
+	/******************************** modifiers ********************************/
+
+	void draw_culler::clear() noexcept
+	{
+		_min_x.clear();
+		_min_y.clear();
+		_max_x.clear();
+		_max_y.clear();
+		_next = 0;
+	}
+
+	void draw_culler::add(draw_bounds bounds)
+	{
+		_min_x.push_back(bounds.min.x());
+		_min_y.push_back(bounds.min.y());
+		_max_x.push_back(bounds.max.x());
+		_max_y.push_back(bounds.max.y());
+	}
+	void draw_culler::add_unbounded()
+	{
+		constexpr float infinity = std::numeric_limits<float>::infinity();
+		_min_x.push_back(-infinity);
+		_min_y.push_back(-infinity);
+		_max_x.push_back(infinity);
+		_max_y.push_back(infinity);
+	}
+
+	auto draw_culler::cull(draw_bounds camera_bounds) -> draw_cull_stats
+	{
+		auto count = size();
+		_visible.resize(count);
+		_next = 0;
+
+		std::size_t visible_count = 0;
+		std::size_t i = 0;
+
+#ifdef COMPWOLF_GRAPHICS_DRAW_CULLER_SSE
+		auto camera_min_x = _mm_set1_ps(camera_bounds.min.x());
+		auto camera_min_y = _mm_set1_ps(camera_bounds.min.y());
+		auto camera_max_x = _mm_set1_ps(camera_bounds.max.x());
+		auto camera_max_y = _mm_set1_ps(camera_bounds.max.y());
+
+		for (; i + 4 <= count; i += 4)
+		{
+			auto overlaps = _mm_and_ps(
+				_mm_and_ps(
+					_mm_cmple_ps(_mm_loadu_ps(&_min_x[i]), camera_max_x),
+					_mm_cmple_ps(camera_min_x, _mm_loadu_ps(&_max_x[i]))
+				),
+				_mm_and_ps(
+					_mm_cmple_ps(_mm_loadu_ps(&_min_y[i]), camera_max_y),
+					_mm_cmple_ps(camera_min_y, _mm_loadu_ps(&_max_y[i]))
+				)
+			);
+			auto mask = _mm_movemask_ps(overlaps);
+
+			for (std::size_t j = 0; j < 4; ++j)
+			{
+				auto is_visible = static_cast<std::uint8_t>((mask >> j) & 1);
+				_visible[i + j] = is_visible;
+				visible_count += is_visible;
+			}
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			bool is_visible = _min_x[i] <= camera_bounds.max.x() && camera_bounds.min.x() <= _max_x[i]
+				&& _min_y[i] <= camera_bounds.max.y() && camera_bounds.min.y() <= _max_y[i];
+			_visible[i] = static_cast<std::uint8_t>(is_visible);
+			visible_count += is_visible;
+		}
+
+		_stats = draw_cull_stats{
+			.total = count,
+			.visible = visible_count,
+			.culled = count - visible_count,
+		};
+		return _stats;
+	}
+}
@@ -0,0 +1,42 @@
+#include "private/windows/frame_pacer.hpp"
+
+#include <profilers>
+#include <thread>
+
+namespace compwolf
+{
+	/******************************** modifiers ********************************/
+
+	void frame_pacer::set_target_frame_rate(double frames_per_second) noexcept
+	{
+		_frame_duration = frames_per_second > 0.
+			? std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(1. / frames_per_second))
+			: std::chrono::nanoseconds(0);
+		_next_frame = {};
+	}
+
+	auto frame_pacer::schedule(clock::time_point now) noexcept -> std::chrono::nanoseconds
+	{
+		if (_frame_duration.count() == 0) return std::chrono::nanoseconds(0);
+
+		// The first frame, and a frame that is late, starts the schedule over, so that the frames after it are not rushed.
+		if (_next_frame <= now)
+		{
+			_next_frame = now + _frame_duration;
+			return std::chrono::nanoseconds(0);
+		}
+
+		auto wait_time = std::chrono::duration_cast<std::chrono::nanoseconds>(_next_frame - now);
+		_next_frame += _frame_duration;
+		return wait_time;
+	}
+
+	auto frame_pacer::wait() -> std::chrono::nanoseconds
+	{
+		COMPWOLF_PROFILE_ZONE("frame_pacer::wait");
+		auto now = clock::now();
+		_last_wait_time = schedule(now);
+		if (_last_wait_time.count() > 0) std::this_thread::sleep_until(now + _last_wait_time);
+		return _last_wait_time;
+	}
+}
@@ -0,0 +1,108 @@
+#include "private/windows/frame_stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace compwolf
+{
+	namespace
+	{
+		/** Returns the given percentile of the given times, by the nearest-rank method.
+		 * The times are reordered.
+		 */
+		auto percentile(std::vector<std::chrono::nanoseconds>& times, double percent) -> std::chrono::nanoseconds
+		{
+			auto rank = static_cast<std::size_t>(std::ceil(percent / 100. * static_cast<double>(times.size())));
+			auto index = std::clamp<std::size_t>(rank, 1, times.size()) - 1;
+
+			std::nth_element(times.begin(), times.begin() + index, times.end());
+			return times[index];
+		}
+	}
+
+	/******************************** accessors ********************************/
+
+	auto frame_stats::samples(frame_metric metric) const -> std::vector<std::chrono::nanoseconds>
+	{
+		auto& data = _metrics[static_cast<std::size_t>(metric)];
+
+		// Until the buffer is full, next is the end of the samples, so the rotation does nothing.
+		std::vector<std::chrono::nanoseconds> samples(data.samples.size());
+		std::rotate_copy(data.samples.begin(), data.samples.begin() + data.next, data.samples.end(), samples.begin());
+		return samples;
+	}
+
+	auto frame_stats::summary(frame_metric metric) const -> frame_time_summary
+	{
+		auto& data = _metrics[static_cast<std::size_t>(metric)];
+		if (data.samples.empty()) return frame_time_summary{};
+
+		_sorted.assign(data.samples.begin(), data.samples.end());
+
+		std::chrono::nanoseconds total{};
+		for (auto time : _sorted) total += time;
+
+		return frame_time_summary{
+			.samples = _sorted.size(),
+			.mean = total / static_cast<std::chrono::nanoseconds::rep>(_sorted.size()),
+			.p50 = percentile(_sorted, 50.),
+			.p95 = percentile(_sorted, 95.),
+			.p99 = percentile(_sorted, 99.),
+			.max = *std::max_element(_sorted.begin(), _sorted.end()),
+		};
+	}
+
+	auto frame_stats::report() const -> frame_stats_report
+	{
+		return frame_stats_report{
+			.frame_count = _frame_count,
+			.cpu_frame_time = summary(frame_metric::cpu_frame_time),
+			.gpu_frame_time = summary(frame_metric::gpu_frame_time),
+			.acquire_wait = summary(frame_metric::acquire_wait),
+			.present_wait = summary(frame_metric::present_wait),
+			.fence_wait = summary(frame_metric::fence_wait),
+		};
+	}
+
+	/******************************** modifiers ********************************/
+
+	void frame_stats::add(frame_metric metric, std::chrono::nanoseconds time) noexcept
+	{
+		auto& data = _metrics[static_cast<std::size_t>(metric)];
+
+		if (data.samples.size() < _capacity) data.samples.push_back(time);
+		else data.samples[data.next] = time;
+		data.next = (data.next + 1) % _capacity;
+	}
+
+	void frame_stats::end_frame()
+	{
+		++_frame_count;
+
+		if (_report_interval == 0) return;
+		if (++_frames_since_report < _report_interval) return;
+		_frames_since_report = 0;
+
+		_reported.invoke(report());
+	}
+
+	void frame_stats::clear() noexcept
+	{
+		for (auto& data : _metrics)
+		{
+			data.samples.clear();
+			data.next = 0;
+		}
+		_frame_count = 0;
+		_frames_since_report = 0;
+	}
+
+	/******************************** constructors ********************************/
+
+	frame_stats::frame_stats(std::size_t capacity, std::size_t report_interval)
+		: _capacity(capacity > 0 ? capacity : 240)
+		, _report_interval(report_interval)
+	{
+		for (auto& data : _metrics) data.samples.reserve(_capacity);
+	}
+}
@@ -0,0 +1,67 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <windows>
+
+namespace
+{
+	constexpr compwolf::draw_bounds camera_bounds{
+		.min = { -1.f, -1.f },
+		.max = { 1.f, 1.f },
+	};
+	constexpr auto square_at(float x, float y) -> compwolf::draw_bounds
+	{
+		return compwolf::draw_bounds{
+			.min = { x - .1f, y - .1f },
+			.max = { x + .1f, y + .1f },
+		};
+	}
+}
+
+TEST(DrawCuller, cull) {
+	compwolf::draw_culler culler;
+	culler.add(square_at(0.f, 0.f));
+	culler.add(square_at(5.f, 0.f));
+	culler.add(square_at(0.f, -5.f));
+	culler.add(square_at(1.05f, 1.05f));
+	culler.add(square_at(-5.f, -5.f));
+	culler.add_unbounded();
+
+	auto stats = culler.cull(camera_bounds);
+
+	EXPECT_TRUE(culler.visible(0));
+	EXPECT_FALSE(culler.visible(1));
+	EXPECT_FALSE(culler.visible(2));
+	EXPECT_TRUE(culler.visible(3));
+	EXPECT_FALSE(culler.visible(4));
+	EXPECT_TRUE(culler.visible(5));
+
+	EXPECT_EQ(stats.total, std::size_t(6));
+	EXPECT_EQ(stats.visible, std::size_t(3));
+	EXPECT_EQ(stats.culled, std::size_t(3));
+}
+
+TEST(DrawCuller, next_visible) {
+	compwolf::draw_culler culler;
+	for (int i = 0; i < 9; ++i) culler.add(square_at(static_cast<float>(i) - 2.f, 0.f));
+	culler.cull(camera_bounds);
+
+	for (int i = 0; i < 9; ++i)
+	{
+		EXPECT_EQ(culler.next_visible(), i >= 1 && i <= 3);
+	}
+}
+
+TEST(DrawCuller, clear) {
+	compwolf::draw_culler culler;
+	culler.add(square_at(5.f, 5.f));
+	culler.cull(camera_bounds);
+	culler.clear();
+
+	culler.add(square_at(0.f, 0.f));
+	auto stats = culler.cull(camera_bounds);
+
+	EXPECT_EQ(culler.size(), std::size_t(1));
+	EXPECT_TRUE(culler.visible(0));
+	EXPECT_EQ(stats.visible, std::size_t(1));
+}
@@ -0,0 +1,36 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <windows>
+
+using namespace std::chrono_literals;
+
+TEST(FramePacer, unlimited) {
+	compwolf::frame_pacer pacer;
+	auto now = compwolf::frame_pacer::clock::time_point{} + 1s;
+
+	EXPECT_EQ(pacer.schedule(now), 0ns);
+	EXPECT_EQ(pacer.schedule(now), 0ns);
+	EXPECT_EQ(pacer.frame_duration(), 0ns);
+}
+
+TEST(FramePacer, waits_for_next_frame) {
+	compwolf::frame_pacer pacer(100.);
+	auto start = compwolf::frame_pacer::clock::time_point{} + 1s;
+
+	EXPECT_EQ(pacer.frame_duration(), 10ms);
+	EXPECT_EQ(pacer.schedule(start), 0ns);
+	EXPECT_EQ(pacer.schedule(start + 4ms), 6ms);
+	// The schedule does not drift from how long each frame actually took.
+	EXPECT_EQ(pacer.schedule(start + 10ms), 10ms);
+	EXPECT_EQ(pacer.next_frame(), start + 30ms);
+}
+
+TEST(FramePacer, late_frame_restarts_schedule) {
+	compwolf::frame_pacer pacer(100.);
+	auto start = compwolf::frame_pacer::clock::time_point{} + 1s;
+
+	pacer.schedule(start);
+	EXPECT_EQ(pacer.schedule(start + 25ms), 0ns);
+	EXPECT_EQ(pacer.schedule(start + 27ms), 8ms);
+}
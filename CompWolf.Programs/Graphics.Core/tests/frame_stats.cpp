@@ -0,0 +1,86 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <windows>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST(FrameStats, empty) {
+	compwolf::frame_stats stats;
+
+	auto summary = stats.summary(compwolf::frame_metric::cpu_frame_time);
+	EXPECT_EQ(summary.samples, std::size_t(0));
+	EXPECT_EQ(summary.max, 0ns);
+	EXPECT_EQ(stats.capacity(), std::size_t(240));
+}
+
+TEST(FrameStats, percentiles) {
+	compwolf::frame_stats stats(100);
+	for (int i = 1; i <= 100; ++i) stats.add(compwolf::frame_metric::cpu_frame_time, std::chrono::milliseconds(i));
+
+	auto summary = stats.summary(compwolf::frame_metric::cpu_frame_time);
+	EXPECT_EQ(summary.samples, std::size_t(100));
+	EXPECT_EQ(summary.mean, 50500us);
+	EXPECT_EQ(summary.p50, 50ms);
+	EXPECT_EQ(summary.p95, 95ms);
+	EXPECT_EQ(summary.p99, 99ms);
+	EXPECT_EQ(summary.max, 100ms);
+}
+
+TEST(FrameStats, single_stutter_shows_in_p99) {
+	compwolf::frame_stats stats(100);
+	for (int i = 0; i < 99; ++i) stats.add(compwolf::frame_metric::cpu_frame_time, 16ms);
+	stats.add(compwolf::frame_metric::cpu_frame_time, 100ms);
+
+	auto summary = stats.summary(compwolf::frame_metric::cpu_frame_time);
+	EXPECT_EQ(summary.p50, 16ms);
+	EXPECT_EQ(summary.p99, 16ms);
+	EXPECT_EQ(summary.max, 100ms);
+
+	stats.add(compwolf::frame_metric::cpu_frame_time, 100ms);
+	EXPECT_EQ(stats.summary(compwolf::frame_metric::cpu_frame_time).p99, 100ms);
+}
+
+TEST(FrameStats, ring_buffer_keeps_latest) {
+	compwolf::frame_stats stats(3);
+	for (int i = 1; i <= 5; ++i) stats.add(compwolf::frame_metric::fence_wait, std::chrono::milliseconds(i));
+
+	std::vector<std::chrono::nanoseconds> expected{ 3ms, 4ms, 5ms };
+	EXPECT_EQ(stats.samples(compwolf::frame_metric::fence_wait), expected);
+	EXPECT_EQ(stats.summary(compwolf::frame_metric::fence_wait).mean, 4ms);
+	// Other metrics are kept separately.
+	EXPECT_EQ(stats.summary(compwolf::frame_metric::acquire_wait).samples, std::size_t(0));
+}
+
+TEST(FrameStats, reports_every_interval) {
+	compwolf::frame_stats stats(10, 4);
+	std::vector<compwolf::frame_stats_report> reports;
+	auto key = stats.reported().subscribe([&reports](const compwolf::frame_stats_report& report)
+		{
+			reports.push_back(report);
+		}
+	);
+
+	for (int i = 0; i < 10; ++i)
+	{
+		stats.add(compwolf::frame_metric::present_wait, 1ms);
+		stats.end_frame();
+	}
+
+	ASSERT_EQ(reports.size(), std::size_t(2));
+	EXPECT_EQ(reports[0].frame_count, std::size_t(4));
+	EXPECT_EQ(reports[1].frame_count, std::size_t(8));
+	EXPECT_EQ(reports[1].present_wait.samples, std::size_t(8));
+	EXPECT_EQ(reports[1].present_wait.mean, 1ms);
+}
+
+TEST(FrameStats, clear) {
+	compwolf::frame_stats stats(10);
+	stats.add(compwolf::frame_metric::gpu_frame_time, 1ms);
+	stats.end_frame();
+	stats.clear();
+
+	EXPECT_EQ(stats.frame_count(), std::size_t(0));
+	EXPECT_EQ(stats.summary(compwolf::frame_metric::gpu_frame_time).samples, std::size_t(0));
+}
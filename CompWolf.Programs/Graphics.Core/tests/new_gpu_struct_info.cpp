@@ -3,6 +3,10 @@
 #pragma warning(pop)
 #include <gpu_structs>
 #include <dimensions>
+#include <vulkan_graphics>
+#include <simple_drawables>
+#include <cstddef>
+#include <vector>
 
 struct vertex
 {
@@ -48,3 +52,26 @@ TEST(NewGPUStructInfo, composition) {
 
 	EXPECT_EQ((composition_primitives::size), std::size_t(3));
 }
+
+TEST(VulkanPushFieldLayout, fields_are_aligned) {
+	// A float, a float3 and a float2; the float3 is aligned as a float4.
+	static_assert(compwolf::vulkan::internal::vulkan_push_field_layout({ true, true, true }, { 4, 12, 8 }, { 4, 16, 8 })[1] == 16);
+
+	auto layout = compwolf::vulkan::internal::vulkan_push_field_layout({ true, true, true }, { 4, 12, 8 }, { 4, 16, 8 });
+	EXPECT_EQ(layout, (std::vector<std::size_t>{ 0, 16, 32, 40 }));
+}
+
+TEST(VulkanPushFieldLayout, other_fields_take_no_space) {
+	auto layout = compwolf::vulkan::internal::vulkan_push_field_layout({ true, false, true }, { 4, 64, 12 }, { 4, 16, 16 });
+	EXPECT_EQ(layout[0], std::size_t(0));
+	EXPECT_EQ(layout[2], std::size_t(16));
+	EXPECT_EQ(layout.back(), std::size_t(28));
+}
+
+TEST(VulkanPushFieldLayout, simple_brush) {
+	using brush = compwolf::simple_brush<compwolf::vulkan_types>;
+	static_assert(brush::push_field_layout_val() == std::vector<std::size_t>{ 0, 16, 28 });
+
+	// The transform is two float2s, and the color is a float3, which is aligned as a float4.
+	EXPECT_EQ(brush::push_field_layout_val().back(), std::size_t(28));
+}
@@ -0,0 +1,206 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include "vulkan_test_helpers.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace
+{
+	using float_buffer = compwolf::vulkan::vulkan_gpu_buffer<compwolf::gpu_buffer_usage::field, float>;
+
+	using multiply_shader = compwolf::vulkan::vulkan_compute_shader<
+		compwolf::type_value_pair<compwolf::shader_storage_field<float>, 0>,
+		compwolf::type_value_pair<compwolf::shader_push_field<float>, 1>,
+		compwolf::type_value_pair<compwolf::shader_push_field<compwolf::shader_int>, 2>
+	>;
+	using multiply_program = compwolf::vulkan::vulkan_compute_program<multiply_shader>;
+
+	constexpr const char multiply_shader_path[] = "resources/CompWolf.Graphics.multiply_values.spv";
+}
+
+TEST(VulkanBarrierBatch, first_use_needs_no_barrier) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	float_buffer buffer(manager.gpu(), 4);
+
+	std::size_t pending_count = 1;
+	compwolf::vulkan::vulkan_gpu_program program(manager, [&](const compwolf::vulkan::vulkan_code_parameters& args)
+		{
+			args.barriers->use(buffer.vulkan_buffer(), compwolf::vulkan::vulkan_resource_access::compute_shader_write);
+			pending_count = args.barriers->pending().size();
+		}
+	);
+
+	EXPECT_EQ(pending_count, std::size_t(0));
+}
+
+TEST(VulkanBarrierBatch, read_after_write_waits_for_the_write) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	float_buffer buffer(manager.gpu(), 4);
+
+	std::vector<compwolf::vulkan::vulkan_pending_barrier> pending;
+	compwolf::vulkan::vulkan_gpu_program program(manager, [&](const compwolf::vulkan::vulkan_code_parameters& args)
+		{
+			args.barriers->use(buffer.vulkan_buffer(), compwolf::vulkan::vulkan_resource_access::compute_shader_write);
+			args.barriers->flush();
+			args.barriers->use(buffer.vulkan_buffer(), compwolf::vulkan::vulkan_resource_access::host_read);
+			pending = args.barriers->pending();
+		}
+	);
+
+	auto write = compwolf::vulkan::vulkan_access_info(compwolf::vulkan::vulkan_resource_access::compute_shader_write);
+	auto read = compwolf::vulkan::vulkan_access_info(compwolf::vulkan::vulkan_resource_access::host_read);
+	ASSERT_EQ(pending.size(), std::size_t(1));
+	EXPECT_EQ(pending[0].buffer, buffer.vulkan_buffer());
+	EXPECT_EQ(pending[0].src_stages, write.stages);
+	EXPECT_EQ(pending[0].src_access, write.access);
+	EXPECT_EQ(pending[0].dst_stages, read.stages);
+	EXPECT_EQ(pending[0].dst_access, read.access);
+}
+
+TEST(VulkanBarrierBatch, repeated_reads_wait_once) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	float_buffer buffer(manager.gpu(), 4);
+
+	compwolf::vulkan::vulkan_barrier_batch_stats stats{};
+	compwolf::vulkan::vulkan_gpu_program program(manager, [&](const compwolf::vulkan::vulkan_code_parameters& args)
+		{
+			args.barriers->use(buffer.vulkan_buffer(), compwolf::vulkan::vulkan_resource_access::compute_shader_write);
+			args.barriers->flush();
+			for (int i = 0; i < 3; ++i)
+			{
+				args.barriers->use(buffer.vulkan_buffer(), compwolf::vulkan::vulkan_resource_access::indirect_read);
+				args.barriers->flush();
+			}
+			stats = args.barriers->stats();
+		}
+	);
+
+	EXPECT_EQ(stats.barriers, std::size_t(1));
+	EXPECT_EQ(stats.calls, std::size_t(1));
+}
+
+TEST(VulkanBarrierBatch, write_after_read_waits_for_the_read) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	float_buffer buffer(manager.gpu(), 4);
+
+	std::vector<compwolf::vulkan::vulkan_pending_barrier> pending;
+	compwolf::vulkan::vulkan_gpu_program program(manager, [&](const compwolf::vulkan::vulkan_code_parameters& args)
+		{
+			args.barriers->use(buffer.vulkan_buffer(), compwolf::vulkan::vulkan_resource_access::copy_read);
+			args.barriers->flush();
+			args.barriers->use(buffer.vulkan_buffer(), compwolf::vulkan::vulkan_resource_access::compute_shader_write);
+			pending = args.barriers->pending();
+		}
+	);
+
+	// Nothing was written before, so there is nothing to make visible; the write only has to wait for the read to finish.
+	ASSERT_EQ(pending.size(), std::size_t(1));
+	EXPECT_EQ(pending[0].src_stages, compwolf::vulkan::vulkan_access_info(compwolf::vulkan::vulkan_resource_access::copy_read).stages);
+	EXPECT_EQ(pending[0].src_access, compwolf::vulkan::vulkan_handle::access_flags(0));
+}
+
+TEST(VulkanBarrierBatch, barriers_are_recorded_together) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	float_buffer first(manager.gpu(), 4);
+	float_buffer second(manager.gpu(), 4);
+
+	compwolf::vulkan::vulkan_barrier_batch_stats stats{};
+	compwolf::vulkan::vulkan_gpu_program program(manager, [&](const compwolf::vulkan::vulkan_code_parameters& args)
+		{
+			args.barriers->use(first.vulkan_buffer(), compwolf::vulkan::vulkan_resource_access::copy_write);
+			args.barriers->use(second.vulkan_buffer(), compwolf::vulkan::vulkan_resource_access::copy_write);
+			args.barriers->flush();
+			args.barriers->use(first.vulkan_buffer(), compwolf::vulkan::vulkan_resource_access::vertex_read);
+			args.barriers->use(second.vulkan_buffer(), compwolf::vulkan::vulkan_resource_access::vertex_read);
+			args.barriers->use(second.vulkan_buffer(), compwolf::vulkan::vulkan_resource_access::index_read);
+			args.barriers->flush();
+			stats = args.barriers->stats();
+		}
+	);
+
+	// The two reads of the second buffer share one barrier.
+	EXPECT_EQ(stats.barriers, std::size_t(2));
+	EXPECT_EQ(stats.calls, std::size_t(1));
+}
+
+TEST(VulkanBarrierBatch, changes_image_layouts) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::offscreen_target target(environment, compwolf::vulkan::offscreen_target_settings{
+		.pixel_size = { 4, 4 },
+	});
+	auto image = target.swapchain().frames().front().swapchain_image();
+
+	std::vector<compwolf::vulkan::vulkan_pending_barrier> discarded;
+	std::vector<compwolf::vulkan::vulkan_pending_barrier> kept;
+	compwolf::vulkan::vulkan_gpu_program program(manager, [&](const compwolf::vulkan::vulkan_code_parameters& args)
+		{
+			args.barriers->use(image, compwolf::vulkan::vulkan_resource_access::color_attachment_write, true);
+			discarded = args.barriers->pending();
+			args.barriers->flush();
+			args.barriers->use(image, compwolf::vulkan::vulkan_resource_access::copy_read);
+			kept = args.barriers->pending();
+		}
+	);
+
+	auto draw = compwolf::vulkan::vulkan_access_info(compwolf::vulkan::vulkan_resource_access::color_attachment_write);
+	auto copy = compwolf::vulkan::vulkan_access_info(compwolf::vulkan::vulkan_resource_access::copy_read);
+	ASSERT_EQ(discarded.size(), std::size_t(1));
+	EXPECT_EQ(discarded[0].image, image);
+	EXPECT_EQ(discarded[0].old_layout, compwolf::vulkan::vulkan_resource_state{}.layout);
+	EXPECT_EQ(discarded[0].new_layout, draw.layout);
+	ASSERT_EQ(kept.size(), std::size_t(1));
+	EXPECT_EQ(kept[0].old_layout, draw.layout);
+	EXPECT_EQ(kept[0].new_layout, copy.layout);
+	EXPECT_EQ(kept[0].src_access, draw.access);
+}
+
+TEST(VulkanBarrierBatch, no_synchronization_hazards) {
+	std::vector<std::string> hazards;
+	auto settings = compwolf::vulkan::tests::headless_settings();
+	settings.synchronization_validation = true;
+	settings.internal_debug_callback = [&hazards](std::string_view message)
+		{
+			if (message.find("SYNC-HAZARD") != std::string_view::npos) hazards.emplace_back(message);
+		};
+	compwolf::vulkan::vulkan_graphics_environment environment(settings);
+
+	{
+		auto manager = compwolf::vulkan::tests::new_manager(environment, compwolf::gpu_work_type::compute);
+		auto& gpu = manager.gpu();
+
+		constexpr compwolf::shader_int count = 64;
+		multiply_shader shader(gpu, compwolf::shader_code_from_file(multiply_shader_path));
+		multiply_program::field_buffer_type<compwolf::shader_storage_field<float>> values(gpu, count);
+		multiply_program::field_buffer_type<compwolf::shader_push_field<float>> factor(gpu, 1);
+		multiply_program::field_buffer_type<compwolf::shader_push_field<compwolf::shader_int>> value_count(gpu, 1);
+		factor.data()[0] = 2.f;
+		value_count.data()[0] = count;
+
+		multiply_program program(manager, shader, values, factor, value_count);
+		program.set_group_count(1);
+		program.execute();
+		program.execute().wait();
+	}
+
+	{
+		compwolf::vulkan::offscreen_target target(environment, compwolf::vulkan::offscreen_target_settings{
+			.pixel_size = { 16, 8 },
+			.readback = true,
+		});
+		compwolf::vulkan::vulkan_camera camera(target, compwolf::window_camera_settings{});
+
+		for (int i = 0; i < 3; ++i) target.update_image();
+		EXPECT_FALSE(target.read_image().empty());
+	}
+
+	EXPECT_TRUE(hazards.empty()) << (hazards.empty() ? std::string() : hazards.front());
+}
@@ -0,0 +1,67 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include "vulkan_test_helpers.hpp"
+#include <simple_drawables>
+#include <cstddef>
+
+TEST(VulkanBrush, pipeline_is_created_in_the_background) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	compwolf::vulkan::offscreen_target target(environment, compwolf::vulkan::offscreen_target_settings{
+		.pixel_size = { 16, 16 },
+	});
+	compwolf::vulkan::vulkan_camera camera(target, compwolf::window_camera_settings{});
+	auto created_before = target.gpu().pipeline_cache().stats().pipelines_created;
+
+	compwolf::simple_brush<compwolf::vulkan_types> brush(camera);
+
+	// The pipeline may or may not be done already, but the brush never gives a pipeline that is not.
+	if (!brush.pipeline_ready(target))
+	{
+		EXPECT_EQ(brush.vulkan_pipeline(target), nullptr);
+	}
+
+	brush.wait_for_pipeline(target);
+	EXPECT_TRUE(brush.pipeline_ready(target));
+	EXPECT_NE(brush.vulkan_pipeline(target), nullptr);
+	EXPECT_GT(target.gpu().pipeline_cache().stats().pipelines_created, created_before);
+}
+
+TEST(VulkanBrush, drawing_does_not_wait_for_the_pipeline) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	compwolf::vulkan::offscreen_target target(environment, compwolf::vulkan::offscreen_target_settings{
+		.pixel_size = { 16, 16 },
+	});
+	compwolf::vulkan::vulkan_camera camera(target, compwolf::window_camera_settings{});
+	compwolf::simple_brush<compwolf::vulkan_types> brush(camera);
+	compwolf::simple_square<compwolf::vulkan_types> square(camera, brush);
+
+	// Frames drawn before the pipeline is ready skip the drawable instead of failing.
+	target.update_image();
+	brush.wait_for_pipeline(target);
+	target.update_image();
+	target.swapchain().current_frame_in_flight().draw_manager().wait();
+}
+
+TEST(VulkanBrush, targets_share_the_pipeline) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	compwolf::vulkan::offscreen_target first(environment, compwolf::vulkan::offscreen_target_settings{
+		.pixel_size = { 16, 16 },
+	});
+	compwolf::vulkan::offscreen_target second(environment, compwolf::vulkan::offscreen_target_settings{
+		.pixel_size = { 32, 8 },
+	});
+	auto& gpu = first.gpu();
+	compwolf::simple_brush<compwolf::vulkan_types> brush(gpu);
+	auto created_before = gpu.pipeline_cache().stats().pipelines_created;
+
+	brush.prepare(first);
+	brush.prepare(second);
+	brush.wait_for_pipeline(first);
+	brush.wait_for_pipeline(second);
+
+	// The targets have the same format, so they share a render pass, and so the brush's pipeline, even though their sizes differ.
+	EXPECT_EQ(brush.vulkan_pipeline(first), brush.vulkan_pipeline(second));
+	EXPECT_EQ(gpu.pipeline_cache().stats().pipelines_created, created_before + 1);
+}
@@ -0,0 +1,81 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include "vulkan_test_helpers.hpp"
+#include <simple_drawables>
+#include <cstddef>
+
+TEST(VulkanCamera, records_only_when_changed) {
+	constexpr std::size_t frame_count = 8;
+
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	compwolf::vulkan::offscreen_target target(environment, compwolf::vulkan::offscreen_target_settings{
+		.pixel_size = { 16, 16 },
+	});
+	compwolf::vulkan::vulkan_camera camera(target, compwolf::window_camera_settings{});
+	compwolf::simple_brush<compwolf::vulkan_types> brush(camera);
+	brush.wait_for_pipeline(target);
+	compwolf::simple_square<compwolf::vulkan_types> square(camera, brush
+		, compwolf::simple_transform_data
+		{
+			.position = { .0f, .0f },
+			.scale = { .25f, .25f },
+		}
+	);
+
+	// Each frame in flight records its instructions once, after which they are reused.
+	for (std::size_t i = 0; i < frame_count; ++i) target.update_image();
+	auto record_count = camera.record_count();
+	EXPECT_EQ(record_count, target.swapchain().frames_in_flight().size());
+
+	for (std::size_t i = 0; i < frame_count; ++i) target.update_image();
+	EXPECT_EQ(camera.record_count(), record_count);
+
+	// Reading a push field does not change it.
+	EXPECT_EQ(square.transform().data()[0].position[0], .0f);
+	target.update_image();
+	EXPECT_EQ(camera.record_count(), record_count);
+
+	square.transform().data()[0].position = { .5f, .0f };
+	target.update_image();
+	EXPECT_EQ(camera.record_count(), record_count + 1);
+
+	camera.mark_changed();
+	target.update_image();
+	EXPECT_EQ(camera.record_count(), record_count + 2);
+}
+
+TEST(VulkanCamera, reused_instructions_draw_changed_push_fields) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	compwolf::vulkan::offscreen_target target(environment, compwolf::vulkan::offscreen_target_settings{
+		.pixel_size = { 8, 8 },
+		.frames_in_flight = 1,
+		.readback = true,
+	});
+	compwolf::vulkan::vulkan_camera camera(target, compwolf::window_camera_settings{});
+	compwolf::simple_brush<compwolf::vulkan_types> brush(camera);
+	brush.wait_for_pipeline(target);
+	compwolf::simple_square<compwolf::vulkan_types> square(camera, brush
+		, compwolf::simple_transform_data
+		{
+			.position = { .0f, .0f },
+			.scale = { 1.f, 1.f },
+		}
+		, { 1.f, 0.f, 0.f }
+	);
+
+	target.update_image();
+	target.update_image();
+	auto pixels = target.read_image();
+	ASSERT_FALSE(pixels.empty());
+	EXPECT_EQ(pixels[0], std::byte(255));
+	EXPECT_EQ(pixels[1], std::byte(0));
+
+	square.color().data()[0] = { 0.f, 1.f, 0.f };
+	target.update_image();
+	pixels = target.read_image();
+	ASSERT_FALSE(pixels.empty());
+	EXPECT_EQ(pixels[0], std::byte(0));
+	EXPECT_EQ(pixels[1], std::byte(255));
+}
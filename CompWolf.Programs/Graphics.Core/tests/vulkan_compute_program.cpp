@@ -0,0 +1,73 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include "vulkan_test_helpers.hpp"
+#include <vector>
+
+namespace
+{
+	using multiply_shader = compwolf::vulkan::vulkan_compute_shader<
+		compwolf::type_value_pair<compwolf::shader_storage_field<float>, 0>,
+		compwolf::type_value_pair<compwolf::shader_push_field<float>, 1>,
+		compwolf::type_value_pair<compwolf::shader_push_field<compwolf::shader_int>, 2>
+	>;
+	using multiply_program = compwolf::vulkan::vulkan_compute_program<multiply_shader>;
+
+	constexpr const char multiply_shader_path[] = "resources/CompWolf.Graphics.multiply_values.spv";
+	constexpr compwolf::shader_int multiply_group_size = 64;
+}
+
+TEST(VulkanComputeProgram, multiplies_values) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment, compwolf::gpu_work_type::compute);
+	auto& gpu = manager.gpu();
+
+	constexpr compwolf::shader_int count = 100;
+	multiply_shader shader(gpu, compwolf::shader_code_from_file(multiply_shader_path));
+	multiply_program::field_buffer_type<compwolf::shader_storage_field<float>> values(gpu, count);
+	multiply_program::field_buffer_type<compwolf::shader_push_field<float>> factor(gpu, 1);
+	multiply_program::field_buffer_type<compwolf::shader_push_field<compwolf::shader_int>> value_count(gpu, 1);
+	{
+		auto data = values.data();
+		for (compwolf::shader_int i = 0; i < count; ++i) data[i] = static_cast<float>(i);
+	}
+	factor.data()[0] = 2.f;
+	value_count.data()[0] = count;
+
+	multiply_program program(manager, shader, values, factor, value_count);
+	program.set_group_count((count + multiply_group_size - 1) / multiply_group_size);
+	program.execute().wait();
+
+	auto data = values.data();
+	for (compwolf::shader_int i = 0; i < count; ++i) EXPECT_EQ(data[i], static_cast<float>(2 * i));
+}
+
+TEST(VulkanComputeProgram, uses_latest_push_fields) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment, compwolf::gpu_work_type::compute);
+	auto& gpu = manager.gpu();
+
+	constexpr compwolf::shader_int count = 10;
+	multiply_shader shader(gpu, compwolf::shader_code_from_file(multiply_shader_path));
+	multiply_program::field_buffer_type<compwolf::shader_storage_field<float>> values(gpu, count);
+	multiply_program::field_buffer_type<compwolf::shader_push_field<float>> factor(gpu, 1);
+	multiply_program::field_buffer_type<compwolf::shader_push_field<compwolf::shader_int>> value_count(gpu, 1);
+	{
+		auto data = values.data();
+		for (compwolf::shader_int i = 0; i < count; ++i) data[i] = 1.f;
+	}
+	value_count.data()[0] = count;
+
+	multiply_program program(manager, shader, values, factor, value_count);
+
+	factor.data()[0] = 2.f;
+	program.execute();
+	factor.data()[0] = 3.f;
+	auto submission = program.prepare_execution();
+	compwolf::vulkan::submit_programs(std::span(&submission, 1));
+	program.last_fence().wait();
+
+	auto data = values.data();
+	for (compwolf::shader_int i = 0; i < count; ++i) EXPECT_EQ(data[i], 6.f);
+}
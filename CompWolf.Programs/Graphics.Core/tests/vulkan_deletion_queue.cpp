@@ -0,0 +1,50 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include "vulkan_test_helpers.hpp"
+#include <vector>
+
+TEST(VulkanDeletionQueue, deletes_right_away_when_gpu_is_done) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	auto& queue = manager.gpu().deletion_queue();
+
+	bool deleted = false;
+	queue.defer([&deleted]() { deleted = true; });
+	EXPECT_TRUE(deleted);
+	EXPECT_EQ(queue.pending_count(), std::size_t(0));
+}
+
+TEST(VulkanDeletionQueue, deletes_after_work_is_done) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	auto& queue = manager.gpu().deletion_queue();
+	compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	std::vector<int> deleted;
+	program.execute();
+	queue.defer([&deleted]() { deleted.push_back(1); });
+	queue.defer([&deleted]() { deleted.push_back(2); });
+
+	manager.wait();
+	environment.update();
+	EXPECT_EQ(deleted, (std::vector<int>{ 1, 2 }));
+	EXPECT_EQ(queue.pending_count(), std::size_t(0));
+}
+
+TEST(VulkanDeletionQueue, flush_deletes_everything) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	auto& queue = manager.gpu().deletion_queue();
+	compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	bool deleted = false;
+	program.execute();
+	queue.defer([&deleted]() { deleted = true; });
+
+	queue.flush();
+	EXPECT_TRUE(deleted);
+	EXPECT_EQ(queue.pending_count(), std::size_t(0));
+	EXPECT_FALSE(manager.working());
+}
@@ -0,0 +1,173 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include "vulkan_test_helpers.hpp"
+#include <simple_drawables>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace
+{
+	using shape = compwolf::simple_shape<compwolf::vulkan_types>;
+
+	/** Drawables sharing all of their buffers, so that they only differ in where they are said to be. */
+	struct shared_shape_data
+	{
+		shape::vertex_buffer_type vertices;
+		shape::vertex_index_buffer_type indices;
+		shape::transform_buffer_type transform;
+		shape::color_buffer_type color;
+
+		explicit shared_shape_data(compwolf::vulkan::vulkan_gpu_connection& gpu)
+			: vertices(gpu, 3), indices(gpu, 3), transform(gpu, 1), color(gpu, 1)
+		{
+			auto v = vertices.data();
+			v[0] = { -1.f, -1.f };
+			v[1] = { 1.f, -1.f };
+			v[2] = { 0.f, 1.f };
+			auto i = indices.data();
+			i[0] = 0;
+			i[1] = 1;
+			i[2] = 2;
+		}
+	};
+
+	auto new_drawable(compwolf::vulkan::vulkan_camera& camera, compwolf::simple_brush<compwolf::vulkan_types>& brush
+		, shared_shape_data& data, float x
+	) -> std::unique_ptr<shape::drawable_type>
+	{
+		auto drawable = std::make_unique<shape::drawable_type>(camera, brush, data.vertices, data.indices, data.transform, data.color);
+		drawable->set_bounds([x]()
+			{
+				return compwolf::draw_bounds{
+					.min = { x - .1f, -.1f },
+					.max = { x + .1f, .1f },
+				};
+			}
+		);
+		return drawable;
+	}
+}
+
+TEST(VulkanDrawCulling, gpu_counts_visible_drawables) {
+	std::vector<std::string> errors;
+	auto settings = compwolf::vulkan::tests::headless_settings();
+	settings.internal_debug_callback = [&errors](std::string_view message)
+		{
+			if (message.find("Validation Error") != std::string_view::npos) errors.emplace_back(message);
+		};
+	compwolf::vulkan::vulkan_graphics_environment environment(settings);
+
+	{
+		compwolf::vulkan::offscreen_target target(environment, compwolf::vulkan::offscreen_target_settings{
+			.pixel_size = { 16, 16 },
+		});
+		if (!target.gpu().supports_draw_indirect_first_instance()) GTEST_SKIP() << "The gpu cannot cull drawables, as it cannot draw indirectly with a first instance.";
+		compwolf::vulkan::vulkan_camera camera(target, compwolf::window_camera_settings{
+			.gpu_culling = true,
+		});
+		compwolf::simple_brush<compwolf::vulkan_types> brush(camera);
+		shared_shape_data data(target.gpu());
+
+		std::vector<std::unique_ptr<shape::drawable_type>> drawables;
+		for (float x : { 0.f, 5.f, .5f, -5.f, -.5f }) drawables.push_back(new_drawable(camera, brush, data, x));
+		brush.wait_for_pipeline(target);
+
+		target.update_image();
+		target.swapchain().current_frame_in_flight().draw_manager().wait();
+
+		auto& culling = camera.frame_culling(target.swapchain().current_frame_in_flight_index());
+		auto stats = culling.stats();
+		EXPECT_EQ(stats.total, std::size_t(5));
+		EXPECT_EQ(stats.visible, std::size_t(3));
+		EXPECT_EQ(stats.culled, std::size_t(2));
+
+		// The drawables have the same state, so the gpu draws all of them with a single draw if it can.
+		auto& gpu = target.gpu();
+		auto expected_draws = (gpu.supports_draw_indirect_count() && gpu.max_draw_indirect_count() > 1)
+			? std::size_t(1)
+			: drawables.size();
+		EXPECT_EQ(culling.indirect_draw_count(), expected_draws);
+	}
+
+	EXPECT_TRUE(errors.empty()) << (errors.empty() ? std::string() : errors.front());
+}
+
+TEST(VulkanDrawCulling, drawables_with_different_state_are_drawn_separately) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	compwolf::vulkan::offscreen_target target(environment, compwolf::vulkan::offscreen_target_settings{
+		.pixel_size = { 16, 16 },
+	});
+	if (!target.gpu().supports_draw_indirect_first_instance()) GTEST_SKIP() << "The gpu cannot cull drawables, as it cannot draw indirectly with a first instance.";
+	compwolf::vulkan::vulkan_camera camera(target, compwolf::window_camera_settings{
+		.gpu_culling = true,
+	});
+	compwolf::simple_brush<compwolf::vulkan_types> brush(camera);
+	shared_shape_data first_data(target.gpu());
+	shared_shape_data second_data(target.gpu());
+
+	std::vector<std::unique_ptr<shape::drawable_type>> drawables;
+	drawables.push_back(new_drawable(camera, brush, first_data, 0.f));
+	drawables.push_back(new_drawable(camera, brush, first_data, .5f));
+	drawables.push_back(new_drawable(camera, brush, second_data, 5.f));
+	drawables.push_back(new_drawable(camera, brush, first_data, -.5f));
+	brush.wait_for_pipeline(target);
+
+	target.update_image();
+	target.swapchain().current_frame_in_flight().draw_manager().wait();
+
+	auto& culling = camera.frame_culling(target.swapchain().current_frame_in_flight_index());
+	EXPECT_EQ(culling.stats().visible, std::size_t(3));
+
+	// The last drawable has the same state as the first ones, but is drawn after a drawable with a different state.
+	auto& gpu = target.gpu();
+	auto expected_draws = (gpu.supports_draw_indirect_count() && gpu.max_draw_indirect_count() > 1)
+		? std::size_t(3)
+		: drawables.size();
+	EXPECT_EQ(culling.indirect_draw_count(), expected_draws);
+}
+
+TEST(VulkanDrawCulling, shapes_with_different_push_fields_are_drawn_together) {
+	constexpr std::size_t shape_count = 16;
+
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	compwolf::vulkan::offscreen_target target(environment, compwolf::vulkan::offscreen_target_settings{
+		.pixel_size = { 16, 16 },
+	});
+	if (!target.gpu().supports_draw_indirect_first_instance()) GTEST_SKIP() << "The gpu cannot cull drawables, as it cannot draw indirectly with a first instance.";
+	compwolf::vulkan::vulkan_camera camera(target, compwolf::window_camera_settings{
+		.gpu_culling = true,
+	});
+	compwolf::simple_brush<compwolf::vulkan_types> brush(camera);
+
+	// Each square has its own transform and color, which are read from the camera's draw fields instead of being part of its state.
+	std::vector<std::unique_ptr<compwolf::simple_square<compwolf::vulkan_types>>> squares;
+	for (std::size_t i = 0; i < shape_count; ++i)
+	{
+		auto offset = static_cast<float>(i) / shape_count;
+		squares.push_back(std::make_unique<compwolf::simple_square<compwolf::vulkan_types>>(camera, brush
+			, compwolf::simple_transform_data
+			{
+				.position = { offset - .5f, .0f },
+				.scale = { .05f, .05f },
+			}
+			, compwolf::float3{ offset, 1.f - offset, .0f }
+		));
+	}
+	brush.wait_for_pipeline(target);
+
+	target.update_image();
+	target.swapchain().current_frame_in_flight().draw_manager().wait();
+
+	auto& culling = camera.frame_culling(target.swapchain().current_frame_in_flight_index());
+	EXPECT_EQ(culling.stats().visible, shape_count);
+
+	auto& gpu = target.gpu();
+	auto expected_draws = (gpu.supports_draw_indirect_count() && gpu.max_draw_indirect_count() > 1)
+		? std::size_t(1)
+		: shape_count;
+	EXPECT_EQ(culling.indirect_draw_count(), expected_draws);
+}
@@ -0,0 +1,74 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include <simple_drawables>
+#include <chrono>
+#include <string>
+
+namespace
+{
+	/** What it took to set up a window that can be drawn on with a brush. */
+	struct window_setup_result
+	{
+		bool used_dynamic_rendering;
+		std::chrono::nanoseconds creation_time;
+		/** The amount of render passes and frame buffers created for the window. */
+		std::size_t render_objects;
+	};
+
+	auto set_up_window(bool dynamic_rendering) -> window_setup_result
+	{
+		compwolf::vulkan::vulkan_graphics_environment_settings settings{};
+		settings.dynamic_rendering = dynamic_rendering;
+		compwolf::vulkan::vulkan_graphics_environment environment(settings);
+
+		auto start_time = std::chrono::steady_clock::now();
+
+		compwolf::vulkan::vulkan_window window(environment, compwolf::window_settings{
+			.name = "Dynamic rendering test",
+			.pixel_size = { 64, 64 },
+		});
+		compwolf::vulkan::vulkan_camera camera(window, compwolf::window_camera_settings{});
+		compwolf::simple_brush<compwolf::vulkan_types> brush(camera);
+		brush.wait_for_pipeline(window);
+
+		auto creation_time = std::chrono::steady_clock::now() - start_time;
+
+		std::size_t render_objects = window.surface().vulkan_render_pass() ? 1 : 0;
+		for (auto& frame : window.swapchain().frames())
+		{
+			if (frame.frame_buffer()) ++render_objects;
+		}
+
+		return window_setup_result{
+			.used_dynamic_rendering = window.gpu().uses_dynamic_rendering(),
+			.creation_time = std::chrono::duration_cast<std::chrono::nanoseconds>(creation_time),
+			.render_objects = render_objects,
+		};
+	}
+}
+
+TEST(VulkanDynamicRendering, render_pass_path) {
+	auto result = set_up_window(false);
+
+	EXPECT_FALSE(result.used_dynamic_rendering);
+	EXPECT_GT(result.render_objects, std::size_t(1));
+	testing::Test::RecordProperty("creation_time_ns", std::to_string(result.creation_time.count()));
+}
+TEST(VulkanDynamicRendering, dynamic_rendering_path) {
+	auto result = set_up_window(true);
+	if (!result.used_dynamic_rendering) GTEST_SKIP() << "The gpu does not support dynamic rendering.";
+
+	EXPECT_EQ(result.render_objects, std::size_t(0));
+	testing::Test::RecordProperty("creation_time_ns", std::to_string(result.creation_time.count()));
+}
+TEST(VulkanDynamicRendering, compared_to_render_pass_path) {
+	auto render_pass_result = set_up_window(false);
+	auto dynamic_result = set_up_window(true);
+	if (!dynamic_result.used_dynamic_rendering) GTEST_SKIP() << "The gpu does not support dynamic rendering.";
+
+	EXPECT_LT(dynamic_result.render_objects, render_pass_result.render_objects);
+	testing::Test::RecordProperty("render_pass_creation_time_ns", std::to_string(render_pass_result.creation_time.count()));
+	testing::Test::RecordProperty("dynamic_rendering_creation_time_ns", std::to_string(dynamic_result.creation_time.count()));
+}
@@ -0,0 +1,186 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include "vulkan_test_helpers.hpp"
+#include <array>
+#include <chrono>
+#include <stdexcept>
+
+namespace
+{
+	auto run_twice(compwolf::vulkan::vulkan_gpu_program& program, int& steps) -> compwolf::gpu_task
+	{
+		co_await program.execute();
+		++steps;
+		co_await program.execute();
+		++steps;
+	}
+
+	auto run_and_throw(compwolf::vulkan::vulkan_gpu_program& program) -> compwolf::gpu_task
+	{
+		co_await program.execute();
+		throw std::runtime_error("failed");
+	}
+
+	auto await_other(compwolf::gpu_task& other, bool& resumed) -> compwolf::gpu_task
+	{
+		co_await other;
+		resumed = true;
+	}
+
+	void update_until_done(compwolf::vulkan::vulkan_graphics_environment& environment, compwolf::vulkan::vulkan_gpu_program_manager& manager, const compwolf::gpu_task& task)
+	{
+		while (!task.done())
+		{
+			manager.wait();
+			environment.update();
+		}
+	}
+}
+
+TEST(VulkanFenceReactor, calls_function_once_work_is_done) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	bool called = false;
+	program.execute().when_done([&called]() { called = true; });
+	EXPECT_FALSE(called);
+
+	manager.wait();
+	environment.update();
+	EXPECT_TRUE(called);
+	EXPECT_EQ(manager.gpu().fence_reactor().pending_count(), std::size_t(0));
+}
+
+TEST(VulkanFenceReactor, resumes_coroutines) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	int steps = 0;
+	auto task = run_twice(program, steps);
+	update_until_done(environment, manager, task);
+
+	EXPECT_EQ(steps, 2);
+	task.rethrow_if_failed();
+}
+
+TEST(VulkanFenceReactor, tasks_keep_exceptions) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	auto task = run_and_throw(program);
+	update_until_done(environment, manager, task);
+
+	EXPECT_THROW(task.rethrow_if_failed(), std::runtime_error);
+}
+
+TEST(VulkanFenceReactor, tasks_can_await_tasks) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	int steps = 0;
+	bool resumed = false;
+	auto inner = run_twice(program, steps);
+	auto outer = await_other(inner, resumed);
+	EXPECT_FALSE(resumed);
+
+	update_until_done(environment, manager, outer);
+	EXPECT_EQ(steps, 2);
+	EXPECT_TRUE(resumed);
+}
+
+TEST(VulkanFenceReactor, destroyed_tasks_keep_running) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	int steps = 0;
+	run_twice(program, steps);
+	while (steps < 2)
+	{
+		manager.wait();
+		environment.update();
+	}
+	EXPECT_EQ(manager.gpu().fence_reactor().pending_count(), std::size_t(0));
+}
+
+TEST(VulkanFenceReactor, queries_each_timeline_once) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	auto& reactor = manager.gpu().fence_reactor();
+
+	int called = 0;
+	for (int i = 0; i < 100; ++i)
+	{
+		auto submission = manager.prepare_submission(nullptr);
+		compwolf::vulkan::submit_programs(std::span(&submission, 1));
+		manager.latest_fence().when_done([&called]() { ++called; });
+	}
+	manager.wait();
+
+	EXPECT_EQ(reactor.poll(), std::size_t(100));
+	EXPECT_EQ(called, 100);
+	EXPECT_EQ(reactor.stats().queries, std::size_t(1));
+	EXPECT_EQ(reactor.stats().callbacks, std::size_t(100));
+	EXPECT_EQ(reactor.stats().pending, std::size_t(0));
+}
+
+TEST(VulkanFenceReactor, waits_for_any_work) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto first_manager = compwolf::vulkan::tests::new_manager(environment);
+	auto second_manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program first(first_manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+	compwolf::vulkan::vulkan_gpu_program second(second_manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+	auto& reactor = first_manager.gpu().fence_reactor();
+
+	int called = 0;
+	first.execute().when_done([&called]() { ++called; });
+	second.execute().when_done([&called]() { ++called; });
+
+	while (called < 2) reactor.wait_any(std::chrono::seconds(1));
+	EXPECT_EQ(reactor.pending_count(), std::size_t(0));
+	EXPECT_EQ(reactor.wait_any(std::chrono::seconds(1)), std::size_t(0));
+}
+
+TEST(VulkanFenceReactor, waits_for_many_fences_at_once) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto first_manager = compwolf::vulkan::tests::new_manager(environment);
+	auto second_manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program first(first_manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+	compwolf::vulkan::vulkan_gpu_program second(second_manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	auto& first_fence = first.execute();
+	auto& second_fence = second.execute();
+	std::array<const compwolf::vulkan::vulkan_gpu_fence*, 2> fences{ &first_fence, &second_fence };
+
+	EXPECT_TRUE(compwolf::vulkan::wait_for_fences(fences, true, std::chrono::seconds(5)));
+	EXPECT_TRUE(first_fence.completed());
+	EXPECT_TRUE(second_fence.completed());
+	EXPECT_TRUE(compwolf::vulkan::wait_for_fences(fences, false, std::chrono::nanoseconds(0)));
+	EXPECT_TRUE(first_fence.wait_for(std::chrono::nanoseconds(0)));
+}
+
+TEST(VulkanFenceReactor, waits_after_last_function_throws) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto first_manager = compwolf::vulkan::tests::new_manager(environment);
+	auto second_manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program first(first_manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+	auto& reactor = first_manager.gpu().fence_reactor();
+
+	// A function on another timeline, whose work is never done.
+	bool never_called = true;
+	reactor.when_reached(second_manager.vulkan_timeline(), 1'000'000, [&never_called]() { never_called = false; });
+
+	first.execute().when_done([]() { throw std::runtime_error("failed"); });
+	first_manager.wait();
+	EXPECT_THROW(reactor.poll(), std::runtime_error);
+
+	EXPECT_EQ(reactor.pending_count(), std::size_t(1));
+	EXPECT_EQ(reactor.wait_any(std::chrono::milliseconds(1)), std::size_t(0));
+	EXPECT_TRUE(never_called);
+}
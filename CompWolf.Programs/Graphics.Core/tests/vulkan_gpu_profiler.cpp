@@ -0,0 +1,126 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include "vulkan_test_helpers.hpp"
+#include <simple_drawables>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace
+{
+	struct time_frames_result
+	{
+		/** Whether the camera has a profiler, and the gpu can time its work. */
+		bool supported;
+		std::vector<compwolf::vulkan::gpu_frame_timings> timings;
+	};
+
+	/** Draws the given amount of frames of two squares, and returns the times reported by the camera's profiler. */
+	auto time_frames(compwolf::camera_gpu_timing timing, std::size_t frame_count) -> time_frames_result
+	{
+		compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+		compwolf::vulkan::offscreen_target target(environment, compwolf::vulkan::offscreen_target_settings{
+			.pixel_size = { 64, 64 },
+		});
+		compwolf::vulkan::vulkan_camera camera(target, compwolf::window_camera_settings{
+			.gpu_timing = timing,
+		});
+		compwolf::simple_brush<compwolf::vulkan_types> brush(camera);
+		compwolf::simple_square<compwolf::vulkan_types> square_a(camera, brush, compwolf::simple_transform_data{
+			.position = { -.5f, 0.f },
+			.scale = { .25f, .25f },
+		});
+		compwolf::simple_square<compwolf::vulkan_types> square_b(camera, brush, compwolf::simple_transform_data{
+			.position = { .5f, 0.f },
+			.scale = { .25f, .25f },
+		});
+
+		std::vector<compwolf::vulkan::gpu_frame_timings> timings;
+		if (!camera.gpu_profiler() || !camera.gpu_profiler().supported()) return { false, timings };
+		auto key = camera.gpu_profiler().frame_timed().subscribe([&timings](const compwolf::vulkan::gpu_frame_timings& frame)
+			{
+				timings.push_back(frame);
+			}
+		);
+
+		for (std::size_t i = 0; i < frame_count; ++i) target.update_image();
+
+		for (auto& frame : target.swapchain().frames_in_flight()) frame.draw_manager().wait();
+		camera.gpu_profiler().collect();
+		return { true, timings };
+	}
+
+	auto count_scopes(const compwolf::vulkan::gpu_frame_timings& frame, std::string_view name) -> std::size_t
+	{
+		std::size_t count = 0;
+		for (auto& scope : frame.scopes) if (scope.name == name) ++count;
+		return count;
+	}
+}
+
+TEST(VulkanGpuProfiler, not_timed_by_default) {
+	auto result = time_frames(compwolf::camera_gpu_timing::none, 4);
+
+	EXPECT_FALSE(result.supported);
+	EXPECT_TRUE(result.timings.empty());
+}
+
+TEST(VulkanGpuProfiler, times_every_frame_in_order) {
+	constexpr std::size_t frame_count = 8;
+
+	auto result = time_frames(compwolf::camera_gpu_timing::passes, frame_count);
+	if (!result.supported) GTEST_SKIP() << "The gpu cannot time its work.";
+	auto& timings = result.timings;
+
+	ASSERT_EQ(timings.size(), frame_count);
+	for (std::size_t i = 0; i < timings.size(); ++i)
+	{
+		EXPECT_EQ(timings[i].frame_number, i);
+		EXPECT_EQ(count_scopes(timings[i], "render pass"), std::size_t(1));
+		EXPECT_EQ(count_scopes(timings[i], "drawable"), std::size_t(0));
+		for (auto& scope : timings[i].scopes) EXPECT_LE(scope.start + scope.duration, timings[i].total);
+	}
+	testing::Test::RecordProperty("frame_time_ns", std::to_string(timings.back().total.count()));
+}
+
+TEST(VulkanGpuProfiler, times_each_drawable) {
+	auto result = time_frames(compwolf::camera_gpu_timing::drawables, 2);
+	if (!result.supported) GTEST_SKIP() << "The gpu cannot time its work.";
+
+	ASSERT_FALSE(result.timings.empty());
+	auto& frame = result.timings.back();
+	EXPECT_EQ(count_scopes(frame, "drawable"), std::size_t(2));
+	EXPECT_EQ(frame.dropped_scopes, std::size_t(0));
+	for (auto& scope : frame.scopes)
+	{
+		if (scope.name == "drawable")
+		{
+			EXPECT_EQ(scope.depth, std::size_t(1));
+		}
+	}
+}
+
+TEST(VulkanGpuProfiler, one_frame_time_for_each_frame) {
+	constexpr std::size_t frame_count = 8;
+
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	compwolf::vulkan::offscreen_target target(environment, compwolf::vulkan::offscreen_target_settings{
+		.pixel_size = { 64, 64 },
+	});
+	compwolf::vulkan::vulkan_camera first_camera(target, compwolf::window_camera_settings{
+		.gpu_timing = compwolf::camera_gpu_timing::passes,
+	});
+	compwolf::vulkan::vulkan_camera second_camera(target, compwolf::window_camera_settings{
+		.gpu_timing = compwolf::camera_gpu_timing::passes,
+	});
+	if (!first_camera.gpu_profiler().supported()) GTEST_SKIP() << "The gpu cannot time its work.";
+
+	for (std::size_t i = 0; i < frame_count; ++i) target.update_image();
+
+	// Both cameras time every frame, but the window's statistics get one time for each frame, being the sum of the cameras'.
+	auto samples = target.frame_stats().summary(compwolf::frame_metric::gpu_frame_time).samples;
+	EXPECT_GT(samples, std::size_t(0));
+	EXPECT_LT(samples, frame_count);
+}
@@ -0,0 +1,147 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include "vulkan_test_helpers.hpp"
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+TEST(VulkanGpuProgramManager, starts_without_work) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+
+	EXPECT_EQ(manager.submitted_value(), uint64_t(0));
+	EXPECT_FALSE(manager.working());
+	EXPECT_TRUE(manager.latest_fence().completed());
+	manager.wait();
+}
+
+TEST(VulkanGpuProgramManager, each_execution_signals_the_next_value) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	std::vector<uint64_t> values;
+	for (int i = 0; i < 3; ++i)
+	{
+		auto& fence = program.execute();
+		values.push_back(fence.value());
+		EXPECT_EQ(fence.vulkan_timeline(), manager.vulkan_timeline());
+	}
+	EXPECT_EQ(values, (std::vector<uint64_t>{ 1, 2, 3 }));
+	EXPECT_EQ(manager.submitted_value(), uint64_t(3));
+
+	manager.wait();
+	EXPECT_FALSE(manager.working());
+	EXPECT_EQ(program.execute().value(), uint64_t(4));
+	program.execute().wait();
+	EXPECT_TRUE(manager.latest_fence().completed());
+}
+
+TEST(VulkanGpuProgramManager, batched_work_waits_in_order) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program first(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+	compwolf::vulkan::vulkan_gpu_program second(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	std::vector<compwolf::vulkan::vulkan_gpu_submission> submissions{
+		first.prepare_execution(),
+		second.prepare_execution(),
+		manager.prepare_submission(nullptr),
+	};
+	EXPECT_EQ(submissions[0].wait_value, uint64_t(0));
+	EXPECT_EQ(submissions[1].wait_value, submissions[0].signal_value);
+	EXPECT_EQ(submissions[2].wait_value, submissions[1].signal_value);
+
+	EXPECT_EQ(compwolf::vulkan::submit_programs(submissions), std::size_t(1));
+	manager.wait();
+	EXPECT_FALSE(manager.working());
+}
+
+TEST(VulkanGpuProgramManager, waits_for_each_other_manager) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto first_manager = compwolf::vulkan::tests::new_manager(environment);
+	auto second_manager = compwolf::vulkan::tests::new_manager(environment);
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program first(first_manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+	compwolf::vulkan::vulkan_gpu_program second(second_manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	compwolf::vulkan::vulkan_gpu_fence earlier_fence(first_manager.gpu(), first_manager.vulkan_timeline(), first.execute().value());
+	auto& first_fence = first.execute();
+	auto& second_fence = second.execute();
+	manager.wait_for(first_fence);
+	manager.wait_for(second_fence);
+	manager.wait_for(earlier_fence);
+
+	auto submission = manager.prepare_submission(nullptr);
+	ASSERT_EQ(submission.dependencies.size(), std::size_t(2));
+	EXPECT_EQ(submission.dependencies[0].timeline, first_manager.vulkan_timeline());
+	EXPECT_EQ(submission.dependencies[0].value, first_fence.value());
+	EXPECT_EQ(submission.dependencies[1].timeline, second_manager.vulkan_timeline());
+	EXPECT_EQ(submission.dependencies[1].value, second_fence.value());
+
+	compwolf::vulkan::submit_programs(std::span(&submission, 1));
+	manager.wait();
+	EXPECT_TRUE(first_fence.completed());
+	EXPECT_TRUE(second_fence.completed());
+}
+
+TEST(VulkanGpuProgramManager, managers_are_spread_across_threads) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+
+	std::vector<compwolf::vulkan::vulkan_gpu_program_manager> managers;
+	for (int i = 0; i < 8; ++i) managers.push_back(compwolf::vulkan::tests::new_manager(environment));
+
+	auto& family = managers[0].thread_family();
+	if (family.threads.size() < 2) GTEST_SKIP() << "The gpu has a single queue for drawing.";
+
+	std::size_t least = managers.size(), most = 0;
+	for (auto& thread : family.threads)
+	{
+		least = std::min(least, thread.program_manager_count);
+		most = std::max(most, thread.program_manager_count);
+	}
+	EXPECT_LE(most - least, std::size_t(1));
+}
+
+TEST(VulkanGpuProgramManager, windows_submit_to_different_threads) {
+	constexpr std::size_t target_count = 3;
+
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	std::vector<std::unique_ptr<compwolf::vulkan::offscreen_target>> targets;
+	for (std::size_t i = 0; i < target_count; ++i)
+	{
+		targets.push_back(std::make_unique<compwolf::vulkan::offscreen_target>(environment, compwolf::vulkan::offscreen_target_settings{
+			.pixel_size = { 16, 16 },
+		}));
+	}
+
+	std::set<std::pair<std::size_t, std::size_t>> threads;
+	std::size_t manager_count = 0;
+	for (auto& target : targets)
+	{
+		for (std::size_t frame = 0; frame < 4; ++frame) target->update_image();
+		for (auto& frame : target->swapchain().frames_in_flight())
+		{
+			auto& manager = frame.draw_manager();
+			threads.emplace(manager.thread_family_index(), manager.thread_index());
+			++manager_count;
+		}
+	}
+	for (auto& target : targets) target->swapchain().current_frame_in_flight().draw_manager().wait();
+
+	auto& family = targets[0]->swapchain().current_frame_in_flight().draw_manager().thread_family();
+	if (family.threads.size() < 2) GTEST_SKIP() << "The gpu has a single queue for drawing.";
+
+	std::size_t threads_with_work = 0;
+	for (auto& thread : family.threads) if (thread.submission_count > 0) ++threads_with_work;
+
+	auto expected_threads = std::min(manager_count, family.threads.size());
+	EXPECT_GE(threads.size(), expected_threads);
+	EXPECT_GE(threads_with_work, expected_threads);
+}
@@ -0,0 +1,88 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include "vulkan_test_helpers.hpp"
+#include <stdexcept>
+
+TEST(VulkanObjectPool, reuses_command_buffers_of_destroyed_programs) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	auto& pool = manager.gpu().object_pool();
+
+	{
+		compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+		program.execute();
+	}
+	manager.wait();
+	manager.gpu().deletion_queue().collect();
+
+	auto reused_before = pool.stats().commands.reused;
+	compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+	EXPECT_EQ(pool.stats().commands.reused, reused_before + 1);
+
+	program.execute().wait();
+}
+
+TEST(VulkanObjectPool, reuses_timelines_of_destroyed_managers) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	uint64_t old_value;
+	{
+		auto manager = compwolf::vulkan::tests::new_manager(environment);
+		compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+		program.execute();
+		program.execute();
+		manager.wait();
+		old_value = manager.submitted_value();
+	}
+	environment.gpus()[0].deletion_queue().collect();
+
+	auto& pool = environment.gpus()[0].object_pool();
+	auto reused_before = pool.stats().timelines.reused;
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	ASSERT_EQ(pool.stats().timelines.reused, reused_before + 1);
+
+	// The reused timeline continues from its earlier value.
+	EXPECT_EQ(manager.submitted_value(), old_value);
+	EXPECT_FALSE(manager.working());
+
+	compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+	auto& fence = program.execute();
+	EXPECT_EQ(fence.value(), old_value + 1);
+	fence.wait();
+	EXPECT_FALSE(manager.working());
+}
+
+TEST(VulkanObjectPool, reuses_semaphores) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto& gpu = environment.gpus()[0];
+	auto& pool = gpu.object_pool();
+
+	{
+		compwolf::vulkan::vulkan_gpu_semaphore semaphore(gpu);
+	}
+	gpu.deletion_queue().collect();
+
+	auto reused_before = pool.stats().semaphores.reused;
+	compwolf::vulkan::vulkan_gpu_semaphore semaphore(gpu);
+	EXPECT_TRUE(semaphore);
+	EXPECT_EQ(pool.stats().semaphores.reused, reused_before + 1);
+	EXPECT_GT(pool.stats().semaphores.hit_rate(), 0.);
+}
+
+TEST(VulkanObjectPool, reset_programs_must_be_recorded_again) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+
+	compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+	program.execute().wait();
+	EXPECT_TRUE(program.recorded());
+
+	manager.reset_programs();
+	EXPECT_FALSE(program.recorded());
+	EXPECT_THROW(program.execute(), std::logic_error);
+
+	program.record([](const compwolf::vulkan::vulkan_code_parameters&) {});
+	EXPECT_TRUE(program.recorded());
+	program.execute().wait();
+}
@@ -0,0 +1,71 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include "vulkan_test_helpers.hpp"
+#include <simple_drawables>
+#include <chrono>
+#include <string>
+#include <cstddef>
+
+TEST(VulkanOffscreenTarget, windows_cannot_be_created_headless) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+
+	EXPECT_THROW(compwolf::vulkan::vulkan_window(environment, compwolf::window_settings{}), std::logic_error);
+}
+
+TEST(VulkanOffscreenTarget, reads_back_background_color) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	compwolf::vulkan::offscreen_target target(environment, compwolf::vulkan::offscreen_target_settings{
+		.pixel_size = { 16, 8 },
+		.readback = true,
+	});
+	compwolf::vulkan::vulkan_camera camera(target, compwolf::window_camera_settings{
+		.background_color = { 1.f, 0.f, 0.f },
+	});
+
+	target.update_image();
+	auto pixels = target.read_image();
+
+	ASSERT_EQ(pixels.size(), std::size_t(16 * 8 * 4));
+	EXPECT_EQ(pixels[0], std::byte(255));
+	EXPECT_EQ(pixels[1], std::byte(0));
+	EXPECT_EQ(pixels[2], std::byte(0));
+}
+
+TEST(VulkanOffscreenTarget, read_image_requires_readback) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	compwolf::vulkan::offscreen_target target(environment, compwolf::vulkan::offscreen_target_settings{
+		.pixel_size = { 16, 16 },
+	});
+
+	target.update_image();
+	EXPECT_THROW(target.read_image(), std::logic_error);
+}
+
+TEST(VulkanOffscreenTarget, frame_time) {
+	constexpr std::size_t frame_count = 100;
+
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	compwolf::vulkan::offscreen_target target(environment, compwolf::vulkan::offscreen_target_settings{
+		.pixel_size = { 256, 256 },
+	});
+	compwolf::vulkan::vulkan_camera camera(target, compwolf::window_camera_settings{});
+	compwolf::simple_brush<compwolf::vulkan_types> brush(camera);
+	compwolf::simple_square<compwolf::vulkan_types> square(camera, brush
+		, compwolf::simple_transform_data
+		{
+			.position = { .0f, .0f },
+			.scale = { .25f, .25f },
+		}
+		, { .75f, .125f, .5f }
+	);
+	brush.wait_for_pipeline(target);
+
+	auto start_time = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < frame_count; ++i) target.update_image();
+	target.swapchain().current_frame_in_flight().draw_manager().wait();
+	auto time = std::chrono::steady_clock::now() - start_time;
+
+	testing::Test::RecordProperty("frame_time_ns", std::to_string(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() / frame_count));
+}
@@ -0,0 +1,68 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include "vulkan_test_helpers.hpp"
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace
+{
+	/** Creates an environment saving its pipeline caches to the given directory, and returns the size of the cache that its gpu loaded. */
+	auto loaded_cache_size(const std::filesystem::path& directory) -> std::size_t
+	{
+		auto settings = compwolf::vulkan::tests::headless_settings();
+		settings.pipeline_cache_directory = directory.string();
+		compwolf::vulkan::vulkan_graphics_environment environment(settings);
+		auto manager = compwolf::vulkan::tests::new_manager(environment);
+		return manager.gpu().pipeline_cache().stats().loaded_size;
+	}
+
+	auto read_file(const std::filesystem::path& path) -> std::vector<char>
+	{
+		std::ifstream stream(path, std::ios::binary);
+		return std::vector<char>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	}
+	void write_file(const std::filesystem::path& path, const std::vector<char>& data)
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+	}
+}
+
+TEST(VulkanPipelineCache, saved_cache_is_loaded) {
+	auto directory = std::filesystem::temp_directory_path() / "CompWolf.tests.pipeline_cache.saved";
+	std::filesystem::remove_all(directory);
+
+	EXPECT_EQ(loaded_cache_size(directory), std::size_t(0));
+	EXPECT_GT(loaded_cache_size(directory), std::size_t(0));
+
+	std::filesystem::remove_all(directory);
+}
+
+TEST(VulkanPipelineCache, cache_for_another_gpu_is_ignored) {
+	auto directory = std::filesystem::temp_directory_path() / "CompWolf.tests.pipeline_cache.mismatched";
+	std::filesystem::remove_all(directory);
+
+	loaded_cache_size(directory);
+	ASSERT_FALSE(std::filesystem::is_empty(directory));
+	auto path = std::filesystem::directory_iterator(directory)->path();
+	auto data = read_file(path);
+	ASSERT_GE(data.size(), std::size_t(32));
+
+	// The header is the header's size, the header's version, the vendor ID, the device ID, and then the pipelineCacheUUID.
+	struct mismatch { const char* field; std::size_t offset; };
+	for (auto [field, offset] : { mismatch{ "vendor ID", 8 }, mismatch{ "device ID", 12 }, mismatch{ "pipelineCacheUUID", 16 } })
+	{
+		auto changed_data = data;
+		changed_data[offset] = static_cast<char>(changed_data[offset] ^ 0x5A);
+		write_file(path, changed_data);
+
+		EXPECT_EQ(loaded_cache_size(directory), std::size_t(0)) << "A cache with another " << field << " was loaded.";
+	}
+
+	std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,90 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace
+{
+	constexpr std::size_t frame_count = 60;
+
+	/** A window with a camera, so that updating its image gives work to the gpu. */
+	struct test_window
+	{
+		compwolf::vulkan::vulkan_window window;
+		compwolf::vulkan::vulkan_camera camera;
+
+		test_window(compwolf::vulkan::vulkan_graphics_environment& environment)
+			: window(environment, compwolf::window_settings{
+				.name = "Present batch test",
+				.pixel_size = { 64, 64 },
+				.present = compwolf::present_policy::immediate,
+			})
+			, camera(window, compwolf::window_camera_settings{})
+		{}
+	};
+
+	auto make_windows(compwolf::vulkan::vulkan_graphics_environment& environment, std::size_t count) -> std::vector<std::unique_ptr<test_window>>
+	{
+		std::vector<std::unique_ptr<test_window>> windows;
+		for (std::size_t i = 0; i < count; ++i) windows.push_back(std::make_unique<test_window>(environment));
+		return windows;
+	}
+
+	class VulkanPresentBatch : public testing::TestWithParam<std::size_t> {};
+}
+
+TEST_P(VulkanPresentBatch, one_submit_and_present_per_queue) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::vulkan_graphics_environment_settings{});
+	auto window_count = GetParam();
+	auto windows = make_windows(environment, window_count);
+
+	compwolf::vulkan::present_batch batch(environment);
+	for (auto& window : windows) batch.add(window->window);
+	batch.submit();
+
+	auto& stats = batch.stats();
+	EXPECT_EQ(stats.windows, window_count);
+	EXPECT_EQ(stats.programs, window_count);
+	EXPECT_GE(stats.submit_calls, std::size_t(1));
+	EXPECT_LE(stats.submit_calls, window_count);
+	EXPECT_GE(stats.present_calls, std::size_t(1));
+	EXPECT_LE(stats.present_calls, window_count);
+	EXPECT_TRUE(batch.windows().empty());
+}
+
+TEST_P(VulkanPresentBatch, compared_to_separate_windows) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::vulkan_graphics_environment_settings{});
+	auto window_count = GetParam();
+	auto windows = make_windows(environment, window_count);
+
+	auto separate_start = std::chrono::steady_clock::now();
+	for (std::size_t frame = 0; frame < frame_count; ++frame)
+	{
+		for (auto& window : windows) window->window.update_image();
+	}
+	auto separate_time = std::chrono::steady_clock::now() - separate_start;
+
+	compwolf::vulkan::present_batch batch(environment);
+	auto batched_start = std::chrono::steady_clock::now();
+	for (std::size_t frame = 0; frame < frame_count; ++frame)
+	{
+		for (auto& window : windows) batch.add(window->window);
+		batch.submit();
+	}
+	auto batched_time = std::chrono::steady_clock::now() - batched_start;
+
+	auto per_frame = [](auto time)
+		{
+			return std::to_string(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() / frame_count);
+		};
+	testing::Test::RecordProperty("windows", std::to_string(window_count));
+	testing::Test::RecordProperty("separate_frame_time_ns", per_frame(separate_time));
+	testing::Test::RecordProperty("batched_frame_time_ns", per_frame(batched_time));
+	testing::Test::RecordProperty("batched_submit_time_ns", std::to_string(batch.stats().submit_time.count()));
+}
+
+INSTANTIATE_TEST_SUITE_P(WindowCounts, VulkanPresentBatch, testing::Range<std::size_t>(1, 9));
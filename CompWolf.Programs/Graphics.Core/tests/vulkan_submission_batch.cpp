@@ -0,0 +1,90 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include "vulkan_test_helpers.hpp"
+#include <set>
+
+TEST(VulkanSubmissionBatch, submits_once_for_each_queue) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto first_manager = compwolf::vulkan::tests::new_manager(environment);
+	auto second_manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program first_program(first_manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+	compwolf::vulkan::vulkan_gpu_program second_program(second_manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+	compwolf::vulkan::vulkan_gpu_program third_program(first_manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	compwolf::vulkan::submission_batch batch;
+	batch.add(first_program);
+	batch.add(second_program);
+	batch.add(third_program);
+	EXPECT_EQ(batch.submissions().size(), std::size_t(3));
+
+	std::set<compwolf::vulkan::vulkan_handle::queue> queues{ first_manager.thread().queue, second_manager.thread().queue };
+	EXPECT_EQ(batch.flush(), queues.size());
+	EXPECT_TRUE(batch.empty());
+	EXPECT_EQ(batch.stats().submissions, std::size_t(3));
+	EXPECT_EQ(batch.stats().programs, std::size_t(3));
+	EXPECT_EQ(batch.stats().submit_calls, queues.size());
+
+	first_manager.wait();
+	second_manager.wait();
+	EXPECT_TRUE(first_program.last_fence().completed());
+	EXPECT_TRUE(second_program.last_fence().completed());
+	EXPECT_TRUE(third_program.last_fence().completed());
+}
+
+TEST(VulkanSubmissionBatch, programs_can_wait_for_each_other) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto first_manager = compwolf::vulkan::tests::new_manager(environment);
+	auto second_manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program first_program(first_manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+	compwolf::vulkan::vulkan_gpu_program second_program(second_manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	compwolf::vulkan::submission_batch batch;
+	auto& first_fence = batch.add(first_program);
+	batch.add(second_program, first_fence);
+
+	auto& dependent = batch.submissions()[1];
+	ASSERT_EQ(dependent.dependencies.size(), std::size_t(1));
+	EXPECT_EQ(dependent.dependencies[0].timeline, first_manager.vulkan_timeline());
+	EXPECT_EQ(dependent.dependencies[0].value, first_fence.value());
+
+	batch.flush();
+	second_manager.wait();
+	EXPECT_TRUE(first_program.last_fence().completed());
+	EXPECT_TRUE(second_program.last_fence().completed());
+}
+
+TEST(VulkanSubmissionBatch, can_be_reused) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	compwolf::vulkan::submission_batch batch;
+	EXPECT_EQ(batch.flush(), std::size_t(0));
+
+	for (int i = 0; i < 3; ++i)
+	{
+		batch.add(program);
+		batch.add(manager.prepare_submission(nullptr));
+		EXPECT_EQ(batch.flush(), std::size_t(1));
+		EXPECT_EQ(batch.stats().submissions, std::size_t(2));
+		EXPECT_EQ(batch.stats().programs, std::size_t(1));
+		manager.wait();
+	}
+	EXPECT_EQ(manager.submitted_value(), uint64_t(6));
+}
+
+TEST(VulkanSubmissionBatch, destroying_flushes_the_work) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+
+	{
+		compwolf::vulkan::submission_batch batch;
+		batch.add(program);
+	}
+
+	manager.wait();
+	EXPECT_TRUE(program.last_fence().completed());
+}
@@ -0,0 +1,26 @@
+#ifndef COMPWOLF_GRAPHICS_VULKAN_TEST_HELPERS
+#define COMPWOLF_GRAPHICS_VULKAN_TEST_HELPERS
+
+#include <vulkan_graphics>
+
+/** Helpers shared by the tests of the vulkan implementation. */
+namespace compwolf::vulkan::tests
+{
+	/** Returns settings for an environment without windows, so that the tests can run on machines without a display. */
+	inline auto headless_settings() -> vulkan_graphics_environment_settings
+	{
+		vulkan_graphics_environment_settings settings{};
+		settings.headless = true;
+		return settings;
+	}
+
+	/** Creates a manager on the given environment's gpu, for work of the given type. */
+	inline auto new_manager(vulkan_graphics_environment& environment, gpu_work_type type = gpu_work_type::draw) -> vulkan_gpu_program_manager
+	{
+		return vulkan_gpu_program_manager::new_manager_for(environment, gpu_program_manager_settings{
+			.type = { type },
+		});
+	}
+}
+
+#endif // ! COMPWOLF_GRAPHICS_VULKAN_TEST_HELPERS
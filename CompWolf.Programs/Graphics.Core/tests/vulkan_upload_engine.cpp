@@ -0,0 +1,95 @@
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+#include <vulkan_graphics>
+#include "vulkan_test_helpers.hpp"
+#include <vector>
+
+namespace
+{
+	using float_buffer = compwolf::vulkan::vulkan_gpu_buffer<compwolf::gpu_buffer_usage::field, float>;
+}
+
+TEST(VulkanUploadEngine, is_on_a_transfer_thread) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_upload_engine engine(manager.gpu());
+
+	EXPECT_TRUE(engine.manager().thread_family().work_types[compwolf::gpu_work_type::transfer]);
+	EXPECT_TRUE(engine.submit().completed());
+}
+
+TEST(VulkanUploadEngine, uploads_values) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_upload_engine engine(manager.gpu());
+	float_buffer buffer(manager.gpu(), 4);
+
+	std::vector<float> first{ 1.f, 2.f };
+	std::vector<float> second{ 3.f, 4.f };
+	engine.upload(buffer, std::span<const float>(first));
+	engine.upload(buffer, std::span<const float>(second), 2);
+	EXPECT_EQ(engine.pending_copy_count(), std::size_t(2));
+	EXPECT_EQ(engine.pending_bytes(), 4 * sizeof(float));
+
+	engine.submit().wait();
+	EXPECT_EQ(engine.pending_copy_count(), std::size_t(0));
+
+	auto data = buffer.data();
+	for (std::size_t i = 0; i < 4; ++i) EXPECT_EQ(data[i], static_cast<float>(i + 1));
+}
+
+TEST(VulkanUploadEngine, rejects_values_outside_buffer) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_upload_engine engine(manager.gpu());
+	float_buffer buffer(manager.gpu(), 2);
+
+	std::vector<float> values{ 1.f, 2.f };
+	EXPECT_THROW(engine.upload(buffer, std::span<const float>(values), 1), std::out_of_range);
+	EXPECT_EQ(engine.pending_copy_count(), std::size_t(0));
+}
+
+TEST(VulkanUploadEngine, other_work_waits_for_upload) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_upload_engine engine(manager.gpu());
+	compwolf::vulkan::vulkan_gpu_program program(manager, [](const compwolf::vulkan::vulkan_code_parameters&) {});
+	float_buffer buffer(manager.gpu(), 1);
+
+	std::vector<float> values{ 5.f };
+	engine.upload(buffer, std::span<const float>(values));
+	auto upload_fence = engine.submit();
+
+	manager.wait_for(upload_fence);
+	auto submission = program.prepare_execution();
+	ASSERT_EQ(submission.dependencies.size(), std::size_t(1));
+	EXPECT_EQ(submission.dependencies[0].timeline, upload_fence.vulkan_timeline());
+	EXPECT_EQ(submission.dependencies[0].value, upload_fence.value());
+	compwolf::vulkan::submit_programs(std::span(&submission, 1));
+
+	program.last_fence().wait();
+	EXPECT_TRUE(upload_fence.completed());
+	EXPECT_EQ(buffer.data()[0], 5.f);
+}
+
+TEST(VulkanUploadEngine, later_uploads_overwrite_earlier_ones) {
+	compwolf::vulkan::vulkan_graphics_environment environment(compwolf::vulkan::tests::headless_settings());
+	auto manager = compwolf::vulkan::tests::new_manager(environment);
+	compwolf::vulkan::vulkan_upload_engine engine(manager.gpu());
+	float_buffer buffer(manager.gpu(), 3);
+
+	// The second upload overlaps the first, so it must wait for it; the third does not, so it is copied along with the first.
+	std::vector<float> first{ 1.f, 2.f };
+	std::vector<float> second{ 7.f };
+	std::vector<float> third{ 3.f };
+	engine.upload(buffer, std::span<const float>(first));
+	engine.upload(buffer, std::span<const float>(second), 1);
+	engine.upload(buffer, std::span<const float>(third), 2);
+	engine.submit().wait();
+
+	auto data = buffer.data();
+	EXPECT_EQ(data[0], 1.f);
+	EXPECT_EQ(data[1], 7.f);
+	EXPECT_EQ(data[2], 3.f);
+}
@@ -21,11 +21,13 @@ int main()
 			.program_version = { 2, 5, 8 }, // Random numbers selected for testing
 		},
 		&debug_callback,
+		"pipeline_cache",
 	});
 
 	graphics_types::window window(environment, compwolf::window_settings{
 		.name = "Hello Window!",
 		.pixel_size = {640, 640},
+		.frame_stats_interval = 120,
 	});
 
 	graphics_types::camera camera(window, compwolf::window_camera_settings
@@ -50,14 +52,39 @@ int main()
 	double elapsed_time = 0.;
 	double delta_time = 0.;
 
-	int frames_since_last_report = 0;
-	double next_report_time = 1.;
+	bool reported_startup = false;
+
+	// report frame times; p99 shows stutter that the average hides
+	auto report_key = window.frame_stats().reported().subscribe([](const compwolf::frame_stats_report& report)
+		{
+			auto milliseconds = [](std::chrono::nanoseconds time) { return std::chrono::duration<double, std::milli>(time).count(); };
+			auto& cpu = report.cpu_frame_time;
+			std::cout << "framerate: " << 1000. / milliseconds(cpu.mean)
+				<< ", frame time: " << milliseconds(cpu.p50) << " ms (p99 " << milliseconds(cpu.p99) << " ms, max " << milliseconds(cpu.max) << " ms)"
+				// the time spent waiting for the gpu shows how much the cpu and gpu work at the same time
+				<< ", waiting for gpu: " << milliseconds(report.fence_wait.mean) << " ms/frame"
+				<< ", acquire: " << milliseconds(report.acquire_wait.mean) << " ms"
+				<< ", present: " << milliseconds(report.present_wait.mean) << " ms" << std::endl;
+		}
+	);
 
 	while (window.running())
 	{
 		window.update_image();
 		environment.update();
 
+		// report startup time, which mostly depends on whether the pipelines could be loaded from the cache
+		if (!reported_startup) [[unlikely]]
+		{
+			auto& cache = window.gpu().pipeline_cache().stats();
+			auto startup_time = std::chrono::duration<double, std::milli>(clock.now() - start_time).count();
+			auto pipeline_time = std::chrono::duration<double, std::milli>(cache.pipeline_creation_time).count();
+			std::cout << "first frame: " << startup_time << " ms, of which creating "
+				<< cache.pipelines_created << " pipelines: " << pipeline_time << " ms"
+				<< (cache.loaded_size > 0 ? " (loaded from cache)" : " (not cached)") << std::endl;
+			reported_startup = true;
+		}
+
 		if (environment.inputs().state_for('w').down()) square.transform().data()[0].position.y() -= static_cast<float>(delta_time);
 		if (environment.inputs().state_for('a').down()) square.transform().data()[0].position.x() -= static_cast<float>(delta_time);
 		if (environment.inputs().state_for('s').down()) square.transform().data()[0].position.y() += static_cast<float>(delta_time);
@@ -67,16 +94,6 @@ int main()
 		auto old_time = elapsed_time;
 		elapsed_time = std::chrono::duration<double>(clock.now() - start_time).count();
 		delta_time = elapsed_time - old_time;
-
-		// report framerate
-		++frames_since_last_report;
-		if (elapsed_time >= next_report_time) [[unlikely]]
-		{
-			auto framerate = frames_since_last_report / (elapsed_time - next_report_time + 1);
-			std::cout << "framerate: " << framerate << std::endl;
-			next_report_time = elapsed_time + 1;
-			frames_since_last_report = 0;
-		}
 	}
 
 	std::cout << "\nEnding...\n";